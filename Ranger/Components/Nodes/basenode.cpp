@@ -3,6 +3,9 @@
 //
 
 #include "basenode.h"
+#include "node_registry.h"
+#include "../../Core/Logging/log.h"
+#include "../../Rendering/layer_cache.h"
 
 namespace Ranger {
     int BaseNode::_tagGen{INITIAL_START_TAG};
@@ -16,7 +19,9 @@ namespace Ranger {
     }
 
     BaseNode::~BaseNode() {
-        std::cout << "BaseNode::~BaseNode " << std::endl;
+        LOG_TRACE(LogCategory::SCENE, "BaseNode::~BaseNode {}", _tag);
+        if (_registry)
+            _registry->_remove(this);
     }
 
     bool BaseNode::initialize() {
@@ -24,8 +29,10 @@ namespace Ranger {
         _running = false;
         //! By default all new nodes are dirty.
         _transformDirty = _inverseDirty = true;
-        _tag = -1;
         _exited = false;
+        name("NoName");
+        tag(-1);
+        storePreviousTransform();
         return true;
     }
 
@@ -36,6 +43,22 @@ namespace Ranger {
         _bbox.set(bbox);
     }
 
+    void BaseNode::name(const std::string &name) {
+        const std::string* oldName = _name;
+        _name = NodeRegistry::intern(name);
+
+        if (_registry && oldName != _name)
+            _registry->_rename(this, oldName);
+    }
+
+    void BaseNode::tag(int tag) {
+        int oldTag = _tag;
+        _tag = tag;
+
+        if (_registry && oldTag != _tag)
+            _registry->_retag(this, oldTag);
+    }
+
     void BaseNode::aabbox(const Rectangle<float>& bbox) {
 
     }
@@ -45,12 +68,33 @@ namespace Ranger {
     }
 
     void BaseNode::markDirty() {
+        // Any change inside a static layer, managed or not, invalidates the
+        // layer's cached image.
+        _invalidateLayerCache();
+
         // Only mark Nodes that DON'T manage their own transforms.
         if (_managedTransform)
             return;
         _transformDirty = _inverseDirty = true;
     }
 
+    void BaseNode::staticLayer(LayerCache* cache) {
+        _layerCache = cache;
+        if (_layerCache)
+            _layerCache->markDirty();
+    }
+
+    void BaseNode::_invalidateLayerCache() {
+        // Walk up to the nearest static layer, if any. The renderer
+        // re-renders a dirty cache before compositing it.
+        BaseNode* node = this;
+        while (node && !node->_layerCache)
+            node = node->_parent.get();
+
+        if (node)
+            node->_layerCache->markDirty();
+    }
+
     //---------------------------------------------------------------------
     // Rotation
     //---------------------------------------------------------------------
@@ -135,5 +179,28 @@ namespace Ranger {
         _transformDirty = true;
     }
 
+    //---------------------------------------------------------------------
+    // Interpolation
+    //---------------------------------------------------------------------
+    void BaseNode::storePreviousTransform() {
+        _prevPosition.set(_position);
+        _prevRotation = _rotation;
+        _prevScale.set(_scale);
+    }
+
+    Vector3<float> BaseNode::interpolatedPosition(float alpha) const {
+        Vector3<float> v(_prevPosition);
+        return v.lerp(_position, alpha);
+    }
+
+    float BaseNode::interpolatedRotation(float alpha) const {
+        return _prevRotation + alpha * (_rotation - _prevRotation);
+    }
+
+    Vector3<float> BaseNode::interpolatedScale(float alpha) const {
+        Vector3<float> v(_prevScale);
+        return v.lerp(_scale, alpha);
+    }
+
 
 }
\ No newline at end of file
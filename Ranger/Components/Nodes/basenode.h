@@ -20,6 +20,22 @@ namespace Ranger {
 
         virtual bool initialize();
 
+        //---------------------------------------------------------------------
+        // Preloading
+        //---------------------------------------------------------------------
+        //! Override to declare the assets this node (typically a Scene) needs
+        // before it is run. @see SceneManager::pushWhenReady
+        virtual void declareAssets(SceneAssets& assets) {}
+
+        //! Override if readiness depends on more than the declared assets.
+        virtual bool isReady() { return true; }
+
+        //! The running Scene is told how far along the next Scene's loading is.
+        /*!
+         * \param progress [0.0, 1.0]
+         */
+        virtual void onLoadProgress(float progress) {}
+
         static int genTag();
 
         // ====================================================================
@@ -40,19 +56,27 @@ namespace Ranger {
         virtual void aabbox(const Rectangle<float> &aabbox);
 
         const std::string &name() const {
-            return _name;
+            return *_name;
         }
 
-        void name(const std::string &_name) {
-            BaseNode::_name = _name;
+        //! The name is interned, see @see NodeRegistry::intern.
+        void name(const std::string &name);
+
+        //! The interned name. Two nodes have the same name if, and only if,
+        // these pointers are equal.
+        const std::string* internedName() const {
+            return _name;
         }
 
         int tag() const {
             return _tag;
         }
 
-        void tag(int _tag) {
-            BaseNode::_tag = _tag;
+        void tag(int tag);
+
+        //! The registry indexing this node, if any.
+        NodeRegistry* registry() const {
+            return _registry;
         }
 
         //! Default to whatever the current visibility is.
@@ -77,6 +101,23 @@ namespace Ranger {
 
         virtual void markDirty();
 
+        //---------------------------------------------------------------------
+        // Static layer caching
+        //---------------------------------------------------------------------
+        //! A static layer is rendered once into an offscreen texture
+        // (@see LayerCache) and then composited each frame.
+        bool isStaticLayer() const {
+            return _layerCache != nullptr;
+        }
+
+        //! Makes this node a static layer cached in [cache], or not (nullptr).
+        // [cache] must outlive the link.
+        void staticLayer(LayerCache* cache);
+
+        LayerCache* layerCache() const {
+            return _layerCache;
+        }
+
         bool cleanUp() const {
             return _cleanup;
         }
@@ -145,6 +186,31 @@ namespace Ranger {
         }
         void scaleBy(float dx, float dy);
 
+        //---------------------------------------------------------------------
+        // Interpolation
+        //---------------------------------------------------------------------
+        //! Remembers the current position, rotation and scale as the previous
+        // ones. Called before every fixed update step.
+        void storePreviousTransform();
+
+        const Vector3<float>& prevPosition() const {
+            return _prevPosition;
+        }
+        float prevRotation() const {
+            return _prevRotation;
+        }
+        const Vector3<float>& prevScale() const {
+            return _prevScale;
+        }
+
+        //! Blends between the previous and the current fixed update step.
+        /*!
+         * \param alpha [0.0, 1.0] @see Engine::interpolationAlpha
+         */
+        Vector3<float> interpolatedPosition(float alpha) const;
+        float interpolatedRotation(float alpha) const;
+        Vector3<float> interpolatedScale(float alpha) const;
+
         //---------------------------------------------------------------------
         // Events
         //---------------------------------------------------------------------
@@ -196,7 +262,8 @@ namespace Ranger {
         // Local bbox
         Rectangle<float> _bbox;
 
-        std::string _name{"NoName"};
+        //! Interned. Never null once constructed.
+        const std::string* _name{nullptr};
 
         SchedulerSPtr scheduler{nullptr};
 
@@ -236,6 +303,11 @@ namespace Ranger {
          */
         static int _tagGen;
 
+        //! Set by the [NodeRegistry] when this node is added to it.
+        NodeRegistry* _registry{nullptr};
+
+        friend class NodeRegistry;
+
         //---------------------------------------------------------------------
         // Transforms
         //---------------------------------------------------------------------
@@ -255,7 +327,18 @@ namespace Ranger {
         float _rotation{0};
         Vector3<float> _scale;
 
+        // The above as of the previous fixed update step.
+        Vector3<float> _prevPosition;
+        float _prevRotation{0};
+        Vector3<float> _prevScale;
+
         bool _cleanup{true};
+
+        //! Marked dirty by any markDirty() within this layer.
+        LayerCache* _layerCache{nullptr};
+
+    private:
+        void _invalidateLayerCache();
     };
 }
 
@@ -0,0 +1,126 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <sstream>
+#include <stdexcept>
+
+#include "node_registry.h"
+#include "basenode.h"
+
+namespace Ranger {
+    namespace {
+        // A node based set never moves its elements, so the address of an
+        // interned string is stable for the life of the program.
+        std::unordered_set<std::string>& nameTable() {
+            static std::unordered_set<std::string> table;
+            return table;
+        }
+    }
+
+    NodeRegistry::~NodeRegistry() {
+        clear();
+    }
+
+    const std::string* NodeRegistry::intern(const std::string& name) {
+        return &*nameTable().insert(name).first;
+    }
+
+    const std::string* NodeRegistry::interned(const std::string& name) {
+        const auto& table = nameTable();
+        auto it = table.find(name);
+        return it == table.end() ? nullptr : &*it;
+    }
+
+    void NodeRegistry::add(const BaseNodeSPtr& node) {
+        if (!node) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << ": node should not be null." << std::endl;
+            throw std::invalid_argument(ss.str());
+        }
+
+        if (node->_registry == this)
+            return;
+
+        if (node->_registry) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << ": node {" << node->getId() << "} already belongs to a registry." << std::endl;
+            throw std::logic_error(ss.str());
+        }
+
+        node->_registry = this;
+        _index(node.get());
+        _nodeCount++;
+    }
+
+    void NodeRegistry::remove(const BaseNodeSPtr& node) {
+        if (node && node->_registry == this)
+            _remove(node.get());
+    }
+
+    void NodeRegistry::clear() {
+        // Detach every node so none of them calls back into a dead registry.
+        for (const auto& entry : _byName)
+            entry.second->_registry = nullptr;
+
+        _byTag.clear();
+        _byName.clear();
+        _nodeCount = 0;
+    }
+
+    BaseNode* NodeRegistry::findByTag(int tag) const {
+        auto it = _byTag.find(tag);
+        return it == _byTag.end() ? nullptr : it->second;
+    }
+
+    BaseNode* NodeRegistry::findByName(const std::string& name) const {
+        const std::string* key = interned(name);
+        return key ? findByName(key) : nullptr;
+    }
+
+    BaseNode* NodeRegistry::findByName(const std::string* name) const {
+        auto it = _byName.find(name);
+        return it == _byName.end() ? nullptr : it->second;
+    }
+
+    void NodeRegistry::_retag(BaseNode* node, int oldTag) {
+        if (oldTag != UNTAGGED)
+            _erase(_byTag, oldTag, node);
+        if (node->_tag != UNTAGGED)
+            _byTag.emplace(node->_tag, node);
+    }
+
+    void NodeRegistry::_rename(BaseNode* node, const std::string* oldName) {
+        _erase(_byName, oldName, node);
+        _byName.emplace(node->_name, node);
+    }
+
+    void NodeRegistry::_remove(BaseNode* node) {
+        if (node->_tag != UNTAGGED)
+            _erase(_byTag, node->_tag, node);
+        _erase(_byName, node->_name, node);
+
+        node->_registry = nullptr;
+        _nodeCount--;
+    }
+
+    void NodeRegistry::_index(BaseNode* node) {
+        if (node->_tag != UNTAGGED)
+            _byTag.emplace(node->_tag, node);
+        // Every node has a name, even if it is only "NoName". The name index
+        // doubles as the list of registered nodes.
+        _byName.emplace(node->_name, node);
+    }
+
+    template<typename Map, typename Key>
+    void NodeRegistry::_erase(Map& map, const Key& key, BaseNode* node) {
+        // Only the nodes sharing the key are visited, not the whole registry.
+        auto range = map.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == node) {
+                map.erase(it);
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,165 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERBETA_NODE_REGISTRY_H
+#define RANGERBETA_NODE_REGISTRY_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "../../ranger.h"
+
+namespace Ranger {
+    /*!
+     * The [NodeRegistry] indexes [BaseNode]s by tag and by name so that
+     * gameplay code can ask for "TAG_PLAYER" without walking the graph.
+     *
+     * Nodes are stored as raw (non-owning) handles. A registered node keeps a
+     * back pointer to its registry and reports re-tags, renames and its own
+     * destruction, so the index never holds a dangling handle.
+     *
+     * Names are interned: every distinct name string exists exactly once and
+     * nodes hold a pointer to it. Name lookups and comparisons are therefore
+     * pointer comparisons.
+     *
+     * Tags and names are not unique; several nodes may share a tag (ex: every
+     * TAG_MONSTER) so both indices are multi-maps.
+     */
+    class NodeRegistry final {
+    public:
+        using TagMap = std::unordered_multimap<int, BaseNode*>;
+        using NameMap = std::unordered_multimap<const std::string*, BaseNode*>;
+
+        //! Forward iterator over a query result. Dereferences to a node handle.
+        /*!
+         * It is a thin wrapper over the multi-map's own iterator which means
+         * iterating a query never allocates.
+         */
+        template<typename MapIterator>
+        class NodeIterator {
+        public:
+            NodeIterator(MapIterator it) : _it(it) {}
+
+            BaseNode* operator*() const { return _it->second; }
+
+            NodeIterator& operator++() {
+                ++_it;
+                return *this;
+            }
+
+            bool operator==(const NodeIterator& other) const { return _it == other._it; }
+            bool operator!=(const NodeIterator& other) const { return _it != other._it; }
+
+        private:
+            MapIterator _it;
+        };
+
+        //! A [begin, end) pair usable in range-for loops.
+        template<typename MapIterator>
+        class NodeRange {
+        public:
+            NodeRange(std::pair<MapIterator, MapIterator> range)
+                    : _begin(range.first), _end(range.second) {}
+
+            NodeIterator<MapIterator> begin() const { return _begin; }
+            NodeIterator<MapIterator> end() const { return _end; }
+
+            bool empty() const { return _begin == _end; }
+
+        private:
+            NodeIterator<MapIterator> _begin;
+            NodeIterator<MapIterator> _end;
+        };
+
+        using TagRange = NodeRange<TagMap::const_iterator>;
+        using NameRange = NodeRange<NameMap::const_iterator>;
+
+        NodeRegistry() = default;
+        ~NodeRegistry();
+
+        NodeRegistry(const NodeRegistry&) = delete;
+        NodeRegistry& operator=(const NodeRegistry&) = delete;
+
+        //! Returns the one and only copy of [name].
+        /*!
+         * Interning is global, not per registry, so names from different
+         * registries compare by pointer as well. Not thread safe...yet.
+         */
+        static const std::string* intern(const std::string& name);
+
+        //! Returns the interned copy of [name] or nullptr if no node ever used it.
+        /*!
+         * Unlike [intern] this never grows the table, which makes it the right
+         * call for lookups.
+         */
+        static const std::string* interned(const std::string& name);
+
+        // ====================================================================
+        // Maintenance
+        // ====================================================================
+        //! A node can belong to only one registry at a time.
+        void add(const BaseNodeSPtr& node);
+        void remove(const BaseNodeSPtr& node);
+        void clear();
+
+        // ====================================================================
+        // Queries
+        // ====================================================================
+        //! The first node found with [tag] or nullptr.
+        BaseNode* findByTag(int tag) const;
+
+        BaseNode* findByName(const std::string& name) const;
+        BaseNode* findByName(const std::string* name) const;
+
+        //! All nodes sharing [tag].
+        TagRange byTag(int tag) const {
+            return TagRange(_byTag.equal_range(tag));
+        }
+
+        //! All nodes sharing [name]. [name] must be an interned pointer.
+        NameRange byName(const std::string* name) const {
+            return NameRange(_byName.equal_range(name));
+        }
+
+        //! Every registered node.
+        NameRange all() const {
+            return NameRange({_byName.begin(), _byName.end()});
+        }
+
+        size_t countByTag(int tag) const {
+            return _byTag.count(tag);
+        }
+
+        size_t size() const {
+            return _nodeCount;
+        }
+
+    private:
+        friend class BaseNode;
+
+        //! Called by a registered node when its tag changes.
+        void _retag(BaseNode* node, int oldTag);
+
+        //! Called by a registered node when its name changes.
+        void _rename(BaseNode* node, const std::string* oldName);
+
+        //! Called by a registered node as it is being destroyed.
+        void _remove(BaseNode* node);
+
+        void _index(BaseNode* node);
+
+        template<typename Map, typename Key>
+        static void _erase(Map& map, const Key& key, BaseNode* node);
+
+        // Untagged nodes (-1) aren't indexed; there is nothing to find them by.
+        static constexpr int UNTAGGED = -1;
+
+        TagMap _byTag;
+        NameMap _byName;
+
+        size_t _nodeCount{0};
+    };
+}
+
+#endif //RANGERBETA_NODE_REGISTRY_H
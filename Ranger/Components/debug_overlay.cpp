@@ -0,0 +1,199 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "debug_overlay.h"
+
+#include "../Core/Logging/log.h"
+#include "../Core/Memory/frame_arena.h"
+#include "../Core/Timing/clock.h"
+#include "../IO/configuration.h"
+#include "../Rendering/Shaders/basic_shader.h"
+#include "../Rendering/freetypefont.h"
+#include "../Rendering/gl_stats.h"
+#include "../Rendering/rendercontext.h"
+#include "../engine.h"
+
+namespace Ranger {
+DebugOverlay::DebugOverlay()
+{
+}
+
+DebugOverlay::~DebugOverlay()
+{
+    if (_constructed) {
+        gl::deleteBuffers(1, &_vbo);
+        glDeleteVertexArrays(1, &_vao);
+    }
+    LOG_DEBUG(LogCategory::RENDERING, "DebugOverlay::~DebugOverlay");
+}
+
+void DebugOverlay::construct(float width, float height)
+{
+    float panelHeight = LINES * LINE_HEIGHT + 5.0f;
+    float left = -width / 2.0f + 5.0f;
+    float top = height / 2.0f - 5.0f;
+
+    _panelCenter = glm::vec2(left + PANEL_WIDTH / 2.0f, top - panelHeight / 2.0f);
+    _hasPanel = _panel.construct(int(PANEL_WIDTH * DENSITY), int(panelHeight * DENSITY));
+
+    _graphOrigin = glm::vec2(left, top - panelHeight - 5.0f - GRAPH_HEIGHT);
+
+    _shader = std::make_shared<BasicShader>();
+    _shader->load();
+    _mvpLoc = glGetUniformLocation(_shader->program(), "mvp");
+    _colorLoc = glGetUniformLocation(_shader->program(), "fragColor");
+
+    glGenVertexArrays(1, &_vao);
+    gl::genBuffers(1, &_vbo, "DebugOverlay");
+    gl::bindVertexArray(_vao);
+    gl::bindBuffer(GL_ARRAY_BUFFER, _vbo);
+    gl::bufferData(GL_ARRAY_BUFFER, sizeof(_vertices), nullptr, GL_STREAM_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), 0);
+    gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+    gl::bindVertexArray(0);
+
+    _constructed = true;
+}
+
+void DebugOverlay::record(double frameTime)
+{
+    _newest = (_newest + 1) % HISTORY;
+    _history[_newest] = static_cast<float>(frameTime);
+    _recorded++;
+}
+
+void DebugOverlay::draw(const glm::mat4& vp, const RenderSnapshot& snapshot)
+{
+    Clock::Ticks start = Clock::now();
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    // Straight away when just shown, averaging from now on.
+    double now = Clock::seconds();
+    bool shown = _recorded - _drawn > 1;
+    if (shown) {
+        _refreshAllocations = AllocTracker::total();
+        _refreshFrames = 0;
+        _cost = 0.0;
+    }
+    if (_hasPanel && (shown || now >= _nextRefresh)) {
+        _layoutText(snapshot);
+        _nextRefresh = now + REFRESH;
+    }
+    _drawn = _recorded;
+
+    // Without a framebuffer there is only the graph.
+    if (_hasPanel)
+        _panel.composite(glm::scale(glm::translate(vp, glm::vec3(_panelCenter.x, _panelCenter.y, 0.0f)),
+            glm::vec3(1.0f / DENSITY, 1.0f / DENSITY, 1.0f)));
+
+    _drawGraph(vp);
+
+    _cost += Clock::toMilliseconds(Clock::now() - start);
+    _refreshFrames++;
+}
+
+void DebugOverlay::_layoutText(const RenderSnapshot& snapshot)
+{
+    const EnginePtr& engine = App::engine();
+    FrameArena& arena = FrameArena::local();
+    std::string_view lines[LINES];
+
+    const FrameStats::Summary& frame = engine->frameStats().recent(FrameStats::TOTAL);
+    lines[0] = arena.format("fps %d  frame %.2f ms  p99 %.2f  max %.2f  hitches %llu",
+        engine->fps(), _history[_newest], frame.p99, frame.max, static_cast<unsigned long long>(frame.hitches));
+
+    lines[1] = arena.format("update %.3f  render %.3f  swap %.3f ms",
+        1000.0 * engine->updateDelta(), 1000.0 * engine->renderDelta(), 1000.0 * engine->swapDelta());
+
+    lines[2] = arena.format("sim x%d: stage %.3f  scheduler %.3f  capture %.3f ms",
+        snapshot.updateSteps, snapshot.stageTime, snapshot.schedulerTime, snapshot.captureTime);
+
+    if (GLStats::ENABLED) {
+        const GLStats::Counters& gl = GLStats::frame();
+        lines[3] = arena.format("gl: %llu draws  %llu prims  %llu binds  %llu programs  %.1f KB up",
+            static_cast<unsigned long long>(gl.drawCalls), static_cast<unsigned long long>(gl.primitives),
+            static_cast<unsigned long long>(gl.binds), static_cast<unsigned long long>(gl.programSwitches),
+            gl.uploadBytes / 1024.0);
+    } else
+        lines[3] = "gl: build with RANGER_GL_STATS";
+
+    // Allocations per frame since the last refresh.
+    FrameArena::Stats scratch = FrameArena::stats();
+    if (AllocTracker::ENABLED) {
+        AllocStats total = AllocTracker::total();
+        double frames = double(std::max<uint64_t>(_refreshFrames, 1));
+        lines[4] = arena.format("heap: %.1f allocs/frame  %.1f KB live  %llu violations  arena %.1f KB",
+            (total.allocations - _refreshAllocations.allocations) / frames, total.live / 1024.0,
+            static_cast<unsigned long long>(AllocTracker::violations()), scratch.peak / 1024.0);
+        _refreshAllocations = total;
+    } else
+        lines[4] = arena.format("heap: build with RANGER_TRACK_ALLOCATIONS  arena %.1f KB", scratch.peak / 1024.0);
+
+    const Scheduler::Counts& scheduler = snapshot.scheduler;
+    lines[5] = arena.format("scheduler: %zu high  %zu normal  %zu levels  %zu update  %zu interval  %zu behaviors",
+        scheduler.highPriority, scheduler.normalPriority, scheduler.levels,
+        scheduler.updateTargets, scheduler.intervalTargets, scheduler.behaviors);
+
+    // What this overlay cost per frame since the last refresh.
+    if (_refreshFrames > 0)
+        _costShown = _cost / double(_refreshFrames);
+    _cost = 0.0;
+    _refreshFrames = 0;
+    lines[6] = arena.format("overlay %.3f ms/frame", _costShown);
+
+    // Text is drawn in virtual units around the panel's center.
+    float panelHeight = LINES * LINE_HEIGHT + 5.0f;
+    glm::mat4 textVp = glm::scale(_panel.viewProjection(), glm::vec3(DENSITY, DENSITY, 1.0f));
+    float fontScale = App::config()->fontScale();
+    glm::vec3 white{ 1.0f, 1.0f, 1.0f };
+
+    _panel.begin();
+    for (int line = 0; line < LINES; line++)
+        App::renderContext()->freeTypeFont()->renderText(textVp, lines[line], -PANEL_WIDTH / 2.0f + 4.0f,
+            panelHeight / 2.0f - (line + 1) * LINE_HEIGHT, fontScale, white);
+    _panel.end();
+}
+
+void DebugOverlay::_drawGraph(const glm::mat4& vp)
+{
+    // Full height is twice the budget, so the budget line is halfway up.
+    const EnginePtr& engine = App::engine();
+    float budget = static_cast<float>(engine->frameStats().budget());
+    float scale = GRAPH_HEIGHT / (2.0f * budget);
+    float step = PANEL_WIDTH / float(HISTORY - 1);
+    float x = _graphOrigin.x;
+    float y = _graphOrigin.y;
+
+    // Oldest to newest, left to right.
+    for (int i = 0; i < HISTORY; i++) {
+        float ms = _history[(_newest + 1 + i) % HISTORY];
+        _vertices[i] = glm::vec3(x + i * step, y + std::min(ms * scale, GRAPH_HEIGHT), 0.0f);
+    }
+    _vertices[HISTORY + 0] = glm::vec3(x, y + budget * scale, 0.0f);
+    _vertices[HISTORY + 1] = glm::vec3(x + PANEL_WIDTH, y + budget * scale, 0.0f);
+    _vertices[HISTORY + 2] = glm::vec3(x, y, 0.0f);
+    _vertices[HISTORY + 3] = glm::vec3(x + PANEL_WIDTH, y, 0.0f);
+
+    _shader->use();
+    glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(vp));
+
+    gl::bindVertexArray(_vao);
+    gl::bindBuffer(GL_ARRAY_BUFFER, _vbo);
+    gl::bufferData(GL_ARRAY_BUFFER, sizeof(_vertices), _vertices, GL_STREAM_DRAW);
+    gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glUniform3f(_colorLoc, 1.0f, 0.3f, 0.3f);
+    gl::drawArrays(GL_LINES, HISTORY, 4);
+
+    glUniform3f(_colorLoc, 0.3f, 1.0f, 0.3f);
+    gl::drawArrays(GL_LINE_STRIP, 0, HISTORY);
+
+    gl::bindVertexArray(0);
+}
+}
@@ -0,0 +1,93 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_DEBUG_OVERLAY_H
+#define RANGERALPHA_DEBUG_OVERLAY_H
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+
+#include "../Core/Memory/alloc_tracker.h"
+#include "../Rendering/layer_cache.h"
+#include "render_snapshot.h"
+
+namespace Ranger {
+class Shader;
+
+//! Live engine metrics drawn over the scene; toggled with F3.
+/*!
+ * Two parts, so the overlay stays well under 0.1 ms a frame:
+ *  - a frame time graph of the last HISTORY frames, a single line strip
+ *    (plus the budget and zero lines) uploaded and drawn every frame;
+ *  - a text panel (frame, subsystem, GL, heap and scheduler counters)
+ *    laid out into a @see LayerCache only every REFRESH seconds and
+ *    composited as one quad in between. Each string is a single draw,
+ *    but the panel is LINES of them with a vertex upload each, which
+ *    is what would cost if done every frame.
+ *
+ * [record] is called every frame, shown or not, so the graph is full the
+ * moment the overlay is shown.
+ */
+class DebugOverlay final {
+public:
+    static constexpr int HISTORY = 240;
+    //! Seconds between text refreshes.
+    static constexpr double REFRESH = 0.25;
+
+    DebugOverlay();
+    ~DebugOverlay();
+
+    //! [width] x [height] is the virtual resolution.
+    void construct(float width, float height);
+
+    //! The frame that just ended took [frameTime] ms.
+    void record(double frameTime);
+
+    void draw(const glm::mat4& vp, const RenderSnapshot& snapshot);
+
+private:
+    static constexpr int LINES = 7;
+    static constexpr float LINE_HEIGHT = 15.0f;
+    static constexpr float PANEL_WIDTH = 480.0f;
+    static constexpr float GRAPH_HEIGHT = 60.0f;
+    //! Cache texels per virtual unit, so text stays sharp on larger windows.
+    static constexpr float DENSITY = 2.0f;
+
+    void _layoutText(const RenderSnapshot& snapshot);
+    void _drawGraph(const glm::mat4& vp);
+
+    // Text panel.
+    LayerCache _panel;
+    bool _hasPanel{ false };
+    glm::vec2 _panelCenter{};
+    double _nextRefresh{ 0.0 };
+
+    // Frame time graph, a ring of ms.
+    float _history[HISTORY]{};
+    int _newest{ 0 };
+    glm::vec2 _graphOrigin{};
+    glm::vec3 _vertices[HISTORY + 4];
+
+    std::shared_ptr<Shader> _shader;
+    GLint _mvpLoc{};
+    GLint _colorLoc{};
+    GLuint _vao{};
+    GLuint _vbo{};
+    bool _constructed{ false };
+
+    //! Frames recorded so far, and as of the last draw; a gap means hidden.
+    uint64_t _recorded{ 0 };
+    uint64_t _drawn{ 0 };
+
+    // Per refresh averages.
+    AllocStats _refreshAllocations;
+    uint64_t _refreshFrames{ 0 };
+    double _cost{ 0.0 };
+    double _costShown{ 0.0 };
+};
+}
+
+#endif // RANGERALPHA_DEBUG_OVERLAY_H
@@ -0,0 +1,83 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERBETA_RENDER_SNAPSHOT_H
+#define RANGERBETA_RENDER_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../Core/Timing/scheduler.h"
+#include "../ranger.h"
+
+namespace Ranger {
+//! Everything rendering needs from one simulation frame.
+/*!
+ * Written by the simulation (@see Stage::capture) and then only read by
+ * rendering (@see Stage::step), so in pipelined mode rendering never looks
+ * at live simulation state. Transforms are captured as previous + current
+ * fixed step so rendering can interpolate with [alpha]. Only what
+ * rendering draws is captured, and only by value: the simulation may
+ * free anything a snapshot pointed at while rendering still holds it.
+ *
+ * Snapshots are recycled through a @see TripleBuffer; clear() keeps the
+ * vectors' capacity so a steady state frame doesn't allocate.
+ */
+struct RenderSnapshot {
+    struct Text {
+        std::string text;
+        float x;
+        float y;
+        float scale;
+        glm::vec3 color;
+    };
+
+    struct Square {
+        glm::vec3 prevPosition;
+        glm::vec3 position;
+        float prevAngle;
+        float angle;
+        glm::vec3 color;
+    };
+
+    //! Simulation frames produced so far, this one included.
+    uint64_t frame{ 0 };
+    //! When the simulation frame ran (Clock::seconds()).
+    double simStart{ 0.0 };
+    double simEnd{ 0.0 };
+
+    float alpha{ 0.0f };
+    int updateSteps{ 0 };
+    //! Total fixed steps run since start.
+    int64_t totalSteps{ 0 };
+    //! Total fixed steps dropped since start.
+    int64_t droppedSteps{ 0 };
+    //! Total input events drained since start, and their summed capture
+    // to drain latency (ms).
+    int64_t inputEvents{ 0 };
+    double inputLatency{ 0.0 };
+    //! The worst latency of this frame's input (ms).
+    double inputLatencyMax{ 0.0 };
+
+    //! This frame's stage update, scheduler update and capture (ms).
+    double stageTime{ 0.0 };
+    double schedulerTime{ 0.0 };
+    double captureTime{ 0.0 };
+    //! For the debug overlay.
+    Scheduler::Counts scheduler{};
+
+    std::vector<Text> texts;
+    Square square{};
+
+    void clear()
+    {
+        texts.clear();
+    }
+};
+}
+
+#endif // RANGERBETA_RENDER_SNAPSHOT_H
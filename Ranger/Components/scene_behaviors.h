@@ -0,0 +1,25 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERBETA_SCENE_BEHAVIORS_H
+#define RANGERBETA_SCENE_BEHAVIORS_H
+
+#include "../Core/Timing/behavior.h"
+#include "scene_manager.h"
+
+namespace Ranger {
+    //! For @see Behavior(s): suspends until the [Scene] being preloaded by
+    // @see SceneManager::pushWhenReady (or replaceWhenReady) has been pushed.
+    /*!
+     *   manager.pushWhenReady(level);
+     *   co_await sceneReady(manager);
+     *
+     * Completes immediately if nothing is loading.
+     */
+    inline auto sceneReady(const SceneManager& manager) {
+        return until([&manager] { return !manager.isLoading(); });
+    }
+}
+
+#endif //RANGERBETA_SCENE_BEHAVIORS_H
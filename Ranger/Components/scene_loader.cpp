@@ -0,0 +1,170 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include "scene_loader.h"
+#include "../Core/Logging/log.h"
+
+namespace Ranger {
+    // ##########################################################################
+    // SceneAssets
+    // ##########################################################################
+    void SceneAssets::add(const std::string& path, AssetUploader upload) {
+        add(path, &SceneAssets::readFile, std::move(upload));
+    }
+
+    void SceneAssets::add(const std::string& path, AssetDecoder decode, AssetUploader upload) {
+        _requests.push_back(Request{path, std::move(decode), std::move(upload)});
+    }
+
+    bool SceneAssets::readFile(const std::string& path, AssetData& data) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+        if (!file)
+            return false;
+
+        std::streamsize size = file.tellg();
+        file.seekg(0, std::ios::beg);
+
+        data.resize(static_cast<size_t>(size));
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+    }
+
+    // ##########################################################################
+    // SceneLoader
+    // ##########################################################################
+    SceneLoader::SceneLoader() {
+    }
+
+    SceneLoader::~SceneLoader() {
+        if (!_thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _quit = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+    }
+
+    void SceneLoader::load(SceneAssets&& assets) {
+        // Only a scene that preloads pays for the thread.
+        if (!_thread.joinable())
+            _thread = std::thread(&SceneLoader::_run, this);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _generation++;
+            _pending.clear();
+            _decoded.clear();
+
+            for (auto& request : assets._requests)
+                _pending.push_back(std::move(request));
+
+            _total = static_cast<int>(assets._requests.size());
+            _uploaded = 0;
+            _decodedCount = 0;
+            _failed = 0;
+        }
+
+        assets._requests.clear();
+
+        _wake.notify_one();
+    }
+
+    void SceneLoader::cancel() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _generation++;
+        _pending.clear();
+        _decoded.clear();
+        _total = _uploaded = 0;
+    }
+
+    int SceneLoader::pump(double budget, bool upload) {
+        using namespace std::chrono;
+        auto start = steady_clock::now();
+        int uploads = 0;
+
+        while (_uploaded < _total) {
+            Decoded item;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_decoded.empty())
+                    break;
+                item = std::move(_decoded.front());
+                _decoded.pop_front();
+            }
+
+            if (item.generation != _generation)
+                continue;
+
+            if (upload && item.ok && item.upload)
+                item.upload(item.data);
+
+            // A load or cancel during the upload started over; this one
+            // doesn't count towards it.
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (item.generation != _generation)
+                    continue;
+                _uploaded++;
+            }
+            uploads++;
+
+            double spent = duration<double, std::milli>(steady_clock::now() - start).count();
+            if (spent >= budget)
+                break;
+        }
+
+        return uploads;
+    }
+
+    float SceneLoader::progress() const {
+        int total = _total;
+        if (total == 0)
+            return 1.0f;
+        return (_decodedCount + _uploaded) / (2.0f * total);
+    }
+
+    void SceneLoader::_run() {
+        while (true) {
+            SceneAssets::Request request;
+            int generation;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this] { return _quit || !_pending.empty(); });
+
+                if (_quit)
+                    return;
+
+                request = std::move(_pending.front());
+                _pending.pop_front();
+                generation = _generation;
+            }
+
+            // The slow part, outside the lock.
+            AssetData data;
+            bool decoded = request.decode ? request.decode(request.path, data) : SceneAssets::readFile(request.path, data);
+
+            if (!decoded)
+                LOG_ERROR(LogCategory::IO, "SceneLoader: failed to load '{}'", request.path);
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            // Cancelled meanwhile, so it counts against no load.
+            if (generation != _generation)
+                continue;
+
+            if (!decoded)
+                _failed++;
+            _decodedCount++;
+            // A failed asset still travels through the upload queue, without
+            // uploading, so the scene doesn't wait forever. See [failed].
+            _decoded.push_back(Decoded{generation, decoded, std::move(request.upload), std::move(data)});
+        }
+    }
+}
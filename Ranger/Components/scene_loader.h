@@ -0,0 +1,137 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERBETA_SCENE_LOADER_H
+#define RANGERBETA_SCENE_LOADER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ranger {
+    using AssetData = std::vector<unsigned char>;
+
+    //! Runs on the loader thread. Reads and decodes [path] into [data].
+    using AssetDecoder = std::function<bool(const std::string& path, AssetData& data)>;
+
+    //! Runs on the frame (GL) thread with the decoded [data]. This is where
+    // textures, buffers and programs are uploaded.
+    using AssetUploader = std::function<void(AssetData& data)>;
+
+    /*!
+     * The list of assets a [Scene] needs before it can run.
+     * A [Scene] fills this in from @see BaseNode::declareAssets.
+     */
+    class SceneAssets final {
+    public:
+        struct Request {
+            std::string path;
+            AssetDecoder decode;
+            AssetUploader upload;
+        };
+
+        //! The file is read as raw bytes on the loader thread.
+        void add(const std::string& path, AssetUploader upload);
+
+        void add(const std::string& path, AssetDecoder decode, AssetUploader upload);
+
+        bool empty() const {
+            return _requests.empty();
+        }
+
+        size_t size() const {
+            return _requests.size();
+        }
+
+        //! Default decoder: the file's bytes, untouched.
+        static bool readFile(const std::string& path, AssetData& data);
+
+    private:
+        friend class SceneLoader;
+
+        std::vector<Request> _requests;
+    };
+
+    /*!
+     * Loads a [Scene]'s assets without stalling the frame.
+     *
+     * File reading and decoding happen on a background thread, started by
+     * the first [load]. The decoded results are queued back to the frame
+     * thread where [pump] uploads them under a per-frame millisecond budget.
+     * A single upload can't be split, so the budget is checked between
+     * uploads.
+     *
+     * [load], [ready] and [progress] may be called from a thread other than
+     * the one pumping (the simulation, in pipelined mode).
+     */
+    class SceneLoader final {
+    public:
+        SceneLoader();
+        ~SceneLoader();
+
+        SceneLoader(const SceneLoader&) = delete;
+        SceneLoader& operator=(const SceneLoader&) = delete;
+
+        //! Begins loading [assets]. Any load in progress is cancelled.
+        void load(SceneAssets&& assets);
+
+        //! Drops pending work. Assets already uploaded stay uploaded.
+        void cancel();
+
+        //! Call once per frame on the GL thread.
+        /*!
+         * \param budget milliseconds this frame may spend uploading.
+         * \param upload false completes assets without uploading them, for
+         * runs without GL (headless).
+         * \return the number of uploads performed.
+         */
+        int pump(double budget, bool upload = true);
+
+        //! True when every declared asset has been uploaded.
+        bool ready() const {
+            return _uploaded == _total;
+        }
+
+        //! [0.0, 1.0] Decoding and uploading each count for half of an asset.
+        float progress() const;
+
+        bool failed() const {
+            return _failed > 0;
+        }
+
+    private:
+        struct Decoded {
+            int generation;
+            bool ok;
+            AssetUploader upload;
+            AssetData data;
+        };
+
+        void _run();
+
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        bool _quit{false};
+
+        // Guarded by _mutex
+        std::deque<SceneAssets::Request> _pending;
+        std::deque<Decoded> _decoded;
+
+        //! Bumped on every load/cancel so stale decodes are discarded.
+        std::atomic<int> _generation{0};
+
+        std::atomic<int> _decodedCount{0};
+        std::atomic<int> _failed{0};
+        std::atomic<int> _uploaded{0};
+        std::atomic<int> _total{0};
+    };
+}
+
+#endif //RANGERBETA_SCENE_LOADER_H
@@ -12,11 +12,17 @@
 #include "scene_manager.h"
 #include "transition_scene.h"
 #include "../Components/Nodes/basenode.h"
+#include "../Core/Logging/log.h"
 
 namespace Ranger {
+    void SceneManager::storePreviousTransforms() {
+        for (BaseNode* node : _registry.all())
+            node->storePreviousTransform();
+    }
+
     bool SceneManager::step() {
         if (_scenes.empty() && !_warned) {
-            std::cerr << __FILE__ <<  " no more scenes to visit." << std::endl;
+            LOG_WARN(LogCategory::SCENE, "SceneManager: no more scenes to visit.");
             _warned = true;
             return false;
         }
@@ -27,9 +33,6 @@ namespace Ranger {
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);// | GL_STENCIL_BUFFER_BIT);
         }
 
-        if (_nextScene)
-            setNextScene();
-
         // TODO Comment out for RELEASE mode
         //Application.instance.objectsDrawn = 0;
 
@@ -42,9 +45,21 @@ namespace Ranger {
         return true;  // continue to draw
     }
 
+    void SceneManager::update(double dt) {
+        if (_loadingScene)
+            _stepLoading();
+
+        if (_nextScene)
+            setNextScene();
+    }
+
+    void SceneManager::pumpLoading(bool upload) {
+        _loader.pump(_uploadBudget, upload);
+    }
+
     void SceneManager::setNextScene() {
         // Capture currently running scene type.
-        std::cout << "typeid of _runningScene: " << typeid(_runningScene.get()).name() << std::endl;
+        LOG_DEBUG(LogCategory::SCENE, "typeid of _runningScene: {}", typeid(_runningScene.get()).name());
 //        std::cout << "typeid of TransitionScene: " << typeid(TransitionScene).name() << std::endl;
         bool runningSceneIsTransition = typeid(_runningScene.get()) == typeid(TransitionScene);
 //
@@ -76,18 +91,19 @@ namespace Ranger {
 
     void SceneManager::pop() {
         if (!_runningScene) {
-            std::cerr << __FILE__ << "::" << __FUNCTION__ << ": there is no running scene." << std::endl;
+            LOG_ERROR(LogCategory::SCENE, "SceneManager::{}: there is no running scene.", __FUNCTION__);
             return;
         }
 
         if (_scenes.empty()) {
             // No more Scenes to run.
-            std::cerr << __FILE__ << "::" << __FUNCTION__ << ": there are no scenes to pop." << std::endl;
+            LOG_ERROR(LogCategory::SCENE, "SceneManager::{}: there are no scenes to pop.", __FUNCTION__);
         }
         else {
             // Allow running scene a chance to cleanup.
 //            _sendCleanupToScene = true;
 
+            _registry.remove(_scenes.top());
             _scenes.pop();
 
             // If that was the last scene then set the next scene to run as the top.
@@ -112,6 +128,7 @@ namespace Ranger {
         //  print("SceneManager.pushScene pushing ${scene} as first scene");
 
         _scenes.push(scene);
+        _registry.add(scene);
         _nextScene = scene;
         //print("SceneManager.pushScene " + this.toString());
     }
@@ -134,16 +151,61 @@ namespace Ranger {
             //print("SceneManager.replaceScene adding ${scene} as first scene");
             _scenes.push(scene);
         } else {
+            _registry.remove(_scenes.top());
             _scenes.pop();
             //print("SceneManager.replaceScene replacing ${firstScene} with ${scene}");
             _scenes.push(scene);
         }
+        _registry.add(scene);
 
         _nextScene = scene;
 //        _sendCleanupToScene = true;
         //print("SceneManager.replaceScene " + this.toString());
     }
 
+    void SceneManager::pushWhenReady(const BaseNodeSPtr &scene) {
+        _preload(scene, false);
+    }
+
+    void SceneManager::replaceWhenReady(const BaseNodeSPtr &scene) {
+        _preload(scene, true);
+    }
+
+    void SceneManager::_preload(const BaseNodeSPtr &scene, bool replaces) {
+        if (!scene) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << ": Scene not supplied." << std::endl;
+            throw std::invalid_argument(ss.str());
+        }
+
+        SceneAssets assets;
+        scene->declareAssets(assets);
+
+        // A newer request supersedes one still loading.
+        _loader.load(std::move(assets));
+        _loadingScene = scene;
+        _loadingReplaces = replaces;
+    }
+
+    void SceneManager::_stepLoading() {
+        if (_runningScene)
+            _runningScene->onLoadProgress(_loader.progress());
+
+        if (!_loader.ready() || !_loadingScene->isReady())
+            return;
+
+        if (_loader.failed())
+            LOG_ERROR(LogCategory::SCENE, "SceneManager::{}: some assets failed to load.", __FUNCTION__);
+
+        BaseNodeSPtr scene = _loadingScene;
+        _loadingScene = nullptr;
+
+        if (_loadingReplaces && _runningScene)
+            replace(scene);
+        else
+            push(scene);
+    }
+
     void SceneManager::popToRoot() {
         popToStackLevel(STACK::TO_ROOT);
     }
@@ -180,6 +242,7 @@ namespace Ranger {
         while (level > newStackTopLevel) {
             BaseNodeSPtr current = _scenes.top();
             _scenes.pop();
+            _registry.remove(current);
             if (current->running()) {
                 current->onExitTransition();
                 current->onExit();
@@ -195,7 +258,7 @@ namespace Ranger {
     }
 
     void SceneManager::end() {
-        std::cout << "SceneManager: " << "ending." << std::endl;
+        LOG_INFO(LogCategory::SCENE, "SceneManager: ending.");
         popToStackLevel(STACK::ALL);
     }
 
@@ -5,8 +5,11 @@
 #ifndef RANGERBETA_SCENE_MANAGER_H
 #define RANGERBETA_SCENE_MANAGER_H
 
+#include <memory>
 #include <stack>
 #include "../ranger.h"
+#include "Nodes/node_registry.h"
+#include "scene_loader.h"
 
 namespace Ranger {
     /*!
@@ -31,6 +34,18 @@ namespace Ranger {
          */
         bool step();
 
+        //! One fixed update step, on the simulation thread. Switches to a
+        // preloaded [Scene] once it is ready, then to the next [Scene].
+        void update(double dt);
+
+        //! Uploads preloaded assets under [uploadBudget]. Once per frame, on
+        // the GL thread; [upload] false (headless) completes them without GL.
+        void pumpLoading(bool upload = true);
+
+        //! Called by the Engine before each fixed update step so the nodes
+        // can later be rendered between the previous and current step.
+        void storePreviousTransforms();
+
         void setNextScene();
 
         /*!
@@ -56,6 +71,36 @@ namespace Ranger {
          */
         void replace(const BaseNodeSPtr& scene);
 
+        /*!
+         * Same as [push] except the [scene]'s assets are loaded first.
+         * The [scene] declares them in @see BaseNode::declareAssets. Reading
+         * and decoding happens on a background thread, GL uploads are spread
+         * across frames (see [uploadBudget] and [pumpLoading]). The [scene] is pushed once
+         * every asset is uploaded and the [scene] reports ready.
+         * Meanwhile the running [Scene] keeps running and receives
+         * @see BaseNode::onLoadProgress, which is how a loading screen or
+         * a [TransitionScene] shows progress.
+         */
+        void pushWhenReady(const BaseNodeSPtr& scene);
+
+        //! Same as [pushWhenReady] but the [scene] replaces the running one.
+        void replaceWhenReady(const BaseNodeSPtr& scene);
+
+        //! True while a [Scene] is being preloaded.
+        bool isLoading() const {
+            return _loadingScene != nullptr;
+        }
+
+        //! [0.0, 1.0] of the [Scene] being preloaded.
+        float loadProgress() const {
+            return _loader.progress();
+        }
+
+        //! Milliseconds per frame [step] may spend on GL uploads.
+        void uploadBudget(double budget) {
+            _uploadBudget = budget;
+        }
+
         /*!
          * Pops off all [Scene]s from the queue until the root/bottom
          * [Scene] in the queue.
@@ -80,6 +125,15 @@ namespace Ranger {
          */
         void popToStackLevel(int level);
 
+        /*!
+         * Tag/name index of the nodes managed by this [SceneManager].
+         * [Scene]s are registered as they are pushed and unregistered as they
+         * are popped.
+         */
+        NodeRegistry& registry() {
+            return _registry;
+        }
+
     private:
         struct STACK {
             static constexpr int TO_ROOT = 0;
@@ -100,6 +154,14 @@ namespace Ranger {
         BaseNodeSPtr _runningScene;
         BaseNodeSPtr _nextScene;
 
+        NodeRegistry _registry;
+
+        // Preloading; the loader is shared with the GL thread's [pumpLoading].
+        SceneLoader _loader;
+        BaseNodeSPtr _loadingScene;
+        bool _loadingReplaces{false};
+        double _uploadBudget{2.0};
+
         bool _ignoreClear{false};
 
         bool _warned{false};
@@ -112,6 +174,9 @@ namespace Ranger {
          */
 //        bool _cleanup{false};
         void popTotackLevel(int level);
+
+        void _preload(const BaseNodeSPtr& scene, bool replaces);
+        void _stepLoading();
     };
 }
 
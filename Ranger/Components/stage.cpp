@@ -1,13 +1,13 @@
 //
 // Created by William DeVore on 3/9/16.
 //
-#include <iomanip>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "stage.h"
 
+#include "../Core/Memory/frame_arena.h"
 #include "../Extensions/Graphics/view.h"
 #include "../GLFW/window.h"
 #include "../IO/configuration.h"
@@ -15,19 +15,18 @@
 #include "../Rendering/Vectors/Shapes/basic_shapes.h"
 #include "../Rendering/Vectors/vector_object.h"
 #include "../Rendering/freetypefont.h"
+#include "../Rendering/gl_stats.h"
 #include "../Rendering/rendercontext.h"
 #include "../engine.h"
 
 namespace Ranger {
 Stage::Stage()
 {
-    _osUpdate << std::fixed << std::setw(8) << std::setfill('0') << std::right << std::setprecision(4);
-    _osRender << std::fixed << std::setw(8) << std::setfill('0') << std::setprecision(4);
 }
 
 void Stage::construct(float width, float height)
 {
-    _sceneManager = std::make_unique<SceneManager>();
+    constructHeadless();
 
     _vo = std::make_shared<VectorObject>();
     _vo->construct();
@@ -51,24 +50,77 @@ void Stage::construct(float width, float height)
 
     _vp = engine->camera().matrix() * engine->view().matrix();
 
-    // just playing around
-    _pos.x = -200.0f;
-
     _mvpLoc = glGetUniformLocation(_basicShader->program(), "mvp");
     _colorLoc = glGetUniformLocation(_basicShader->program(), "fragColor");
 
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    const ConfigurationPtr& config = App::config();
+    _bgCached = _bgLayer.construct(config->virtualWidth(), config->virtualHeight());
+
+    _overlay.construct(static_cast<float>(config->virtualWidth()), static_cast<float>(config->virtualHeight()));
+}
+
+void Stage::constructHeadless()
+{
+    _sceneManager = std::make_unique<SceneManager>();
+    _sceneManager->uploadBudget(App::config()->assetUploadBudget());
+
+    // just playing around
+    _pos.x = -200.0f;
 }
 
-bool Stage::step()
+void Stage::update(double dt)
 {
+    _sceneManager->storePreviousTransforms();
+    _sceneManager->update(dt);
+
+    _animateSquare(dt);
+    _ticks++;
+}
+
+void Stage::capture(RenderSnapshot& snapshot)
+{
+    snapshot.clear();
+
+    snapshot.square = RenderSnapshot::Square{ _prevPos, _pos, _prevAngle, _angle, glm::vec3(0.9f, 0.0f, 0.9f) };
+
+    const ConfigurationPtr& config = App::config();
+    float svx = static_cast<float>(config->virtualWidth());
+    float svy = static_cast<float>(config->virtualHeight());
+
+    snapshot.texts.push_back(RenderSnapshot::Text{ "t: " + std::to_string(_ticks),
+        -svx / 2.0f + 5.0f, -svy / 2.0f + 55.0f, config->fontScale(), glm::vec3(1.0f, 1.0f, 1.0f) });
+}
+
+bool Stage::step(const RenderSnapshot& snapshot)
+{
+    const EnginePtr& engine = App::engine();
+
+    _sceneManager->pumpLoading();
+
+    // Without a cache (no framebuffer) the background is drawn every frame.
+    if (_bgCached) {
+        if (_bgLayer.dirty()) {
+            _basicShader->use();
+            _vo->use();
+
+            _bgLayer.begin();
+            _drawVirtualBg(_bgLayer.viewProjection());
+            _bgLayer.end();
+        }
+
+        _bgLayer.composite(_vp, engine->window()->fillPolyMode ? GL_FILL : GL_LINE);
+    }
+
     _basicShader->use();
     _vo->use();
 
-    _drawVirtualBg();
+    if (!_bgCached)
+        _drawVirtualBg(_vp);
 
-    _animateSquare();
+    _drawAnimatedSquare(snapshot.square, snapshot.alpha);
     _drawLowerLeftSquare();
     _drawUpperRightSquare();
     _drawSquareAt(450.0f, 100.0f);
@@ -77,8 +129,14 @@ bool Stage::step()
 
     _vo->unUse();
 
-    //  Temporary fps display. This will move to the overlay layer when ready.
-    _drawFPS();
+    _drawTexts(snapshot);
+
+    // F3 swaps the fps text for the full overlay.
+    _overlay.record(engine->frameTime());
+    if (engine->window()->debugOverlay)
+        _overlay.draw(_vp, snapshot);
+    else
+        _drawFPS();
 
     return true;
 }
@@ -92,8 +150,8 @@ void Stage::_drawFPS()
     const EnginePtr& engine = App::engine();
     glm::vec3 white{ 1.0f, 1.0f, 1.0f };
 
-    _osFPS.str("");
-    _osFPS << "fps: " << std::to_string(engine->fps());
+    // The texts only need to last until drawn: frame scratch, not heap.
+    FrameArena& arena = FrameArena::local();
 
     float svx = static_cast<float>(config->virtualWidth());
     float svy = static_cast<float>(config->virtualHeight());
@@ -102,15 +160,34 @@ void Stage::_drawFPS()
     float lowerLeftAnchorX = -svx / 2.0f + 5.0f;
     float lowerLeftAnchorY = -svy / 2.0f;
 
-    _osUpdate.str("");
-    _osUpdate << "u: " << std::fixed << std::setw(7) << std::setfill('0') << std::right << std::setprecision(4) << (1000.0f * engine->updateDelta());
-
-    _osRender.str("");
-    _osRender << "r: " << std::fixed << std::setw(7) << std::setfill('0') << std::right << std::setprecision(4) << (1000.0f * engine->renderDelta());
-
-    renderer->freeTypeFont()->renderText(_vp, _osUpdate.str(), lowerLeftAnchorX, lowerLeftAnchorY + 40.0f, fontScale, white);
-    renderer->freeTypeFont()->renderText(_vp, _osRender.str(), lowerLeftAnchorX, lowerLeftAnchorY + 25.0f, fontScale, white);
-    renderer->freeTypeFont()->renderText(_vp, _osFPS.str(), lowerLeftAnchorX, lowerLeftAnchorY + 10.0f, fontScale, white);
+    std::string_view fps = arena.format("fps: %d", engine->fps());
+    std::string_view update = arena.format("u: %07.4f x%d", 1000.0 * engine->updateDelta(), engine->updateSteps());
+    std::string_view render = arena.format("r: %07.4f", 1000.0 * engine->renderDelta());
+
+    // Frame time percentiles over the stats window.
+    const FrameStats::Summary& frame = engine->frameStats().recent(FrameStats::TOTAL);
+    std::string_view frameText = arena.format("f: %.2f %.2f %.2f %.2f h%llu",
+        frame.p50, frame.p99, frame.p999, frame.max, static_cast<unsigned long long>(frame.hitches));
+
+    // The previous frame's GL calls, and what the GPU holds.
+    if (GLStats::ENABLED) {
+        const GLStats::Counters& gl = GLStats::frame();
+        const GLStats::Resources& gpu = GLStats::resources();
+        std::string_view calls = arena.format("gl: %llu draws %llu prims %llu binds %llu progs %.1f KB up",
+            static_cast<unsigned long long>(gl.drawCalls), static_cast<unsigned long long>(gl.primitives),
+            static_cast<unsigned long long>(gl.binds), static_cast<unsigned long long>(gl.programSwitches),
+            gl.uploadBytes / 1024.0);
+        std::string_view memory = arena.format("gpu: %llu buffers %.1f KB %llu textures %.1f KB",
+            static_cast<unsigned long long>(gpu.buffers), gpu.bufferBytes / 1024.0,
+            static_cast<unsigned long long>(gpu.textures), gpu.textureBytes / 1024.0);
+
+        renderer->freeTypeFont()->renderText(_vp, memory, lowerLeftAnchorX, lowerLeftAnchorY + 100.0f, fontScale, white);
+        renderer->freeTypeFont()->renderText(_vp, calls, lowerLeftAnchorX, lowerLeftAnchorY + 85.0f, fontScale, white);
+    }
+    renderer->freeTypeFont()->renderText(_vp, frameText, lowerLeftAnchorX, lowerLeftAnchorY + 70.0f, fontScale, white);
+    renderer->freeTypeFont()->renderText(_vp, update, lowerLeftAnchorX, lowerLeftAnchorY + 40.0f, fontScale, white);
+    renderer->freeTypeFont()->renderText(_vp, render, lowerLeftAnchorX, lowerLeftAnchorY + 25.0f, fontScale, white);
+    renderer->freeTypeFont()->renderText(_vp, fps, lowerLeftAnchorX, lowerLeftAnchorY + 10.0f, fontScale, white);
 }
 
 void Stage::_drawSquareAt(float x, float y)
@@ -135,7 +212,7 @@ void Stage::_drawSquareAt(float x, float y)
     _vo->draw(_shapeCS);
 }
 
-void Stage::_drawVirtualBg()
+void Stage::_drawVirtualBg(const glm::mat4& vp)
 {
     glm::mat4 mvp;
 
@@ -148,7 +225,7 @@ void Stage::_drawVirtualBg()
     model = glm::translate(model, glm::vec3(-svx / 2.0f, -svy / 2.0f, 0.0f));
     model = glm::scale(model, glm::vec3(svx, svy, 1.0f));
 
-    mvp = _vp * model;
+    mvp = vp * model;
     glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(mvp));
 
     glm::vec3 color = glm::vec3(0.5f, 0.5f, 0.5f);
@@ -202,15 +279,16 @@ void Stage::_drawUpperRightSquare()
 
     _vo->draw(_shapeS);
 }
-void Stage::_animateSquare()
+void Stage::_animateSquare(double dt)
 {
-    glm::mat4 mvp;
+    _prevPos = _pos;
+    _prevAngle = _angle;
 
-    glm::mat4 model;
-    // transform = glm::translate(transform, glm::vec3(0.5f, 0.0f, 0.0f));
-    // model = glm::scale(model, glm::vec3(0.5f, 0.5f, 1.0f));
-    // model = glm::translate(model, glm::vec3(250.0f, 50.0f, 0.0f));
-    _pos.x += _incX;
+    // The rates were tuned as "per frame" at 60Hz; keep them regardless of
+    // the tick rate.
+    float steps = static_cast<float>(dt / FRAME_PERIOD);
+
+    _pos.x += _incX * steps;
     if (_pos.x > 199.0f) {
         _pos.x = 200.0f;
         _incX = -1.0f;
@@ -218,12 +296,35 @@ void Stage::_animateSquare()
         _pos.x = -200.0f;
         _incX = 1.0f;
     }
-    model = glm::translate(model, _pos);
 
-    _angle += 0.5f;
-    if (_angle == 360.0f)
-        _angle = 0.0f;
-    model = glm::rotate(model, glm::radians(_angle), glm::vec3(0.0f, 0.0f, 1.0f));
+    _angle += 0.5f * steps;
+    if (_angle >= 360.0f) {
+        // Wrap both so the interpolation doesn't spin backwards.
+        _angle -= 360.0f;
+        _prevAngle -= 360.0f;
+    }
+}
+
+void Stage::_drawTexts(const RenderSnapshot& snapshot)
+{
+    const RenderContextPtr& renderer = App::renderContext();
+
+    for (const RenderSnapshot::Text& text : snapshot.texts)
+        renderer->freeTypeFont()->renderText(_vp, text.text, text.x, text.y, text.scale, text.color);
+}
+
+void Stage::_drawAnimatedSquare(const RenderSnapshot::Square& square, float alpha)
+{
+    glm::mat4 mvp;
+
+    glm::mat4 model;
+    // transform = glm::translate(transform, glm::vec3(0.5f, 0.0f, 0.0f));
+    // model = glm::scale(model, glm::vec3(0.5f, 0.5f, 1.0f));
+    // model = glm::translate(model, glm::vec3(250.0f, 50.0f, 0.0f));
+    model = glm::translate(model, glm::mix(square.prevPosition, square.position, alpha));
+
+    float angle = square.prevAngle + alpha * (square.angle - square.prevAngle);
+    model = glm::rotate(model, glm::radians(angle), glm::vec3(0.0f, 0.0f, 1.0f));
     model = glm::scale(model, glm::vec3(200.0f, 200.0f, 1.0f));
     // float sx = 1500.0f / 1000.0f;
     // float sy = 900.0f / 600.0f;
@@ -232,8 +333,7 @@ void Stage::_animateSquare()
     mvp = _vp * model;
     glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(mvp));
 
-    glm::vec3 color = glm::vec3(0.9f, 0.0f, 0.9);
-    glUniform3fv(_colorLoc, 1, glm::value_ptr(color));
+    glUniform3fv(_colorLoc, 1, glm::value_ptr(square.color));
 
     _vo->draw(_shapeCS);
 }
@@ -10,7 +10,10 @@
 #include <sstream>
 #include <GL/glew.h>
 
+#include "../Rendering/layer_cache.h"
+#include "debug_overlay.h"
 #include "../ranger.h"
+#include "render_snapshot.h"
 #include "scene_manager.h"
 
 namespace Ranger {
@@ -22,9 +25,29 @@ public:
 
     void construct(float width, float height);
 
+    //! Only what updating needs, no GL resources; for headless runs.
+    void constructHeadless();
+
     float farRange{ 5000.0f };
 
-    bool step();
+    //! One fixed update step: the scene manager, then the stage's own.
+    /*!
+     * \param dt the fixed step period in milliseconds
+     */
+    void update(double dt);
+
+    //! Copies the render relevant state into [snapshot]. Called by the
+    // simulation after its update steps.
+    void capture(RenderSnapshot& snapshot);
+
+    //! Renders [snapshot]. Live simulation state isn't touched so, in
+    // pipelined mode, the simulation can run meanwhile.
+    bool step(const RenderSnapshot& snapshot);
+
+    const std::unique_ptr<SceneManager>& sceneManager() const
+    {
+        return _sceneManager;
+    }
 
     //   const DecimalNumbersSPtr &digitFont() const { return _digits; }
 
@@ -44,24 +67,32 @@ private:
 
     glm::mat4 _vp;
 
+    //! The virtual background never changes, it is drawn once into here.
+    LayerCache _bgLayer;
+    bool _bgCached{ false };
+
+    DebugOverlay _overlay;
+
     // Hacking for fun
     float _angle{ 0.0f };
     glm::vec3 _pos{};
     float _incX{ 1.0f };
+    // The above as of the previous fixed update step.
+    float _prevAngle{ 0.0f };
+    glm::vec3 _prevPos{};
+    //! Fixed update steps so far.
+    uint64_t _ticks{ 0 };
 
     GLuint _mvpLoc;
     GLuint _colorLoc;
-    void _animateSquare();
-    void _drawVirtualBg();
+    void _animateSquare(double dt);
+    void _drawAnimatedSquare(const RenderSnapshot::Square& square, float alpha);
+    void _drawTexts(const RenderSnapshot& snapshot);
+    void _drawVirtualBg(const glm::mat4& vp);
     void _drawFPS();
     void _drawLowerLeftSquare();
     void _drawUpperRightSquare();
     void _drawSquareAt(float x, float y);
-
-    // Debugging stuff
-    std::ostringstream _osFPS;
-    std::ostringstream _osUpdate;
-    std::ostringstream _osRender;
 };
 }
 
@@ -5,13 +5,31 @@
 #ifndef RANGERBETA_TRANSITION_SCENE_H
 #define RANGERBETA_TRANSITION_SCENE_H
 
+#include "Nodes/basenode.h"
 
 namespace Ranger {
     class Scene {
 
     };
-    class TransitionScene : public Scene {
+    class TransitionScene : public BaseNode {
+    public:
+        //! Follows the preload of the Scene being transitioned to.
+        void onLoadProgress(float progress) override {
+            _progress = progress;
+        }
 
+        //! Loading progress, [0.0, 1.0], of the Scene being transitioned to.
+        // @see SceneManager::loadProgress
+        float progress() const {
+            return _progress;
+        }
+
+        void progress(float progress) {
+            _progress = progress;
+        }
+
+    private:
+        float _progress{1.0f};
     };
 }
 
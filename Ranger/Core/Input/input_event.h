@@ -0,0 +1,41 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_INPUT_EVENT_H
+#define RANGERALPHA_INPUT_EVENT_H
+
+#include <cstdint>
+
+#include "../Timing/clock.h"
+
+namespace Ranger {
+    //! One input change, as captured by the @see Window.
+    /*!
+     * Codes and actions are GLFW's (GLFW_KEY_*, GLFW_PRESS, ...) but
+     * nothing here depends on GLFW.
+     */
+    struct InputEvent {
+        enum class Type : uint8_t {
+            KEY, MOUSE_BUTTON, CURSOR, SCROLL, JOYSTICK_AXIS, JOYSTICK_BUTTON
+        };
+
+        static constexpr uint8_t RELEASE = 0;
+        static constexpr uint8_t PRESS = 1;
+        static constexpr uint8_t REPEAT = 2;
+
+        Type type{Type::KEY};
+        //! The joystick, for joystick events.
+        uint8_t device{0};
+        uint8_t action{RELEASE};
+        //! Key, button or axis.
+        int16_t code{0};
+        //! Cursor position, scroll offsets or axis value (x).
+        float x{0.0f};
+        float y{0.0f};
+        //! When the event was captured (Clock::now()).
+        Clock::Ticks time{0};
+    };
+}
+
+#endif //RANGERALPHA_INPUT_EVENT_H
@@ -0,0 +1,80 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include "input_queue.h"
+#include "input_recording.h"
+
+namespace Ranger {
+    void InputQueue::key(int key, int action) {
+        InputEvent event;
+        event.type = InputEvent::Type::KEY;
+        event.code = static_cast<int16_t>(key);
+        event.action = static_cast<uint8_t>(action);
+        _push(event);
+    }
+
+    void InputQueue::mouseButton(int button, int action) {
+        InputEvent event;
+        event.type = InputEvent::Type::MOUSE_BUTTON;
+        event.code = static_cast<int16_t>(button);
+        event.action = static_cast<uint8_t>(action);
+        _push(event);
+    }
+
+    void InputQueue::cursor(double x, double y) {
+        InputEvent event;
+        event.type = InputEvent::Type::CURSOR;
+        event.x = static_cast<float>(x);
+        event.y = static_cast<float>(y);
+        _push(event);
+    }
+
+    void InputQueue::scroll(double x, double y) {
+        InputEvent event;
+        event.type = InputEvent::Type::SCROLL;
+        event.x = static_cast<float>(x);
+        event.y = static_cast<float>(y);
+        _push(event);
+    }
+
+    void InputQueue::axis(int joystick, int axis, float value) {
+        InputEvent event;
+        event.type = InputEvent::Type::JOYSTICK_AXIS;
+        event.device = static_cast<uint8_t>(joystick);
+        event.code = static_cast<int16_t>(axis);
+        event.x = value;
+        _push(event);
+    }
+
+    void InputQueue::joystickButton(int joystick, int button, int action) {
+        InputEvent event;
+        event.type = InputEvent::Type::JOYSTICK_BUTTON;
+        event.device = static_cast<uint8_t>(joystick);
+        event.code = static_cast<int16_t>(button);
+        event.action = static_cast<uint8_t>(action);
+        _push(event);
+    }
+
+    int InputQueue::drain(InputSnapshot& snapshot, InputRecorder* recorder, bool begin) {
+        if (begin)
+            snapshot.beginFrame();
+
+        Clock::Ticks now = Clock::now();
+        InputEvent event;
+        int count = 0;
+        while (_events.tryPop(event)) {
+            snapshot.apply(event, now);
+            if (recorder)
+                recorder->event(event);
+            count++;
+        }
+        return count;
+    }
+
+    void InputQueue::_push(InputEvent& event) {
+        event.time = Clock::now();
+        if (!_events.tryPush(event))
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
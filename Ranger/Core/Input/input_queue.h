@@ -0,0 +1,66 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_INPUT_QUEUE_H
+#define RANGERALPHA_INPUT_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "../spsc_queue.h"
+#include "input_event.h"
+#include "input_snapshot.h"
+
+namespace Ranger {
+    class InputRecorder;
+
+    //! Timestamped input from the thread polling the window to the thread
+    // updating.
+    /*!
+     * The @see Window pushes from its GLFW callbacks (the main thread) and
+     * the Engine drains once per simulation frame, on the simulation thread
+     * when pipelined, whether the frame steps or not. A @see SpscQueue so
+     * neither side locks. If the queue is full (a single frame stalled for a
+     * long time) new events are dropped and counted.
+     */
+    class InputQueue final {
+    public:
+        static constexpr size_t CAPACITY = 1024;
+
+        // Producer
+        void key(int key, int action);
+
+        void mouseButton(int button, int action);
+
+        void cursor(double x, double y);
+
+        void scroll(double x, double y);
+
+        void axis(int joystick, int axis, float value);
+
+        void joystickButton(int joystick, int button, int action);
+
+        // Consumer
+        //! Begins [snapshot]'s frame and applies everything queued.
+        /*!
+         * Returns the number of events applied. Each is also handed to
+         * [recorder], if any. [begin] false adds to the frame begun earlier
+         * instead, keeping edges no update step has seen yet.
+         */
+        int drain(InputSnapshot& snapshot, InputRecorder* recorder = nullptr, bool begin = true);
+
+        //! Events dropped because the queue was full.
+        uint64_t dropped() const {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void _push(InputEvent& event);
+
+        SpscQueue<InputEvent, CAPACITY> _events;
+        std::atomic<uint64_t> _dropped{0};
+    };
+}
+
+#endif //RANGERALPHA_INPUT_QUEUE_H
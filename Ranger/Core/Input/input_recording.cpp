@@ -0,0 +1,163 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include "input_recording.h"
+
+namespace Ranger {
+    namespace {
+        constexpr char MAGIC[4] = {'R', 'N', 'G', 'I'};
+        constexpr uint32_t VERSION = 1;
+        //! u8 type, u8 device, u8 action, i16 code, f32 x, f32 y
+        constexpr size_t EVENT_SIZE = 3 + sizeof(int16_t) + 2 * sizeof(float);
+
+        template<typename T>
+        void write(std::ofstream& file, const T& value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+    }
+
+    // ----------------------------------------------------------------------
+    // InputRecorder
+    // ----------------------------------------------------------------------
+    InputRecorder::InputRecorder(const std::string& path, uint64_t seed, double tickPeriod)
+            : _file(path, std::ios::binary | std::ios::trunc) {
+        if (!_file) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " Couldn't open '" << path << "' for recording";
+            throw std::invalid_argument(ss.str());
+        }
+
+        _file.write(MAGIC, sizeof(MAGIC));
+        write(_file, VERSION);
+        write(_file, seed);
+        write(_file, tickPeriod);
+    }
+
+    InputRecorder::~InputRecorder() {
+        close();
+    }
+
+    void InputRecorder::beginFrame(double frameTime) {
+        if (_inFrame)
+            _writeFrame();
+
+        _inFrame = true;
+        _frameTime = frameTime;
+    }
+
+    void InputRecorder::close() {
+        if (!_file.is_open())
+            return;
+
+        if (_inFrame)
+            _writeFrame();
+        _inFrame = false;
+        _file.close();
+    }
+
+    void InputRecorder::_writeFrame() {
+        write(_file, _frameTime);
+        write(_file, static_cast<uint16_t>(_events.size()));
+        for (const InputEvent& event : _events) {
+            write(_file, static_cast<uint8_t>(event.type));
+            write(_file, event.device);
+            write(_file, event.action);
+            write(_file, event.code);
+            write(_file, event.x);
+            write(_file, event.y);
+        }
+        _events.clear();
+        _frames++;
+    }
+
+    // ----------------------------------------------------------------------
+    // InputReplay
+    // ----------------------------------------------------------------------
+    InputReplay::InputReplay(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " Couldn't open recording '" << path << "'";
+            throw std::invalid_argument(ss.str());
+        }
+        _data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        constexpr size_t HEADER = sizeof(MAGIC) + sizeof(VERSION) + sizeof(_seed) + sizeof(_tickPeriod);
+        if (_data.size() < HEADER || std::memcmp(_data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " '" << path << "' isn't an input recording";
+            throw std::invalid_argument(ss.str());
+        }
+
+        _at = sizeof(MAGIC);
+        uint32_t version = _read<uint32_t>();
+        if (version != VERSION) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " '" << path << "' is version " << version
+               << ", expected " << VERSION;
+            throw std::invalid_argument(ss.str());
+        }
+        _seed = _read<uint64_t>();
+        _tickPeriod = _read<double>();
+    }
+
+    bool InputReplay::nextFrame(double& frameTime) {
+        // Skips the events of a frame that didn't drain them.
+        _at = std::max(_at, _eventsAt + _eventCount * EVENT_SIZE);
+
+        if (_finished || _data.size() - _at < sizeof(double) + sizeof(uint16_t)) {
+            _finished = true;
+            return false;
+        }
+
+        frameTime = _read<double>();
+        _eventCount = _read<uint16_t>();
+        _eventsAt = _at;
+        if (_data.size() - _at < _eventCount * EVENT_SIZE) {
+            // Cut short, the recording process most likely died.
+            _finished = true;
+            return false;
+        }
+
+        _frames++;
+        return true;
+    }
+
+    int InputReplay::drain(InputSnapshot& snapshot, bool begin) {
+        if (begin)
+            snapshot.beginFrame();
+
+        _at = _eventsAt;
+        for (int i = 0; i < _eventCount; i++) {
+            InputEvent event;
+            event.type = static_cast<InputEvent::Type>(_read<uint8_t>());
+            event.device = _read<uint8_t>();
+            event.action = _read<uint8_t>();
+            event.code = _read<int16_t>();
+            event.x = _read<float>();
+            event.y = _read<float>();
+            // Recorded input has no latency to measure.
+            snapshot.apply(event, event.time);
+        }
+
+        int count = _eventCount;
+        _eventsAt = _at;
+        _eventCount = 0;
+        return count;
+    }
+
+    template<typename T>
+    T InputReplay::_read() {
+        T value;
+        std::memcpy(&value, _data.data() + _at, sizeof(T));
+        _at += sizeof(T);
+        return value;
+    }
+}
@@ -0,0 +1,115 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_INPUT_RECORDING_H
+#define RANGERALPHA_INPUT_RECORDING_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "input_event.h"
+#include "input_snapshot.h"
+
+namespace Ranger {
+    //! Writes every simulation frame's frame time and input to a file.
+    /*!
+     * Together with the RNG seed and the fixed step period in the header
+     * that is all the simulation consumes, so an @see InputReplay of the
+     * file runs the same steps with the same input.
+     *
+     * The format is little ceremony, native byte order:
+     *   header: "RNGI", u32 version, u64 seed, f64 tick period (ms)
+     *   frame:  f64 frame time (ms), u16 event count, then per event
+     *           u8 type, u8 device, u8 action, i16 code, f32 x, f32 y
+     * Capture times aren't kept; a frame is ~10 bytes plus 13 per event.
+     */
+    class InputRecorder final {
+    public:
+        //! Throws if [path] can't be written.
+        InputRecorder(const std::string& path, uint64_t seed, double tickPeriod);
+
+        ~InputRecorder();
+
+        //! Starts a simulation frame of [frameTime] ms.
+        void beginFrame(double frameTime);
+
+        //! Called for each event drained during the frame.
+        void event(const InputEvent& event) {
+            _events.push_back(event);
+        }
+
+        //! Writes the last frame and closes the file.
+        void close();
+
+        uint64_t frames() const {
+            return _frames;
+        }
+
+    private:
+        void _writeFrame();
+
+        std::ofstream _file;
+        bool _inFrame{false};
+        double _frameTime{0.0};
+        std::vector<InputEvent> _events;
+        uint64_t _frames{0};
+    };
+
+    //! Plays an @see InputRecorder file back, frame by frame.
+    /*!
+     * The whole file is read up front so replaying never waits on I/O.
+     */
+    class InputReplay final {
+    public:
+        //! Throws if [path] can't be read or isn't a recording.
+        explicit InputReplay(const std::string& path);
+
+        uint64_t seed() const {
+            return _seed;
+        }
+
+        double tickPeriod() const {
+            return _tickPeriod;
+        }
+
+        //! Moves to the next frame; false once the recording has ended.
+        bool nextFrame(double& frameTime);
+
+        //! Begins [snapshot]'s frame and applies the current frame's events.
+        /*!
+         * Returns the number of events applied. [begin] as for
+         * @see InputQueue::drain.
+         */
+        int drain(InputSnapshot& snapshot, bool begin = true);
+
+        bool finished() const {
+            return _finished;
+        }
+
+        //! Frames played so far.
+        uint64_t frames() const {
+            return _frames;
+        }
+
+    private:
+        template<typename T>
+        T _read();
+
+        std::vector<char> _data;
+        size_t _at{0};
+
+        uint64_t _seed{0};
+        double _tickPeriod{0.0};
+
+        //! Where the current frame's events start, and how many.
+        size_t _eventsAt{0};
+        uint16_t _eventCount{0};
+        uint64_t _frames{0};
+        bool _finished{false};
+    };
+}
+
+#endif //RANGERALPHA_INPUT_RECORDING_H
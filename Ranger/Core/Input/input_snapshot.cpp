@@ -0,0 +1,62 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <algorithm>
+
+#include "input_snapshot.h"
+
+namespace Ranger {
+    void InputSnapshot::beginFrame() {
+        _keys.clearEdges();
+        _mouseButtons.clearEdges();
+        for (auto& buttons : _buttons)
+            buttons.clearEdges();
+
+        _prevCursorX = _cursorX;
+        _prevCursorY = _cursorY;
+        _scrollX = 0.0f;
+        _scrollY = 0.0f;
+        std::fill(std::begin(_axesMoved), std::end(_axesMoved), false);
+
+        _events = 0;
+        _latencySum = 0.0;
+        _latencyMax = 0.0;
+    }
+
+    void InputSnapshot::apply(const InputEvent& event, Clock::Ticks now) {
+        switch (event.type) {
+            case InputEvent::Type::KEY:
+                if (_key(event.code))
+                    _keys.apply(event.code, event.action);
+                break;
+            case InputEvent::Type::MOUSE_BUTTON:
+                if (_mouse(event.code))
+                    _mouseButtons.apply(event.code, event.action);
+                break;
+            case InputEvent::Type::CURSOR:
+                _cursorX = event.x;
+                _cursorY = event.y;
+                break;
+            case InputEvent::Type::SCROLL:
+                _scrollX += event.x;
+                _scrollY += event.y;
+                break;
+            case InputEvent::Type::JOYSTICK_AXIS:
+                if (_joystick(event.device) && event.code >= 0 && event.code < JOYSTICK_AXES) {
+                    _axes[event.device][event.code] = event.x;
+                    _axesMoved[event.device] = true;
+                }
+                break;
+            case InputEvent::Type::JOYSTICK_BUTTON:
+                if (_button(event.device, event.code))
+                    _buttons[event.device].apply(event.code, event.action);
+                break;
+        }
+
+        double latency = Clock::toMilliseconds(now - event.time);
+        _events++;
+        _latencySum += latency;
+        _latencyMax = std::max(_latencyMax, latency);
+    }
+}
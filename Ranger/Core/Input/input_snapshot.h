@@ -0,0 +1,198 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_INPUT_SNAPSHOT_H
+#define RANGERALPHA_INPUT_SNAPSHOT_H
+
+#include <bitset>
+#include <cstdint>
+
+#include "input_event.h"
+
+namespace Ranger {
+    //! The input state for one simulation frame.
+    /*!
+     * Filled by @see InputQueue::drain at the start of the frame and then
+     * only read, so gameplay never calls GLFW. Besides what is down it has
+     * the edges: what was pressed or released since the previous frame. A
+     * tap within a single frame is both pressed and released, and not down.
+     *
+     * Out of range codes read as up/0 rather than throw.
+     */
+    class InputSnapshot final {
+    public:
+        static constexpr int KEYS = 512;
+        static constexpr int MOUSE_BUTTONS = 8;
+        static constexpr int JOYSTICKS = 4;
+        static constexpr int JOYSTICK_AXES = 8;
+        static constexpr int JOYSTICK_BUTTONS = 32;
+
+        // ------------------------------------------------------------------
+        // Keys
+        // ------------------------------------------------------------------
+        bool isKeyDown(int key) const {
+            return _key(key) && _keys.down[key];
+        }
+
+        bool wasKeyPressed(int key) const {
+            return _key(key) && _keys.pressed[key];
+        }
+
+        bool wasKeyReleased(int key) const {
+            return _key(key) && _keys.released[key];
+        }
+
+        // ------------------------------------------------------------------
+        // Mouse
+        // ------------------------------------------------------------------
+        bool isMouseDown(int button) const {
+            return _mouse(button) && _mouseButtons.down[button];
+        }
+
+        bool wasMousePressed(int button) const {
+            return _mouse(button) && _mouseButtons.pressed[button];
+        }
+
+        bool wasMouseReleased(int button) const {
+            return _mouse(button) && _mouseButtons.released[button];
+        }
+
+        //! Window coordinates.
+        float cursorX() const {
+            return _cursorX;
+        }
+
+        float cursorY() const {
+            return _cursorY;
+        }
+
+        //! Cursor movement since the previous frame.
+        float cursorDeltaX() const {
+            return _cursorX - _prevCursorX;
+        }
+
+        float cursorDeltaY() const {
+            return _cursorY - _prevCursorY;
+        }
+
+        //! Scrolled since the previous frame.
+        float scrollX() const {
+            return _scrollX;
+        }
+
+        float scrollY() const {
+            return _scrollY;
+        }
+
+        // ------------------------------------------------------------------
+        // Joysticks
+        // ------------------------------------------------------------------
+        float axis(int joystick, int axis) const {
+            return _joystick(joystick) && axis >= 0 && axis < JOYSTICK_AXES
+                   ? _axes[joystick][axis] : 0.0f;
+        }
+
+        //! Any axis of [joystick] moved this frame.
+        bool axesMoved(int joystick) const {
+            return _joystick(joystick) && _axesMoved[joystick];
+        }
+
+        bool isButtonDown(int joystick, int button) const {
+            return _button(joystick, button) && _buttons[joystick].down[button];
+        }
+
+        bool wasButtonPressed(int joystick, int button) const {
+            return _button(joystick, button) && _buttons[joystick].pressed[button];
+        }
+
+        bool wasButtonReleased(int joystick, int button) const {
+            return _button(joystick, button) && _buttons[joystick].released[button];
+        }
+
+        // ------------------------------------------------------------------
+        // Latency
+        // ------------------------------------------------------------------
+        //! Events applied this frame.
+        int events() const {
+            return _events;
+        }
+
+        //! Ms from capture to this frame's drain; mean and max over
+        // this frame's events, 0 without any.
+        double meanLatency() const {
+            return _events > 0 ? _latencySum / _events : 0.0;
+        }
+
+        double maxLatency() const {
+            return _latencyMax;
+        }
+
+        //! Clears the edges and per-frame deltas.
+        void beginFrame();
+
+        void apply(const InputEvent& event, Clock::Ticks now);
+
+    private:
+        template<size_t N>
+        struct Buttons {
+            std::bitset<N> down;
+            std::bitset<N> pressed;
+            std::bitset<N> released;
+
+            void apply(int code, uint8_t action) {
+                if (action == InputEvent::PRESS) {
+                    if (!down[code])
+                        pressed[code] = true;
+                    down[code] = true;
+                }
+                else if (action == InputEvent::RELEASE) {
+                    if (down[code])
+                        released[code] = true;
+                    down[code] = false;
+                }
+            }
+
+            void clearEdges() {
+                pressed.reset();
+                released.reset();
+            }
+        };
+
+        static bool _key(int key) {
+            return key >= 0 && key < KEYS;
+        }
+
+        static bool _mouse(int button) {
+            return button >= 0 && button < MOUSE_BUTTONS;
+        }
+
+        static bool _joystick(int joystick) {
+            return joystick >= 0 && joystick < JOYSTICKS;
+        }
+
+        static bool _button(int joystick, int button) {
+            return _joystick(joystick) && button >= 0 && button < JOYSTICK_BUTTONS;
+        }
+
+        Buttons<KEYS> _keys;
+        Buttons<MOUSE_BUTTONS> _mouseButtons;
+        Buttons<JOYSTICK_BUTTONS> _buttons[JOYSTICKS];
+
+        float _cursorX{0.0f};
+        float _cursorY{0.0f};
+        float _prevCursorX{0.0f};
+        float _prevCursorY{0.0f};
+        float _scrollX{0.0f};
+        float _scrollY{0.0f};
+
+        float _axes[JOYSTICKS][JOYSTICK_AXES]{};
+        bool _axesMoved[JOYSTICKS]{};
+
+        int _events{0};
+        double _latencySum{0.0};
+        double _latencyMax{0.0};
+    };
+}
+
+#endif //RANGERALPHA_INPUT_SNAPSHOT_H
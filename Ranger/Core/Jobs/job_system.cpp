@@ -0,0 +1,314 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <sstream>
+#include <stdexcept>
+
+#include "../Memory/alloc_tracker.h"
+#include "job_system.h"
+
+namespace Ranger {
+    namespace {
+        // Which JobSystem, and which of its workers, the current thread is.
+        thread_local const JobSystem* t_system = nullptr;
+        thread_local void* t_worker = nullptr;
+
+        //! Idle loops before a worker goes to sleep.
+        constexpr int SPIN_COUNT = 64;
+    }
+
+    struct JobSystem::Worker {
+        Worker() {
+            for (uint32_t i = 0; i < JOB_POOL_SIZE; i++)
+                jobs[i].unfinished.store(0, std::memory_order_relaxed);
+        }
+
+        WorkStealingQueue queue;
+        //! Ring of jobs created by this thread.
+        std::unique_ptr<Job[]> jobs{new Job[JOB_POOL_SIZE]};
+        uint32_t allocated{0};
+        //! xorshift state for picking a victim to steal from.
+        uint32_t seed{1};
+        unsigned index{0};
+        std::thread thread;
+        //! External slots only: claimed by a thread.
+        std::atomic<bool> attached{false};
+    };
+
+    // Defined here, where Worker is complete.
+    JobSystem::JobSystem() = default;
+
+    JobSystem::~JobSystem() {
+        shutdown();
+    }
+
+    void JobSystem::initialize(int workers) {
+        if (isRunning())
+            return;
+
+        if (workers < 0) {
+            auto cores = static_cast<int>(std::thread::hardware_concurrency());
+            workers = cores > 1 ? cores - 1 : 0;
+        }
+
+        _workerThreads = static_cast<unsigned>(workers);
+
+        _workers.clear();
+        for (int i = 0; i <= workers + EXTERNAL_THREADS; i++) {
+            _workers.push_back(std::unique_ptr<Worker>(new Worker()));
+            _workers.back()->index = i;
+            _workers.back()->seed = 2654435761u * (i + 1);
+        }
+
+        t_system = this;
+        t_worker = _workers[0].get();
+
+        _running.store(true);
+        for (unsigned i = 1; i <= _workerThreads; i++)
+            _workers[i]->thread = std::thread(&JobSystem::_workerLoop, this, _workers[i].get());
+    }
+
+    void JobSystem::shutdown() {
+        if (!isRunning())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _running.store(false);
+        }
+        _wake.notify_all();
+
+        for (unsigned i = 1; i <= _workerThreads; i++)
+            _workers[i]->thread.join();
+
+        if (t_system == this) {
+            t_system = nullptr;
+            t_worker = nullptr;
+        }
+
+        _workers.clear();
+        _workerThreads = 0;
+        _mainJobs.clear();
+        _mainBatch.clear();
+        _mainQueued.store(0);
+        _queued.store(0);
+    }
+
+    bool JobSystem::isMainThread() const {
+        return t_system == this && !_workers.empty() && t_worker == _workers[0].get();
+    }
+
+    void JobSystem::attachThread() {
+        if (t_system == this)
+            return;
+
+        for (size_t i = _workerThreads + 1; i < _workers.size(); i++) {
+            bool expected = false;
+            if (_workers[i]->attached.compare_exchange_strong(expected, true)) {
+                t_system = this;
+                t_worker = _workers[i].get();
+                return;
+            }
+        }
+
+        std::stringstream ss;
+        ss << __FILE__ << "::" << __FUNCTION__ << ": no free slot, at most " << EXTERNAL_THREADS << " threads can be attached." << std::endl;
+        throw std::logic_error(ss.str());
+    }
+
+    void JobSystem::detachThread() {
+        if (t_system != this || isMainThread())
+            return;
+
+        static_cast<Worker*>(t_worker)->attached.store(false);
+        t_system = nullptr;
+        t_worker = nullptr;
+    }
+
+    // ##########################################################################
+    // Jobs
+    // ##########################################################################
+    void JobSystem::run(Job* job) {
+        Worker& worker = _currentWorker();
+
+        if (!worker.queue.push(job)) {
+            // The deque is full; the job runs right away instead.
+            _execute(job);
+            return;
+        }
+
+        _queued.fetch_add(1);
+        _wakeWorkers();
+    }
+
+    void JobSystem::runOnMain(Job* job) {
+        std::lock_guard<std::mutex> lock(_mainMutex);
+        _mainJobs.push_back(job);
+        _mainQueued.fetch_add(1, std::memory_order_release);
+    }
+
+    void JobSystem::wait(const Job* job) {
+        Worker& worker = _currentWorker();
+        bool main = worker.index == 0;
+
+        while (!isFinished(job)) {
+            Job* next = main ? _takeMainJob() : nullptr;
+            if (!next)
+                next = _next(worker);
+
+            if (next)
+                _execute(next);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::pumpMainThread() {
+        if (_mainQueued.load(std::memory_order_acquire) == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mainMutex);
+            _mainBatch.swap(_mainJobs);
+            _mainQueued.fetch_sub(static_cast<int>(_mainBatch.size()), std::memory_order_relaxed);
+        }
+
+        // Executing may queue more main jobs; those wait for the next pump.
+        for (Job* job : _mainBatch)
+            _execute(job);
+        _mainBatch.clear();
+    }
+
+    void JobSystem::_split(Job* job, const Range& range) {
+        // Hand out the right half as a child until what's left fits the
+        // grain, then run that inline.
+        Range left = range;
+        while (left.end - left.begin > left.grain) {
+            size_t mid = left.begin + (left.end - left.begin) / 2;
+
+            Range right = left;
+            right.begin = mid;
+            run(createChild(job, RangeJob{this, right}));
+
+            left.end = mid;
+        }
+
+        left.thunk(left.body, left.begin, left.end);
+    }
+
+    // ##########################################################################
+    // Internals
+    // ##########################################################################
+    Job* JobSystem::_allocate() {
+        Worker& worker = _currentWorker();
+
+        // Normally the next slot finished long ago. A long lived parent (ex:
+        // a parallelFor root) is simply skipped over.
+        for (uint32_t i = 0; i < JOB_POOL_SIZE; i++) {
+            Job* job = &worker.jobs[worker.allocated++ & (JOB_POOL_SIZE - 1)];
+            if (job->unfinished.load(std::memory_order_acquire) == 0)
+                return job;
+        }
+
+        std::stringstream ss;
+        ss << __FILE__ << "::" << __FUNCTION__ << ": more than " << JOB_POOL_SIZE << " unfinished jobs created by one thread." << std::endl;
+        throw std::logic_error(ss.str());
+    }
+
+    JobSystem::Worker& JobSystem::_currentWorker() const {
+        if (t_system != this) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << ": jobs can only be used from the main thread or a job." << std::endl;
+            throw std::logic_error(ss.str());
+        }
+        return *static_cast<Worker*>(t_worker);
+    }
+
+    Job* JobSystem::_next(Worker& worker) {
+        Job* job = worker.queue.pop();
+
+        if (!job && _workers.size() > 1) {
+            // Start at a random victim so thieves spread out.
+            uint32_t x = worker.seed;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            worker.seed = x;
+
+            auto count = static_cast<uint32_t>(_workers.size());
+            for (uint32_t i = 0; i < count && !job; i++) {
+                uint32_t victim = (x + i) % count;
+                if (victim != worker.index)
+                    job = _workers[victim]->queue.steal();
+            }
+        }
+
+        if (job)
+            _queued.fetch_sub(1, std::memory_order_relaxed);
+
+        return job;
+    }
+
+    Job* JobSystem::_takeMainJob() {
+        if (_mainQueued.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_mainMutex);
+        if (_mainJobs.empty())
+            return nullptr;
+
+        Job* job = _mainJobs.back();
+        _mainJobs.pop_back();
+        _mainQueued.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    void JobSystem::_execute(Job* job) {
+        job->function(job);
+        _finish(job);
+    }
+
+    void JobSystem::_finish(Job* job) {
+        // Read before finishing; once finished the job's slot may be reused.
+        Job* parent = job->parent;
+
+        if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1 && parent)
+            _finish(parent);
+    }
+
+    void JobSystem::_workerLoop(Worker* worker) {
+        t_system = this;
+        t_worker = worker;
+        MemoryScope tag(MemoryTag::JOBS);
+
+        int idle = 0;
+        while (_running.load(std::memory_order_relaxed)) {
+            Job* job = _next(*worker);
+            if (job) {
+                _execute(job);
+                idle = 0;
+                continue;
+            }
+
+            if (++idle < SPIN_COUNT) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Nothing to do for a while; sleep until [run] pushes work.
+            std::unique_lock<std::mutex> lock(_sleepMutex);
+            _sleepers.fetch_add(1);
+            _wake.wait(lock, [this] { return !_running.load() || _queued.load() > 0; });
+            _sleepers.fetch_sub(1);
+            idle = 0;
+        }
+    }
+
+    void JobSystem::_wakeWorkers() {
+        if (_sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(_sleepMutex);
+            _wake.notify_one();
+        }
+    }
+}
@@ -0,0 +1,266 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_JOB_SYSTEM_H
+#define RANGERALPHA_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "work_stealing_queue.h"
+
+namespace Ranger {
+    //! A unit of work for the @see JobSystem.
+    /*!
+     * A Job is two cache lines: bookkeeping plus an inline payload holding
+     * the callable, so creating a job never touches the heap.
+     *
+     * A Job is finished when its own function has run and all of its
+     * children have finished. [unfinished] is that fork-join counter.
+     */
+    struct alignas(64) Job {
+        using Function = void (*)(Job*);
+
+        static constexpr size_t PAYLOAD = 96;
+
+        Function function;
+        Job* parent;
+        //! 1 for the job itself + 1 per unfinished child.
+        std::atomic<int32_t> unfinished;
+
+        alignas(16) unsigned char payload[PAYLOAD];
+    };
+
+    static_assert(sizeof(Job) == 128, "A Job should span exactly two cache lines");
+
+    //! A work stealing job system.
+    /*!
+     * There is one worker thread per core minus one; the main thread is the
+     * remaining "worker" and executes jobs whenever it [wait]s. Each thread
+     * owns a @see WorkStealingQueue; it pushes and pops its own jobs and,
+     * when empty, steals from a random other thread. Idle workers spin
+     * briefly, then sleep until new work is pushed.
+     *
+     * Some work must run on the main thread (anything touching GL). Such jobs
+     * are [runOnMain] and are executed by [pumpMainThread] or by a [wait] on
+     * the main thread.
+     *
+     * Jobs come from a per-thread ring of JOB_POOL_SIZE entries that is never
+     * freed; finished slots are reused. A thread can therefore have at most
+     * JOB_POOL_SIZE unfinished jobs; [parallelFor] stays far below that since
+     * it splits its range recursively.
+     *
+     * Usage:
+     *   Job* root = jobs.create([]{});
+     *   for (auto& particle : particles)
+     *       jobs.run(jobs.createChild(root, [&particle]{ particle.update(); }));
+     *   jobs.run(root);
+     *   jobs.wait(root);
+     *
+     * or simply:
+     *   jobs.parallelFor(0, count, 256, [&](size_t begin, size_t end) {...});
+     *
+     * Job functions are either void() or void(Job*); the latter can spawn
+     * children of the running job.
+     */
+    class JobSystem final {
+    public:
+        static constexpr uint32_t JOB_POOL_SIZE = 4096;
+        static constexpr int AUTO = -1;
+        //! Threads, besides the workers and main, that may [attachThread].
+        static constexpr int EXTERNAL_THREADS = 2;
+
+        JobSystem();
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        //! Starts the workers. The calling thread becomes the main thread.
+        /*!
+         * \param workers worker threads to start; -1 = one per core minus one,
+         * 0 = none, the main thread runs every job itself.
+         */
+        void initialize(int workers = AUTO);
+
+        //! Stops and joins the workers. Outstanding jobs are abandoned.
+        void shutdown();
+
+        bool isRunning() const {
+            return _running.load(std::memory_order_relaxed);
+        }
+
+        //! Worker threads plus the main thread.
+        unsigned threadCount() const {
+            return _workerThreads + 1;
+        }
+
+        bool isMainThread() const;
+
+        //! Lets a thread the JobSystem didn't start (ex: the Engine's
+        // simulation thread) create, run and wait for jobs.
+        /*!
+         * At most EXTERNAL_THREADS at once. Its jobs can still be stolen by
+         * the workers while it is attached.
+         */
+        void attachThread();
+
+        //! Call before the attached thread exits, with none of its jobs
+        // outstanding.
+        void detachThread();
+
+        // ##########################################################################
+        // Jobs
+        // ##########################################################################
+        template<typename F>
+        Job* create(F&& function) {
+            return _create(nullptr, std::forward<F>(function));
+        }
+
+        //! [parent] won't finish until this child has. Create children before
+        // running (or from within) the parent.
+        template<typename F>
+        Job* createChild(Job* parent, F&& function) {
+            parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+            return _create(parent, std::forward<F>(function));
+        }
+
+        //! Queues [job] on the calling thread's deque.
+        void run(Job* job);
+
+        //! Queues [job] for the main thread.
+        void runOnMain(Job* job);
+
+        bool isFinished(const Job* job) const {
+            return job->unfinished.load(std::memory_order_acquire) == 0;
+        }
+
+        //! Blocks until [job] and its children are finished, executing other
+        // jobs meanwhile.
+        void wait(const Job* job);
+
+        //! Executes the main thread jobs queued so far. Main thread only.
+        void pumpMainThread();
+
+        //! Calls [body(begin, end)] over sub ranges of at most [grain] items,
+        // in parallel, and returns once all of them are done.
+        template<typename Body>
+        void parallelFor(size_t begin, size_t end, size_t grain, const Body& body) {
+            if (begin >= end)
+                return;
+            Job* root = parallelForJob(nullptr, begin, end, grain, body);
+            run(root);
+            wait(root);
+        }
+
+        //! A job that runs [body] over [begin, end) when run. [body] must
+        // outlive the job.
+        template<typename Body>
+        Job* parallelForJob(Job* parent, size_t begin, size_t end, size_t grain, const Body& body) {
+            Range range{begin, end, grain > 0 ? grain : 1, &_rangeThunk<Body>, &body};
+            return parent ? createChild(parent, RangeJob{this, range}) : create(RangeJob{this, range});
+        }
+
+    private:
+        struct Worker;
+
+        // ----------------------------------------------------------------------
+        // parallelFor support
+        // ----------------------------------------------------------------------
+        struct Range {
+            size_t begin;
+            size_t end;
+            size_t grain;
+            void (*thunk)(const void* body, size_t begin, size_t end);
+            const void* body;
+        };
+
+        template<typename Body>
+        static void _rangeThunk(const void* body, size_t begin, size_t end) {
+            (*static_cast<const Body*>(body))(begin, end);
+        }
+
+        //! Splits its range in halves, as children of itself, until a half
+        // fits within the grain.
+        struct RangeJob {
+            JobSystem* system;
+            Range range;
+
+            void operator()(Job* job) const {
+                system->_split(job, range);
+            }
+        };
+
+        void _split(Job* job, const Range& range);
+
+        // ----------------------------------------------------------------------
+        // Job creation
+        // ----------------------------------------------------------------------
+        template<typename Fn>
+        static auto _invoke(Fn& fn, Job* job, int) -> decltype(fn(job), void()) {
+            fn(job);
+        }
+
+        template<typename Fn>
+        static void _invoke(Fn& fn, Job*, long) {
+            fn();
+        }
+
+        template<typename F>
+        Job* _create(Job* parent, F&& function) {
+            using Fn = typename std::decay<F>::type;
+            static_assert(sizeof(Fn) <= Job::PAYLOAD, "Job function is too large; capture a pointer to the data instead");
+            static_assert(alignof(Fn) <= 16, "Job function is over aligned");
+
+            Job* job = _allocate();
+            job->parent = parent;
+            job->unfinished.store(1, std::memory_order_relaxed);
+            new (job->payload) Fn(std::forward<F>(function));
+            job->function = [](Job* j) {
+                Fn* fn = reinterpret_cast<Fn*>(j->payload);
+                _invoke(*fn, j, 0);
+                fn->~Fn();
+            };
+            return job;
+        }
+
+        Job* _allocate();
+        Worker& _currentWorker() const;
+        Job* _next(Worker& worker);
+        Job* _takeMainJob();
+        void _execute(Job* job);
+        void _finish(Job* job);
+        void _workerLoop(Worker* worker);
+        void _wakeWorkers();
+
+        //! [0] is the main thread, then [_workerThreads] workers, then the
+        // EXTERNAL_THREADS slots.
+        std::vector<std::unique_ptr<Worker>> _workers;
+        unsigned _workerThreads{0};
+        std::atomic<bool> _running{false};
+
+        //! Jobs sitting in deques, used to decide whether to sleep.
+        std::atomic<int64_t> _queued{0};
+        std::atomic<int> _sleepers{0};
+        std::mutex _sleepMutex;
+        std::condition_variable _wake;
+
+        std::mutex _mainMutex;
+        std::vector<Job*> _mainJobs;
+        //! The jobs [pumpMainThread] is executing.
+        std::vector<Job*> _mainBatch;
+        std::atomic<int> _mainQueued{0};
+    };
+}
+
+#endif //RANGERALPHA_JOB_SYSTEM_H
@@ -0,0 +1,92 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_WORK_STEALING_QUEUE_H
+#define RANGERALPHA_WORK_STEALING_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Ranger {
+    struct Job;
+
+    //! A fixed size Chase-Lev work stealing deque.
+    /*!
+     * The owning thread pushes and pops at the bottom (LIFO, cache warm),
+     * every other thread steals from the top (FIFO, oldest and typically
+     * largest work first). Only [steal] and the last-item [pop] race, and
+     * they settle it with a single CAS on [_top].
+     *
+     * Memory ordering follows Lê, Pop, Cohen & Zappa Nardelli, "Correct and
+     * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+     */
+    class WorkStealingQueue final {
+    public:
+        static constexpr int64_t CAPACITY = 4096;
+
+        //! Owner only. Returns false if the deque is full.
+        bool push(Job* job) {
+            int64_t b = _bottom.load(std::memory_order_relaxed);
+            int64_t t = _top.load(std::memory_order_acquire);
+            if (b - t >= CAPACITY)
+                return false;
+
+            _jobs[b & MASK].store(job, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return true;
+        }
+
+        //! Owner only.
+        Job* pop() {
+            int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = _top.load(std::memory_order_relaxed);
+
+            if (t > b) {
+                // Empty.
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = _jobs[b & MASK].load(std::memory_order_relaxed);
+            if (t == b) {
+                // The last job; a thief may be after it too.
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        //! Any thread.
+        Job* steal() {
+            int64_t t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = _bottom.load(std::memory_order_acquire);
+
+            if (t >= b)
+                return nullptr;
+
+            Job* job = _jobs[t & MASK].load(std::memory_order_relaxed);
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr; // Lost the race, the caller moves on.
+            return job;
+        }
+
+    private:
+        static constexpr int64_t MASK = CAPACITY - 1;
+        static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+        // Top and bottom are written by different threads; keep them on
+        // separate cache lines.
+        alignas(64) std::atomic<int64_t> _top{0};
+        alignas(64) std::atomic<int64_t> _bottom{0};
+        alignas(64) std::array<std::atomic<Job*>, CAPACITY> _jobs{};
+    };
+}
+
+#endif //RANGERALPHA_WORK_STEALING_QUEUE_H
@@ -0,0 +1,382 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../Memory/alloc_tracker.h"
+#include "../spsc_queue.h"
+#include "log.h"
+
+namespace Ranger {
+    namespace {
+        constexpr uint8_t INFO = static_cast<uint8_t>(LogLevel::INFO);
+    }
+
+    std::atomic<uint8_t> Log::_levels[static_cast<size_t>(LogCategory::COUNT)] = {
+            INFO, INFO, INFO, INFO, INFO, INFO, INFO, INFO, INFO
+    };
+
+    namespace {
+        using Steady = std::chrono::steady_clock;
+
+        constexpr size_t QUEUE_SIZE = 1024;
+        //! How often the writer wakes when nobody asks it to.
+        constexpr auto WRITE_PERIOD = std::chrono::milliseconds(10);
+
+        const char* LEVEL_NAMES[] = {"Trace", "Debug", "Info", "Warn", "Error", "Off"};
+        const char* CATEGORY_NAMES[] = {"General", "Engine", "Window", "Timing", "Jobs",
+                                        "Scene", "Rendering", "IO", "Input"};
+
+        //! One per logging thread; only that thread pushes.
+        struct ThreadQueue {
+            SpscQueue<LogRecord, QUEUE_SIZE> records;
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<bool> alive{true};
+            uint32_t thread{0};
+        };
+
+        //! The writer side.
+        class Writer final {
+        public:
+            Writer() {
+                _thread = std::thread(&Writer::_run, this);
+            }
+
+            std::shared_ptr<ThreadQueue> attach() {
+                auto queue = std::make_shared<ThreadQueue>();
+                std::lock_guard<std::mutex> lock(_mutex);
+                queue->thread = _nextThread++;
+                _queues.push_back(queue);
+                return queue;
+            }
+
+            bool running() const {
+                return _running.load(std::memory_order_acquire);
+            }
+
+            void sink(std::ostream& stream) {
+                std::lock_guard<std::mutex> lock(_writeMutex);
+                _sink = &stream;
+            }
+
+            void flush() {
+                if (!running())
+                    return;
+                std::unique_lock<std::mutex> lock(_mutex);
+                uint64_t ticket = ++_flushRequested;
+                _wake.notify_one();
+                _flushedCond.wait(lock, [this, ticket] { return _flushed >= ticket || !running(); });
+            }
+
+            void stop() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    if (!_running.load(std::memory_order_relaxed))
+                        return;
+                    _stop = true;
+                }
+                _wake.notify_one();
+                _thread.join();
+                _running.store(false, std::memory_order_release);
+                _flushedCond.notify_all();
+
+                // Anything queued while the writer was finishing.
+                std::vector<std::shared_ptr<ThreadQueue>> queues;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    queues = _queues;
+                }
+                _drain(queues);
+            }
+
+            //! Used once the writer has stopped.
+            void writeNow(const LogRecord& record) {
+                std::lock_guard<std::mutex> lock(_writeMutex);
+                _format(record);
+                *_sink << _line << std::flush;
+            }
+
+            uint64_t dropped() {
+                std::lock_guard<std::mutex> lock(_mutex);
+                uint64_t total = _retiredDropped;
+                for (auto& queue : _queues)
+                    total += queue->dropped.load(std::memory_order_relaxed);
+                return total;
+            }
+
+        private:
+            void _run() {
+                MemoryScope tag(MemoryTag::LOGGING);
+                std::unique_lock<std::mutex> lock(_mutex);
+                while (true) {
+                    _wake.wait_for(lock, WRITE_PERIOD, [this] {
+                        return _stop || _flushRequested > _flushed;
+                    });
+                    bool stopping = _stop;
+                    uint64_t ticket = _flushRequested;
+
+                    std::vector<std::shared_ptr<ThreadQueue>> queues = _queues;
+                    lock.unlock();
+
+                    _drain(queues);
+
+                    lock.lock();
+                    _retire();
+                    _flushed = ticket;
+                    _flushedCond.notify_all();
+                    if (stopping)
+                        return;
+                }
+            }
+
+            void _drain(const std::vector<std::shared_ptr<ThreadQueue>>& queues) {
+                _batch.clear();
+                uint64_t dropped = _retiredDropped;
+                for (auto& queue : queues) {
+                    LogRecord record;
+                    while (queue->records.tryPop(record))
+                        _batch.push_back(record);
+                    dropped += queue->dropped.load(std::memory_order_relaxed);
+                }
+
+                if (_batch.empty() && dropped == _reportedDropped)
+                    return;
+
+                // Each thread's records are in order; interleave them.
+                std::stable_sort(_batch.begin(), _batch.end(), [](const LogRecord& a, const LogRecord& b) {
+                    return a.time < b.time;
+                });
+
+                std::lock_guard<std::mutex> lock(_writeMutex);
+                for (auto& record : _batch) {
+                    _format(record);
+                    *_sink << _line;
+                }
+                if (dropped != _reportedDropped) {
+                    *_sink << "Log: " << (dropped - _reportedDropped) << " records dropped, queue full\n";
+                    _reportedDropped = dropped;
+                }
+                _sink->flush();
+            }
+
+            //! Forgets queues whose thread has exited, once drained.
+            void _retire() {
+                auto dead = std::remove_if(_queues.begin(), _queues.end(), [this](const std::shared_ptr<ThreadQueue>& queue) {
+                    if (queue->alive.load(std::memory_order_acquire) || queue->records.size() > 0)
+                        return false;
+                    _retiredDropped += queue->dropped.load(std::memory_order_relaxed);
+                    return true;
+                });
+                _queues.erase(dead, _queues.end());
+            }
+
+            void _format(const LogRecord& record) {
+                // "   12.345678 Warn  Timing    t0  " with to_chars; snprintf
+                // is several times slower.
+                int64_t micros = (record.time - _epoch) / 1000;
+                _line.clear();
+                _appendPadded(micros / 1000000, 5);
+                _line += '.';
+                char digits[8];
+                auto end = std::to_chars(digits, digits + sizeof(digits), 1000000 + micros % 1000000).ptr;
+                _line.append(digits + 1, end);
+                _line += ' ';
+                _appendName(LEVEL_NAMES[static_cast<int>(record.level)], 6);
+                _appendName(CATEGORY_NAMES[static_cast<int>(record.category)], 10);
+                _line += 't';
+                _appendNumber(record.thread);
+                _line += ' ';
+
+                int arg = 0;
+                const char* run = record.format;
+                for (const char* c = record.format; *c; c++) {
+                    if (c[0] == '{' && c[1] == '}' && arg < record.argCount) {
+                        _line.append(run, c);
+                        _append(record, arg++);
+                        run = ++c + 1;
+                    }
+                }
+                _line.append(run);
+                // Arguments without a {}.
+                while (arg < record.argCount) {
+                    _line += ' ';
+                    _append(record, arg++);
+                }
+                _line += '\n';
+            }
+
+            void _append(const LogRecord& record, int i) {
+                const LogRecord::Value& value = record.values[i];
+                switch (record.types[i]) {
+                    case LogRecord::Arg::INT:
+                        _appendNumber(value.i);
+                        break;
+                    case LogRecord::Arg::UINT:
+                        _appendNumber(value.u);
+                        break;
+                    case LogRecord::Arg::DOUBLE:
+                        _appendNumber(value.d);
+                        break;
+                    case LogRecord::Arg::BOOL:
+                        _line += value.u ? "true" : "false";
+                        break;
+                    case LogRecord::Arg::CHAR:
+                        _line += static_cast<char>(value.u);
+                        break;
+                    case LogRecord::Arg::TEXT:
+                        _line.append(record.text + (value.u >> 16), value.u & 0xFFFF);
+                        break;
+                }
+            }
+
+            template<typename T>
+            void _appendNumber(T value) {
+                char buffer[32];
+                auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+                _line.append(buffer, end);
+            }
+
+            void _appendPadded(int64_t value, size_t width) {
+                char buffer[24];
+                auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+                size_t length = end - buffer;
+                if (length < width)
+                    _line.append(width - length, ' ');
+                _line.append(buffer, end);
+            }
+
+            void _appendName(const char* name, size_t width) {
+                size_t length = std::strlen(name);
+                _line.append(name, length);
+                _line.append(length < width ? width - length : 1, ' ');
+            }
+
+            const int64_t _epoch{std::chrono::duration_cast<std::chrono::nanoseconds>(Steady::now().time_since_epoch()).count()};
+
+            std::thread _thread;
+            std::mutex _mutex;
+            std::condition_variable _wake;
+            std::condition_variable _flushedCond;
+            // Guarded by _mutex.
+            std::vector<std::shared_ptr<ThreadQueue>> _queues;
+            uint32_t _nextThread{0};
+            uint64_t _retiredDropped{0};
+            uint64_t _flushRequested{0};
+            uint64_t _flushed{0};
+            bool _stop{false};
+            std::atomic<bool> _running{true};
+
+            // Owned by the writer thread.
+            std::vector<LogRecord> _batch;
+            uint64_t _reportedDropped{0};
+
+            // Guarded by _writeMutex.
+            std::mutex _writeMutex;
+            std::ostream* _sink{&std::cout};
+            std::string _line;
+        };
+
+        //! Never destroyed, so logging from static destructors is safe; at
+        // exit it is stopped and anything later is written synchronously.
+        Writer& writer() {
+            static Writer* instance = [] {
+                auto* w = new Writer();
+                std::atexit([] { writer().stop(); });
+                return w;
+            }();
+            return *instance;
+        }
+
+        //! Marks the thread's queue dead when the thread exits.
+        struct ThreadQueueHolder {
+            std::shared_ptr<ThreadQueue> queue{writer().attach()};
+
+            ~ThreadQueueHolder() {
+                queue->alive.store(false, std::memory_order_release);
+            }
+        };
+    }
+
+    void Log::level(LogLevel level) {
+        for (auto& l : _levels)
+            l.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    void Log::level(LogCategory category, LogLevel level) {
+        _levels[static_cast<uint8_t>(category)].store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    LogLevel Log::parseLevel(const std::string& name) {
+        for (int i = 0; i <= static_cast<int>(LogLevel::OFF); i++) {
+            if (name == LEVEL_NAMES[i])
+                return static_cast<LogLevel>(i);
+        }
+
+        std::stringstream ss;
+        ss << __FILE__ << "::" << __FUNCTION__ << " Unknown log level: '" << name << "'";
+        throw std::invalid_argument(ss.str());
+    }
+
+    LogCategory Log::parseCategory(const std::string& name) {
+        for (int i = 0; i < static_cast<int>(LogCategory::COUNT); i++) {
+            if (name == CATEGORY_NAMES[i])
+                return static_cast<LogCategory>(i);
+        }
+
+        std::stringstream ss;
+        ss << __FILE__ << "::" << __FUNCTION__ << " Unknown log category: '" << name << "'";
+        throw std::invalid_argument(ss.str());
+    }
+
+    const char* Log::levelName(LogLevel level) {
+        return LEVEL_NAMES[static_cast<int>(level)];
+    }
+
+    const char* Log::categoryName(LogCategory category) {
+        return CATEGORY_NAMES[static_cast<int>(category)];
+    }
+
+    void Log::sink(std::ostream& stream) {
+        writer().sink(stream);
+    }
+
+    void Log::flush() {
+        writer().flush();
+    }
+
+    void Log::shutdown() {
+        writer().stop();
+    }
+
+    uint64_t Log::dropped() {
+        return writer().dropped();
+    }
+
+    void Log::_submit(LogRecord& record) {
+        // The first call starts the writer, and its epoch, before stamping.
+        Writer& w = writer();
+        record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(Steady::now().time_since_epoch()).count();
+
+        if (!w.running()) {
+            record.thread = 0;
+            w.writeNow(record);
+            return;
+        }
+
+        thread_local ThreadQueueHolder holder;
+        record.thread = holder.queue->thread;
+        if (!holder.queue->records.tryPush(record))
+            holder.queue->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
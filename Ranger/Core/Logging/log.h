@@ -0,0 +1,233 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_LOG_H
+#define RANGERALPHA_LOG_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//! The lowest level compiled in: 0 trace, 1 debug, 2 info, 3 warn, 4 error,
+// 5 nothing. Calls below it are removed by the preprocessor, arguments and
+// all. Defaults to debug, or info with NDEBUG.
+#ifndef RANGER_LOG_LEVEL
+#ifdef NDEBUG
+#define RANGER_LOG_LEVEL 2
+#else
+#define RANGER_LOG_LEVEL 1
+#endif
+#endif
+
+namespace Ranger {
+    enum class LogLevel : uint8_t {
+        TRACE, DEBUG, INFO, WARN, ERROR, OFF
+    };
+
+    enum class LogCategory : uint8_t {
+        GENERAL, ENGINE, WINDOW, TIMING, JOBS, SCENE, RENDERING, IO, INPUT, COUNT
+    };
+
+    //! One log call, unformatted.
+    /*!
+     * The format must be a string literal (it is kept by pointer); "{}"
+     * marks where each argument goes. Strings are copied, truncated, into
+     * [text] so the caller's can go away.
+     */
+    struct LogRecord {
+        static constexpr int MAX_ARGS = 8;
+        static constexpr int TEXT = 96;
+
+        enum class Arg : uint8_t {
+            INT, UINT, DOUBLE, BOOL, CHAR, TEXT
+        };
+
+        union Value {
+            int64_t i;
+            uint64_t u;
+            double d;
+        };
+
+        int64_t time;
+        const char* format;
+        LogLevel level;
+        LogCategory category;
+        uint8_t argCount;
+        uint8_t textUsed;
+        uint32_t thread;
+        Arg types[MAX_ARGS];
+        Value values[MAX_ARGS];
+        char text[TEXT];
+    };
+
+    //! Asynchronous logging.
+    /*!
+     * A call that passes the level filters (one relaxed load) packs its
+     * arguments into a @see LogRecord and pushes it into the calling
+     * thread's lock-free queue; nothing is formatted and nothing locks.
+     * A background thread drains every thread's queue, orders the records
+     * by time, formats them and writes them out, flushing once per batch.
+     *
+     * A full queue drops the record (counted and reported) rather than
+     * block the caller. Use the LOG_* macros so disabled levels compile
+     * out:
+     *
+     *   LOG_WARN(LogCategory::TIMING, "UpdateTarget [{}] already scheduled.", id);
+     */
+    class Log final {
+    public:
+        //! True if [level] messages of [category] are currently written.
+        static bool enabled(LogLevel level, LogCategory category) {
+            return static_cast<uint8_t>(level) >= _levels[static_cast<uint8_t>(category)].load(std::memory_order_relaxed);
+        }
+
+        //! Sets the level of every category.
+        static void level(LogLevel level);
+
+        static void level(LogCategory category, LogLevel level);
+
+        static LogLevel level(LogCategory category) {
+            return static_cast<LogLevel>(_levels[static_cast<uint8_t>(category)].load(std::memory_order_relaxed));
+        }
+
+        //! "Trace", "Debug", "Info", "Warn", "Error" or "Off"; throws otherwise.
+        static LogLevel parseLevel(const std::string& name);
+
+        //! "General", "Engine", "Window", ...; throws otherwise.
+        static LogCategory parseCategory(const std::string& name);
+
+        static const char* levelName(LogLevel level);
+
+        static const char* categoryName(LogCategory category);
+
+        //! Where formatted lines go; std::cout by default. Whole batches are
+        // written at once, so others writing to it directly interleave
+        // between batches, not within lines.
+        static void sink(std::ostream& stream);
+
+        //! Blocks until everything logged so far has been written.
+        static void flush();
+
+        //! Flushes and stops the background thread. Later calls are
+        // written synchronously. Called at exit otherwise.
+        static void shutdown();
+
+        //! Records dropped because a thread's queue was full.
+        static uint64_t dropped();
+
+        template<typename... Args>
+        static void write(LogLevel level, LogCategory category, const char* format, const Args&... args) {
+            static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log arguments");
+
+            LogRecord record;
+            record.level = level;
+            record.category = category;
+            record.format = format;
+            record.argCount = 0;
+            record.textUsed = 0;
+            (_pack(record, args), ...);
+            _submit(record);
+        }
+
+    private:
+        template<typename T>
+        static void _pack(LogRecord& record, const T& arg) {
+            uint8_t i = record.argCount++;
+            LogRecord::Value& value = record.values[i];
+
+            if constexpr (std::is_same_v<T, bool>) {
+                record.types[i] = LogRecord::Arg::BOOL;
+                value.u = arg ? 1 : 0;
+            }
+            else if constexpr (std::is_same_v<T, char>) {
+                record.types[i] = LogRecord::Arg::CHAR;
+                value.u = static_cast<unsigned char>(arg);
+            }
+            else if constexpr (std::is_enum_v<T>) {
+                record.types[i] = LogRecord::Arg::INT;
+                value.i = static_cast<int64_t>(arg);
+            }
+            else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                record.types[i] = LogRecord::Arg::INT;
+                value.i = arg;
+            }
+            else if constexpr (std::is_integral_v<T>) {
+                record.types[i] = LogRecord::Arg::UINT;
+                value.u = arg;
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+                record.types[i] = LogRecord::Arg::DOUBLE;
+                value.d = arg;
+            }
+            else if constexpr (std::is_pointer_v<T>) {
+                static_assert(std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>,
+                              "Only char pointers can be logged");
+                _packText(record, i, arg ? std::string_view(arg) : std::string_view("(null)"));
+            }
+            else {
+                static_assert(std::is_convertible_v<const T&, std::string_view>,
+                              "Log arguments are numbers, bools, chars or strings");
+                _packText(record, i, std::string_view(arg));
+            }
+        }
+
+        static void _packText(LogRecord& record, uint8_t i, std::string_view text) {
+            size_t length = std::min(text.size(), size_t(LogRecord::TEXT - record.textUsed));
+            std::memcpy(record.text + record.textUsed, text.data(), length);
+
+            record.types[i] = LogRecord::Arg::TEXT;
+            // Offset and length within [text].
+            record.values[i].u = (uint64_t(record.textUsed) << 16) | length;
+            record.textUsed = static_cast<uint8_t>(record.textUsed + length);
+        }
+
+        //! Timestamps [record] and queues it.
+        static void _submit(LogRecord& record);
+
+        static std::atomic<uint8_t> _levels[static_cast<size_t>(LogCategory::COUNT)];
+    };
+}
+
+#define RANGER_LOG(level, category, ...) \
+    do { \
+        if (::Ranger::Log::enabled(level, category)) \
+            ::Ranger::Log::write(level, category, __VA_ARGS__); \
+    } while (0)
+
+#if RANGER_LOG_LEVEL <= 0
+#define LOG_TRACE(category, ...) RANGER_LOG(::Ranger::LogLevel::TRACE, category, __VA_ARGS__)
+#else
+#define LOG_TRACE(category, ...) ((void)0)
+#endif
+
+#if RANGER_LOG_LEVEL <= 1
+#define LOG_DEBUG(category, ...) RANGER_LOG(::Ranger::LogLevel::DEBUG, category, __VA_ARGS__)
+#else
+#define LOG_DEBUG(category, ...) ((void)0)
+#endif
+
+#if RANGER_LOG_LEVEL <= 2
+#define LOG_INFO(category, ...) RANGER_LOG(::Ranger::LogLevel::INFO, category, __VA_ARGS__)
+#else
+#define LOG_INFO(category, ...) ((void)0)
+#endif
+
+#if RANGER_LOG_LEVEL <= 3
+#define LOG_WARN(category, ...) RANGER_LOG(::Ranger::LogLevel::WARN, category, __VA_ARGS__)
+#else
+#define LOG_WARN(category, ...) ((void)0)
+#endif
+
+#if RANGER_LOG_LEVEL <= 4
+#define LOG_ERROR(category, ...) RANGER_LOG(::Ranger::LogLevel::ERROR, category, __VA_ARGS__)
+#else
+#define LOG_ERROR(category, ...) ((void)0)
+#endif
+
+#endif //RANGERALPHA_LOG_H
@@ -0,0 +1,258 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+
+#include "alloc_tracker.h"
+
+namespace Ranger {
+    namespace {
+        const char* TAG_NAMES[] = {"General", "Engine", "Rendering", "Scene", "Timing",
+                                   "Jobs", "IO", "Input", "Logging"};
+
+        constexpr size_t TAGS = static_cast<size_t>(MemoryTag::COUNT);
+
+        struct Counters {
+            std::atomic<uint64_t> allocations{0};
+            std::atomic<uint64_t> frees{0};
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<int64_t> live{0};
+
+            AllocStats load() const {
+                return AllocStats{allocations.load(std::memory_order_relaxed),
+                                  frees.load(std::memory_order_relaxed),
+                                  bytes.load(std::memory_order_relaxed),
+                                  live.load(std::memory_order_relaxed)};
+            }
+        };
+
+        // Plain data only: nothing here may allocate.
+        Counters g_total;
+        Counters g_tags[TAGS];
+        std::atomic<uint64_t> g_violations{0};
+        std::atomic<uint8_t> g_violationTag{0};
+        std::atomic<uint64_t> g_violationSize{0};
+        std::atomic<bool> g_abort{false};
+
+        thread_local MemoryTag t_tag{MemoryTag::GENERAL};
+        thread_local int t_forbidden{0};
+        thread_local AllocStats t_stats;
+    }
+
+    const char* AllocTracker::tagName(MemoryTag tag) {
+        return TAG_NAMES[static_cast<int>(tag)];
+    }
+
+    AllocStats AllocTracker::total() {
+        return g_total.load();
+    }
+
+    AllocStats AllocTracker::tag(MemoryTag tag) {
+        return g_tags[static_cast<size_t>(tag)].load();
+    }
+
+    AllocStats AllocTracker::thread() {
+        return t_stats;
+    }
+
+    uint64_t AllocTracker::violations() {
+        return g_violations.load(std::memory_order_relaxed);
+    }
+
+    MemoryTag AllocTracker::violationTag() {
+        return static_cast<MemoryTag>(g_violationTag.load(std::memory_order_relaxed));
+    }
+
+    size_t AllocTracker::violationSize() {
+        return g_violationSize.load(std::memory_order_relaxed);
+    }
+
+    void AllocTracker::abortOnViolation(bool abort) {
+        g_abort.store(abort, std::memory_order_relaxed);
+    }
+
+    MemoryTag AllocTracker::_swapTag(MemoryTag tag) {
+        MemoryTag previous = t_tag;
+        t_tag = tag;
+        return previous;
+    }
+
+    void AllocTracker::_forbid(int delta) {
+        t_forbidden += delta;
+    }
+}
+
+#if RANGER_TRACK_ALLOCATIONS
+
+namespace {
+    using namespace Ranger;
+
+    //! Sits right before every block handed out.
+    struct alignas(16) Header {
+        uint64_t size;
+        //! From the malloc'd block to the user's.
+        uint32_t offset;
+        MemoryTag tag;
+    };
+    static_assert(sizeof(Header) == 16, "Header must keep blocks 16 byte aligned");
+
+    void violation(size_t size, MemoryTag tag) {
+        g_violations.fetch_add(1, std::memory_order_relaxed);
+        g_violationTag.store(static_cast<uint8_t>(tag), std::memory_order_relaxed);
+        g_violationSize.store(size, std::memory_order_relaxed);
+
+        if (g_abort.load(std::memory_order_relaxed)) {
+            // No iostreams: they might allocate.
+            std::fprintf(stderr, "AllocTracker: %zu byte allocation tagged %s in a NoAllocScope\n",
+                         size, AllocTracker::tagName(tag));
+            std::abort();
+        }
+    }
+
+    void* allocate(size_t size, size_t alignment) {
+        size_t offset = alignment > sizeof(Header) ? alignment : sizeof(Header);
+        void* block = offset == sizeof(Header)
+                      ? std::malloc(size + offset)
+                      : std::aligned_alloc(offset, (size + offset + offset - 1) / offset * offset);
+        if (!block)
+            return nullptr;
+
+        MemoryTag tag = t_tag;
+        char* user = static_cast<char*>(block) + offset;
+        Header* header = reinterpret_cast<Header*>(user) - 1;
+        header->size = size;
+        header->offset = static_cast<uint32_t>(offset);
+        header->tag = tag;
+
+        Counters& counters = g_tags[static_cast<size_t>(tag)];
+        for (Counters* c : {&g_total, &counters}) {
+            c->allocations.fetch_add(1, std::memory_order_relaxed);
+            c->bytes.fetch_add(size, std::memory_order_relaxed);
+            c->live.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+        }
+        t_stats.allocations++;
+        t_stats.bytes += size;
+        t_stats.live += static_cast<int64_t>(size);
+
+        if (t_forbidden > 0)
+            violation(size, tag);
+
+        return user;
+    }
+
+    void deallocate(void* user) {
+        if (!user)
+            return;
+
+        Header* header = static_cast<Header*>(user) - 1;
+        int64_t size = static_cast<int64_t>(header->size);
+
+        Counters& counters = g_tags[static_cast<size_t>(header->tag)];
+        for (Counters* c : {&g_total, &counters}) {
+            c->frees.fetch_add(1, std::memory_order_relaxed);
+            c->live.fetch_sub(size, std::memory_order_relaxed);
+        }
+        t_stats.frees++;
+        t_stats.live -= size;
+
+        std::free(static_cast<char*>(user) - header->offset);
+    }
+
+    void* allocateOrThrow(size_t size, size_t alignment) {
+        while (true) {
+            if (void* p = allocate(size, alignment))
+                return p;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+void* operator new(size_t size) {
+    return allocateOrThrow(size, sizeof(Header));
+}
+
+void* operator new[](size_t size) {
+    return allocateOrThrow(size, sizeof(Header));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, sizeof(Header));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size, sizeof(Header));
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocateOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p) noexcept {
+    deallocate(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    deallocate(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+    deallocate(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    deallocate(p);
+}
+
+#endif
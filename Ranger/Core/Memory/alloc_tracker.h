@@ -0,0 +1,121 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_ALLOC_TRACKER_H
+#define RANGERALPHA_ALLOC_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+
+//! 1 replaces the global operator new/delete with counting ones. Costs a
+// 16 byte header and a few relaxed atomics per allocation; off by default.
+#ifndef RANGER_TRACK_ALLOCATIONS
+#define RANGER_TRACK_ALLOCATIONS 0
+#endif
+
+namespace Ranger {
+    //! Who allocated, as set by the innermost @see MemoryScope.
+    enum class MemoryTag : uint8_t {
+        GENERAL, ENGINE, RENDERING, SCENE, TIMING, JOBS, IO, INPUT, LOGGING, COUNT
+    };
+
+    struct AllocStats {
+        uint64_t allocations{0};
+        uint64_t frees{0};
+        //! Allocated in total.
+        uint64_t bytes{0};
+        //! Allocated and not yet freed.
+        int64_t live{0};
+    };
+
+    //! Heap allocation counters, when built with RANGER_TRACK_ALLOCATIONS.
+    /*!
+     * Every operator new/delete is counted process wide, per thread and
+     * per @see MemoryTag. Allocations made on a thread inside a
+     * @see NoAllocScope are violations: counted, remembered (tag and size)
+     * and, with [abortOnViolation], fatal so a debugger stops right on
+     * them.
+     *
+     * malloc from C libraries (GLFW, the GL driver, FreeType) isn't seen.
+     * Without the build option every query returns zeros.
+     */
+    class AllocTracker final {
+    public:
+        static constexpr bool ENABLED = RANGER_TRACK_ALLOCATIONS != 0;
+
+        static const char* tagName(MemoryTag tag);
+
+        static AllocStats total();
+
+        static AllocStats tag(MemoryTag tag);
+
+        //! The calling thread's.
+        static AllocStats thread();
+
+        //! Allocations made inside a NoAllocScope.
+        static uint64_t violations();
+
+        //! The most recent violation's.
+        static MemoryTag violationTag();
+
+        static size_t violationSize();
+
+        static void abortOnViolation(bool abort);
+
+    private:
+        friend class MemoryScope;
+        friend class NoAllocScope;
+
+        //! Returns the tag it replaces.
+        static MemoryTag _swapTag(MemoryTag tag);
+
+        static void _forbid(int delta);
+    };
+
+    //! Tags the calling thread's allocations while alive.
+    /*!
+     *   MemoryScope tag(MemoryTag::RENDERING);
+     */
+    class MemoryScope final {
+    public:
+        explicit MemoryScope(MemoryTag tag) {
+            if constexpr (AllocTracker::ENABLED)
+                _previous = AllocTracker::_swapTag(tag);
+        }
+
+        ~MemoryScope() {
+            if constexpr (AllocTracker::ENABLED)
+                AllocTracker::_swapTag(_previous);
+        }
+
+        MemoryScope(const MemoryScope&) = delete;
+        MemoryScope& operator=(const MemoryScope&) = delete;
+
+    private:
+        MemoryTag _previous{MemoryTag::GENERAL};
+    };
+
+    //! The calling thread shouldn't allocate while alive, if [active].
+    class NoAllocScope final {
+    public:
+        explicit NoAllocScope(bool active = true)
+                : _active(active && AllocTracker::ENABLED) {
+            if (_active)
+                AllocTracker::_forbid(1);
+        }
+
+        ~NoAllocScope() {
+            if (_active)
+                AllocTracker::_forbid(-1);
+        }
+
+        NoAllocScope(const NoAllocScope&) = delete;
+        NoAllocScope& operator=(const NoAllocScope&) = delete;
+
+    private:
+        bool _active;
+    };
+}
+
+#endif //RANGERALPHA_ALLOC_TRACKER_H
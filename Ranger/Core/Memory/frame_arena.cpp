@@ -0,0 +1,150 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#include "frame_arena.h"
+
+namespace Ranger {
+    namespace {
+        //! Buffers are cache line aligned.
+        constexpr size_t BUFFER_ALIGNMENT = 64;
+
+        std::atomic<size_t> g_capacity{FrameArena::DEFAULT_CAPACITY};
+        std::atomic<size_t> g_peak{0};
+        std::atomic<uint64_t> g_overflows{0};
+        std::atomic<uint64_t> g_overflowBytes{0};
+
+        //! Room for the Overflow link in front of a block of [alignment].
+        size_t linkRoom(size_t alignment) {
+            size_t room = sizeof(void*) * 2;
+            return (room + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    std::atomic<uint64_t> FrameArena::_frame{0};
+
+    FrameArena::FrameArena(size_t capacity)
+            : _capacity(capacity),
+              _synced(_frame.load(std::memory_order_relaxed)) {
+        for (Buffer& buffer : _buffers)
+            buffer.data = static_cast<char*>(::operator new(_capacity, std::align_val_t(BUFFER_ALIGNMENT)));
+    }
+
+    FrameArena::~FrameArena() {
+        for (Buffer& buffer : _buffers) {
+            _clear(buffer);
+            ::operator delete(buffer.data, std::align_val_t(BUFFER_ALIGNMENT));
+        }
+    }
+
+    void FrameArena::configure(size_t capacity) {
+        g_capacity.store(capacity, std::memory_order_relaxed);
+    }
+
+    FrameArena& FrameArena::local() {
+        thread_local FrameArena arena(g_capacity.load(std::memory_order_relaxed));
+        return arena;
+    }
+
+    void FrameArena::advance() {
+        _frame.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    FrameArena::Stats FrameArena::stats() {
+        return Stats{g_peak.load(std::memory_order_relaxed),
+                     g_overflows.load(std::memory_order_relaxed),
+                     g_overflowBytes.load(std::memory_order_relaxed)};
+    }
+
+    size_t FrameArena::takePeak() {
+        return g_peak.exchange(0, std::memory_order_relaxed);
+    }
+
+    std::string_view FrameArena::format(const char* format, ...) {
+        _sync();
+
+        va_list args;
+        va_start(args, format);
+        va_list again;
+        va_copy(again, args);
+
+        Buffer& buffer = _buffers[_current];
+        char* at = buffer.data + buffer.used;
+        size_t room = _capacity - buffer.used;
+        int length = std::vsnprintf(at, room, format, args);
+        va_end(args);
+
+        if (length >= 0 && size_t(length) < room) {
+            buffer.used += length + 1;
+        } else if (length >= 0) {
+            at = static_cast<char*>(_overflow(length + 1, 1));
+            std::vsnprintf(at, length + 1, format, again);
+        } else {
+            at = nullptr;
+            length = 0;
+        }
+        va_end(again);
+
+        return std::string_view(at, length);
+    }
+
+    std::string_view FrameArena::copy(std::string_view text) {
+        char* at = allocate<char>(text.size());
+        std::memcpy(at, text.data(), text.size());
+        return std::string_view(at, text.size());
+    }
+
+    void FrameArena::_swap() {
+        uint64_t frame = _frame.load(std::memory_order_relaxed);
+
+        // The frame that just ended is the only one this thread reports.
+        Buffer& ended = _buffers[_current];
+        size_t used = ended.used + ended.overflowBytes;
+        size_t peak = g_peak.load(std::memory_order_relaxed);
+        while (used > peak && !g_peak.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {}
+
+        // A thread that sat out a frame has nothing left worth keeping.
+        if (frame - _synced > 1)
+            _clear(ended);
+
+        _current ^= 1;
+        _clear(_buffers[_current]);
+        _synced = frame;
+    }
+
+    void* FrameArena::_overflow(size_t size, size_t alignment) {
+        alignment = alignment > alignof(Overflow) ? alignment : alignof(Overflow);
+        size_t room = linkRoom(alignment);
+        char* block = static_cast<char*>(::operator new(room + size, std::align_val_t(alignment)));
+
+        Buffer& buffer = _buffers[_current];
+        auto* link = reinterpret_cast<Overflow*>(block);
+        link->next = buffer.overflows;
+        link->alignment = alignment;
+        buffer.overflows = link;
+        buffer.overflowBytes += size;
+
+        g_overflows.fetch_add(1, std::memory_order_relaxed);
+        g_overflowBytes.fetch_add(size, std::memory_order_relaxed);
+
+        return block + room;
+    }
+
+    void FrameArena::_clear(Buffer& buffer) {
+        buffer.used = 0;
+        buffer.overflowBytes = 0;
+
+        Overflow* link = buffer.overflows;
+        while (link) {
+            Overflow* next = link->next;
+            ::operator delete(link, std::align_val_t(link->alignment));
+            link = next;
+        }
+        buffer.overflows = nullptr;
+    }
+}
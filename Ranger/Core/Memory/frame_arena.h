@@ -0,0 +1,176 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_FRAME_ARENA_H
+#define RANGERALPHA_FRAME_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Ranger {
+    //! A per thread bump allocator for data that only lives a frame or two.
+    /*!
+     * Each thread gets two buffers of [capacity] bytes, the current frame's
+     * and the previous one's. Allocating is a pointer bump, freeing is
+     * nothing: when the engine calls [advance] at the end of a frame, each
+     * thread's buffers swap on its next allocation and the one reused is
+     * cleared. What a thread allocated in frame N is valid until the end of
+     * frame N + 1, so it may be handed to the pipelined render of the next
+     * frame, but no longer.
+     *
+     * What doesn't fit in the current buffer comes from the heap, is freed
+     * with the buffer and is counted in [stats]; a capacity that overflows
+     * in steady state is too small.
+     *
+     *   FrameArena& arena = FrameArena::local();
+     *   std::string_view text = arena.format("fps: %d", fps);
+     */
+    class FrameArena final {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+        struct Stats {
+            //! The most any thread used in a frame, since [takePeak].
+            size_t peak{0};
+            //! Allocations that didn't fit, and their bytes.
+            uint64_t overflows{0};
+            uint64_t overflowBytes{0};
+        };
+
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        //! Bytes per buffer of the arenas created afterwards; set before
+        // any thread uses its arena.
+        static void configure(size_t capacity);
+
+        //! The calling thread's, created on first use.
+        static FrameArena& local();
+
+        //! Ends the frame for every thread's arena.
+        static void advance();
+
+        static uint64_t frame() {
+            return _frame.load(std::memory_order_relaxed);
+        }
+
+        static Stats stats();
+
+        //! Returns [Stats::peak] and starts over.
+        static size_t takePeak();
+
+        void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+            _sync();
+
+            Buffer& buffer = _buffers[_current];
+            uintptr_t base = reinterpret_cast<uintptr_t>(buffer.data);
+            uintptr_t at = (base + buffer.used + alignment - 1) & ~uintptr_t(alignment - 1);
+            if (at + size <= base + _capacity) {
+                buffer.used = at + size - base;
+                return reinterpret_cast<void*>(at);
+            }
+            return _overflow(size, alignment);
+        }
+
+        //! Uninitialized room for [count] Ts.
+        template<typename T>
+        T* allocate(size_t count) {
+            return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+        }
+
+        //! printf into the arena.
+        std::string_view format(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+        std::string_view copy(std::string_view text);
+
+        //! This frame's bytes, not counting overflows.
+        size_t used() const {
+            return _buffers[_current].used;
+        }
+
+        size_t capacity() const {
+            return _capacity;
+        }
+
+    private:
+        //! Heap blocks a buffer couldn't hold, chained in front of each.
+        struct Overflow {
+            Overflow* next;
+            size_t alignment;
+        };
+
+        struct Buffer {
+            char* data{nullptr};
+            size_t used{0};
+            size_t overflowBytes{0};
+            Overflow* overflows{nullptr};
+        };
+
+        explicit FrameArena(size_t capacity);
+
+        //! Swaps the buffers if frames ended since the last allocation.
+        void _sync() {
+            if (_frame.load(std::memory_order_relaxed) != _synced)
+                _swap();
+        }
+
+        void _swap();
+
+        void* _overflow(size_t size, size_t alignment);
+
+        static void _clear(Buffer& buffer);
+
+        static std::atomic<uint64_t> _frame;
+
+        size_t _capacity;
+        Buffer _buffers[2];
+        int _current{0};
+        uint64_t _synced;
+    };
+
+    //! Adapts the calling thread's @see FrameArena to STL containers.
+    /*!
+     * deallocate does nothing, so a container that grows leaves its old
+     * storage behind until the frame's buffer is reused; reserve up front.
+     * The container must not outlive the next frame.
+     */
+    template<typename T>
+    struct FrameAllocator {
+        using value_type = T;
+
+        FrameAllocator() noexcept = default;
+
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+        T* allocate(size_t count) {
+            return FrameArena::local().allocate<T>(count);
+        }
+
+        void deallocate(T*, size_t) noexcept {}
+
+        template<typename U>
+        bool operator==(const FrameAllocator<U>&) const noexcept {
+            return true;
+        }
+
+        template<typename U>
+        bool operator!=(const FrameAllocator<U>&) const noexcept {
+            return false;
+        }
+    };
+
+    template<typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+    using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+}
+
+#endif //RANGERALPHA_FRAME_ARENA_H
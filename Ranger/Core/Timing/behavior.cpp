@@ -0,0 +1,93 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <new>
+
+#include "behavior.h"
+
+namespace Ranger {
+    std::atomic_flag BehaviorFramePool::_lock = ATOMIC_FLAG_INIT;
+    BehaviorFramePool::FreeFrame* BehaviorFramePool::_free[BehaviorFramePool::CLASSES] = {};
+    std::vector<std::unique_ptr<unsigned char[]>> BehaviorFramePool::_chunks;
+    BehaviorFramePool::Stats BehaviorFramePool::_stats = {};
+
+    namespace {
+        struct SpinLock {
+            std::atomic_flag& flag;
+
+            explicit SpinLock(std::atomic_flag& f) : flag(f) {
+                while (flag.test_and_set(std::memory_order_acquire)) {
+                }
+            }
+
+            ~SpinLock() {
+                flag.clear(std::memory_order_release);
+            }
+        };
+    }
+
+    void* BehaviorFramePool::allocate(size_t size) {
+        if (size > MAX_FRAME) {
+            SpinLock lock(_lock);
+            _stats.allocations++;
+            _stats.heapFallbacks++;
+            _stats.framesInUse++;
+            return ::operator new(size);
+        }
+
+        size_t sizeClass = _classOf(size);
+
+        SpinLock lock(_lock);
+        if (_free[sizeClass] == nullptr)
+            _refill(sizeClass);
+
+        FreeFrame* frame = _free[sizeClass];
+        _free[sizeClass] = frame->next;
+
+        _stats.allocations++;
+        _stats.framesInUse++;
+        return frame;
+    }
+
+    void BehaviorFramePool::release(void* frame, size_t size) {
+        if (size > MAX_FRAME) {
+            ::operator delete(frame);
+            SpinLock lock(_lock);
+            _stats.framesInUse--;
+            return;
+        }
+
+        size_t sizeClass = _classOf(size);
+
+        SpinLock lock(_lock);
+        auto* free = static_cast<FreeFrame*>(frame);
+        free->next = _free[sizeClass];
+        _free[sizeClass] = free;
+        _stats.framesInUse--;
+    }
+
+    void BehaviorFramePool::_refill(size_t sizeClass) {
+        size_t frameSize = (sizeClass + 1) * GRANULARITY;
+        size_t bytes = frameSize * CHUNK_FRAMES;
+
+        // operator new[] for unsigned char is aligned for any fundamental
+        // type and frameSize is a multiple of 64, so every frame is too.
+        _chunks.emplace_back(new unsigned char[bytes]);
+        unsigned char* chunk = _chunks.back().get();
+
+        for (size_t i = CHUNK_FRAMES; i-- > 0;) {
+            auto* frame = reinterpret_cast<FreeFrame*>(chunk + i * frameSize);
+            frame->next = _free[sizeClass];
+            _free[sizeClass] = frame;
+        }
+
+        _stats.chunks++;
+        _stats.bytesReserved += bytes;
+    }
+
+    BehaviorFramePool::Stats BehaviorFramePool::stats() {
+        SpinLock lock(_lock);
+        return _stats;
+    }
+}
@@ -0,0 +1,288 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_BEHAVIOR_H
+#define RANGERALPHA_BEHAVIOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Ranger {
+    //! Recycles coroutine frames for @see Behavior(s).
+    /*!
+     * Frames are rounded up to GRANULARITY and served from per size free
+     * lists, refilled CHUNK_FRAMES at a time; frames larger than MAX_FRAME
+     * fall back to the heap. Chunks are never returned, so once a game has
+     * reached its peak number of behaviors spawning more doesn't allocate.
+     *
+     * A spin lock makes it safe to spawn on one thread and finish on the
+     * Scheduler's thread.
+     */
+    class BehaviorFramePool final {
+    public:
+        static constexpr size_t GRANULARITY = 64;
+        static constexpr size_t MAX_FRAME = 1024;
+        static constexpr size_t CHUNK_FRAMES = 64;
+
+        struct Stats {
+            uint64_t allocations;
+            //! Allocations that didn't fit and went to the heap.
+            uint64_t heapFallbacks;
+            uint64_t chunks;
+            size_t bytesReserved;
+            size_t framesInUse;
+        };
+
+        static void* allocate(size_t size);
+        static void release(void* frame, size_t size);
+
+        static Stats stats();
+
+    private:
+        static constexpr size_t CLASSES = MAX_FRAME / GRANULARITY;
+
+        struct FreeFrame {
+            FreeFrame* next;
+        };
+
+        static size_t _classOf(size_t size) {
+            return (size + GRANULARITY - 1) / GRANULARITY - 1;
+        }
+
+        static void _refill(size_t sizeClass);
+
+        static std::atomic_flag _lock;
+        static FreeFrame* _free[CLASSES];
+        static std::vector<std::unique_ptr<unsigned char[]>> _chunks;
+        static Stats _stats;
+    };
+
+    //! What a suspended @see Behavior waits for. Set by the awaitables
+    // below and read by the @see Scheduler.
+    struct BehaviorWait {
+        enum Kind : uint8_t {
+            //! Resume on the next update.
+            FRAME,
+            //! Resume once [delay] milliseconds have passed.
+            TIME,
+            //! Resume once [poll] returns true; it is called every update.
+            POLL
+        };
+
+        Kind kind{FRAME};
+        double delay{0.0};
+        bool (*poll)(void* awaiter, double dt){nullptr};
+        void* awaiter{nullptr};
+    };
+
+    //! A coroutine scripting behavior over time, run by the @see Scheduler.
+    /*!
+     * Instead of a state machine in an @see UpdateTarget:
+     *
+     *   Behavior patrol(BaseNode& guard) {
+     *       while (true) {
+     *           co_await tween(1000.0, [&](float t) { guard.px(t * 100.0f); });
+     *           co_await seconds(2);
+     *           co_await tween(1000.0, [&](float t) { guard.px(100.0f - t * 100.0f); });
+     *           co_await nextFrame();
+     *       }
+     *   }
+     *
+     *   ScheduleHandle h = scheduler.startBehavior(patrol(*guard));
+     *
+     * A Behavior does nothing until started; it then runs on the Scheduler's
+     * next update, up to its first co_await. Awaiting time costs nothing
+     * until it elapses (the Scheduler parks it in a @see TimingWheel), while
+     * awaiting a frame, a tween or a condition costs one resume or poll per
+     * update. Time follows the Scheduler's (scaled) dt.
+     *
+     * Whatever a Behavior references must outlive it; stop it with
+     * @see Scheduler::stopBehavior first. An exception escaping a Behavior
+     * ends it and propagates out of @see Scheduler::update.
+     */
+    class Behavior final {
+    public:
+        struct promise_type {
+            BehaviorWait wait;
+
+            Behavior get_return_object() {
+                return Behavior{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            void return_void() {}
+
+            void unhandled_exception() {
+                throw;
+            }
+
+            static void* operator new(size_t size) {
+                return BehaviorFramePool::allocate(size);
+            }
+
+            static void operator delete(void* frame, size_t size) {
+                BehaviorFramePool::release(frame, size);
+            }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Behavior() = default;
+
+        Behavior(Behavior&& other) noexcept
+                : _coroutine(std::exchange(other._coroutine, nullptr)) {
+        }
+
+        Behavior& operator=(Behavior&& other) noexcept {
+            if (this != &other) {
+                if (_coroutine)
+                    _coroutine.destroy();
+                _coroutine = std::exchange(other._coroutine, nullptr);
+            }
+            return *this;
+        }
+
+        Behavior(const Behavior&) = delete;
+        Behavior& operator=(const Behavior&) = delete;
+
+        //! An unstarted Behavior is simply discarded.
+        ~Behavior() {
+            if (_coroutine)
+                _coroutine.destroy();
+        }
+
+        bool valid() const {
+            return static_cast<bool>(_coroutine);
+        }
+
+        //! Hands the coroutine over; used by the Scheduler.
+        Handle release() {
+            return std::exchange(_coroutine, nullptr);
+        }
+
+    private:
+        explicit Behavior(Handle coroutine) : _coroutine(coroutine) {}
+
+        Handle _coroutine{nullptr};
+    };
+
+    // ##########################################################################
+    // Awaitables
+    // ##########################################################################
+    namespace Behaviors {
+        //! Suspends until the Scheduler's next update.
+        struct NextFrame {
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(Behavior::Handle coroutine) const noexcept {
+                coroutine.promise().wait = BehaviorWait{BehaviorWait::FRAME};
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        //! Suspends for [delay] milliseconds of Scheduler time.
+        struct Delay {
+            double delay;
+
+            bool await_ready() const noexcept { return delay <= 0.0; }
+
+            void await_suspend(Behavior::Handle coroutine) const noexcept {
+                coroutine.promise().wait = BehaviorWait{BehaviorWait::TIME, delay};
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        //! Suspends until [condition()] is true, checked every update.
+        template<typename Condition>
+        struct Until {
+            Condition condition;
+
+            bool await_ready() { return condition(); }
+
+            void await_suspend(Behavior::Handle coroutine) {
+                coroutine.promise().wait = BehaviorWait{BehaviorWait::POLL, 0.0, &_poll, this};
+            }
+
+            void await_resume() const noexcept {}
+
+            static bool _poll(void* awaiter, double) {
+                return static_cast<Until*>(awaiter)->condition();
+            }
+        };
+
+        //! Calls [apply(t)] every update with t going from 0 to 1 over
+        // [duration] milliseconds, eased by [ease].
+        template<typename Apply>
+        struct Tween {
+            double duration;
+            Apply apply;
+            float (*ease)(float);
+            double elapsed{0.0};
+
+            bool await_ready() {
+                if (duration > 0.0)
+                    return false;
+                apply(1.0f);
+                return true;
+            }
+
+            void await_suspend(Behavior::Handle coroutine) {
+                apply(ease ? ease(0.0f) : 0.0f);
+                coroutine.promise().wait = BehaviorWait{BehaviorWait::POLL, 0.0, &_poll, this};
+            }
+
+            void await_resume() const noexcept {}
+
+            static bool _poll(void* awaiter, double dt) {
+                auto* tween = static_cast<Tween*>(awaiter);
+                tween->elapsed += dt;
+                auto t = static_cast<float>(std::min(tween->elapsed / tween->duration, 1.0));
+                tween->apply(tween->ease ? tween->ease(t) : t);
+                return t >= 1.0f;
+            }
+        };
+    }
+
+    inline Behaviors::NextFrame nextFrame() {
+        return {};
+    }
+
+    inline Behaviors::Delay milliseconds(double ms) {
+        return {ms};
+    }
+
+    inline Behaviors::Delay seconds(double s) {
+        return {s * 1000.0};
+    }
+
+    template<typename Condition>
+    Behaviors::Until<Condition> until(Condition condition) {
+        return {std::move(condition)};
+    }
+
+    //! \param ease nullptr = linear, otherwise maps [0, 1] onto [0, 1].
+    template<typename Apply>
+    Behaviors::Tween<Apply> tween(double duration, Apply apply, float (*ease)(float) = nullptr) {
+        return {duration, std::move(apply), ease};
+    }
+
+    //! Moves [value] from its current value to [to].
+    inline auto tween(float& value, float to, double duration, float (*ease)(float) = nullptr) {
+        float from = value;
+        return tween(duration, [&value, from, to](float t) { value = from + (to - from) * t; }, ease);
+    }
+}
+
+#endif //RANGERALPHA_BEHAVIOR_H
@@ -0,0 +1,114 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define RANGER_TSC 1
+#endif
+
+#include "clock.h"
+
+namespace Ranger {
+    double Clock::_nsPerCycle = 0.0;
+
+    namespace {
+        using Steady = std::chrono::steady_clock;
+
+        Steady::time_point epoch() {
+            static const Steady::time_point start = Steady::now();
+            return start;
+        }
+    }
+
+    Clock::Ticks Clock::now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Steady::now() - epoch()).count();
+    }
+
+    Clock::Ticks Clock::fromMilliseconds(double ms) {
+        return static_cast<Ticks>(std::llround(ms * static_cast<double>(NS_PER_MS)));
+    }
+
+    uint64_t Clock::cycles() {
+#if defined(RANGER_TSC)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t count;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(count));
+        return count;
+#else
+        return static_cast<uint64_t>(now());
+#endif
+    }
+
+    void Clock::calibrate(double duration) {
+        Ticks span = fromMilliseconds(duration);
+
+        Ticks start = now();
+        uint64_t startCycles = cycles();
+
+        Ticks end;
+        do {
+            end = now();
+        } while (end - start < span);
+
+        uint64_t elapsed = cycles() - startCycles;
+        if (elapsed == 0) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " The cycle counter didn't advance.";
+            throw std::logic_error(ss.str());
+        }
+
+        _nsPerCycle = static_cast<double>(end - start) / static_cast<double>(elapsed);
+    }
+
+    double Clock::nanosecondsPerCycle() {
+        if (_nsPerCycle == 0.0)
+            calibrate();
+        return _nsPerCycle;
+    }
+
+    // ##########################################################################
+    // FrameClock
+    // ##########################################################################
+    void FrameClock::advance(Clock::Ticks now) {
+        // The first tick only establishes a starting point.
+        _realDelta = _last < 0 ? 0 : now - _last;
+        _last = now;
+        _frame++;
+
+        if (_paused) {
+            _delta = 0;
+            return;
+        }
+
+        if (_timeScale == 1.0) {
+            _delta = _realDelta;
+        }
+        else {
+            double scaled = static_cast<double>(_realDelta) * _timeScale + _scaleRemainder;
+            _delta = static_cast<Clock::Ticks>(scaled);
+            _scaleRemainder = scaled - static_cast<double>(_delta);
+        }
+
+        _time += _delta;
+    }
+
+    void FrameClock::timeScale(double scale) {
+        if (scale < 0.0) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " Time scale can't be negative: " << scale;
+            throw std::invalid_argument(ss.str());
+        }
+        _timeScale = scale;
+    }
+}
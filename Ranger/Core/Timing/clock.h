@@ -0,0 +1,185 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_CLOCK_H
+#define RANGERALPHA_CLOCK_H
+
+#include <cstdint>
+
+namespace Ranger {
+    //! Monotonic time in integer nanoseconds.
+    /*!
+     * Backed by std::chrono::steady_clock (CLOCK_MONOTONIC on Linux) and
+     * measured from the first use, so it needs no window or GL context;
+     * headless tools and tests can use it as is.
+     *
+     * For profiling there is also a cycle counter (the TSC on x86) which is
+     * several times cheaper to read than [now]. Cycles are converted to
+     * nanoseconds using a rate measured by [calibrate].
+     */
+    class Clock final {
+    public:
+        using Ticks = int64_t;
+
+        static constexpr Ticks NS_PER_MS = 1000000;
+        static constexpr Ticks NS_PER_SECOND = 1000000000;
+
+        //! Nanoseconds since the Clock was first used.
+        static Ticks now();
+
+        //! [now] in seconds. A drop in for glfwGetTime().
+        static double seconds() {
+            return toSeconds(now());
+        }
+
+        static constexpr double toMilliseconds(Ticks ticks) {
+            return static_cast<double>(ticks) / static_cast<double>(NS_PER_MS);
+        }
+
+        static constexpr double toSeconds(Ticks ticks) {
+            return static_cast<double>(ticks) / static_cast<double>(NS_PER_SECOND);
+        }
+
+        static Ticks fromMilliseconds(double ms);
+
+        // ------------------------------------------------------------------
+        // Profiling
+        // ------------------------------------------------------------------
+        //! A raw cycle count. Falls back to [now] where there is no usable
+        // counter, in which case a cycle is a nanosecond.
+        static uint64_t cycles();
+
+        //! Measures the cycle rate against [now] over [duration] ms.
+        /*!
+         * Called once at startup (the Engine does); [cyclesToNanoseconds]
+         * calibrates itself, over 10 ms, on first use otherwise.
+         */
+        static void calibrate(double duration = 10.0);
+
+        static double nanosecondsPerCycle();
+
+        static Ticks cyclesToNanoseconds(uint64_t cycles) {
+            return static_cast<Ticks>(static_cast<double>(cycles) * nanosecondsPerCycle());
+        }
+
+    private:
+        static double _nsPerCycle;
+    };
+
+    //! Accumulates the cycles spent in a profiling zone.
+    struct ZoneStats {
+        uint64_t cycles{0};
+        uint64_t count{0};
+
+        double milliseconds() const {
+            return Clock::toMilliseconds(Clock::cyclesToNanoseconds(cycles));
+        }
+
+        void reset() {
+            cycles = 0;
+            count = 0;
+        }
+    };
+
+    //! Adds the cycles between construction and destruction to [stats].
+    /*!
+     *   static ZoneStats physics;
+     *   {
+     *       ProfileZone zone(physics);
+     *       ...
+     *   }
+     */
+    class ProfileZone final {
+    public:
+        explicit ProfileZone(ZoneStats& stats)
+                : _stats(stats), _start(Clock::cycles()) {
+        }
+
+        ~ProfileZone() {
+            _stats.cycles += Clock::cycles() - _start;
+            _stats.count++;
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        ZoneStats& _stats;
+        uint64_t _start;
+    };
+
+    //! Game time: real time that can be paused and scaled.
+    /*!
+     * Ticked once per frame; [delta] is what the simulation should advance
+     * by. Time scale < 1.0 gives slow motion, > 1.0 hyper motion; while paused
+     * [delta] is 0 and rendering keeps going. Scaling is done in integer
+     * nanoseconds with the rounding remainder carried over, so game time
+     * doesn't drift from real time * scale.
+     */
+    class FrameClock final {
+    public:
+        //! Advances by the real time passed since the previous [tick].
+        void tick() {
+            advance(Clock::now());
+        }
+
+        //! Advances to real time [now]; for tests and replays.
+        void advance(Clock::Ticks now);
+
+        void pause() {
+            _paused = true;
+        }
+
+        void resume() {
+            _paused = false;
+        }
+
+        bool isPaused() const {
+            return _paused;
+        }
+
+        void timeScale(double scale);
+
+        double timeScale() const {
+            return _timeScale;
+        }
+
+        //! Real time of the last frame.
+        Clock::Ticks realDelta() const {
+            return _realDelta;
+        }
+
+        //! Scaled game time of the last frame; 0 while paused.
+        Clock::Ticks delta() const {
+            return _delta;
+        }
+
+        double deltaMilliseconds() const {
+            return Clock::toMilliseconds(_delta);
+        }
+
+        //! Total game time.
+        Clock::Ticks time() const {
+            return _time;
+        }
+
+        uint64_t frame() const {
+            return _frame;
+        }
+
+    private:
+        Clock::Ticks _last{-1};
+        Clock::Ticks _realDelta{0};
+        Clock::Ticks _delta{0};
+        Clock::Ticks _time{0};
+        uint64_t _frame{0};
+
+        bool _paused{false};
+        double _timeScale{1.0};
+        //! Scaled nanoseconds not yet handed out.
+        double _scaleRemainder{0.0};
+    };
+}
+
+#endif //RANGERALPHA_CLOCK_H
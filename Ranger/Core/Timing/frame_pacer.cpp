@@ -0,0 +1,208 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "frame_pacer.h"
+
+namespace Ranger {
+    namespace {
+        //! A single preempted sleep shouldn't turn into seconds of spinning.
+        constexpr Clock::Ticks MAX_OVERSLEEP = 4 * Clock::NS_PER_MS;
+
+        //! Jumps up to a larger [sample], otherwise decays towards it by 1/16.
+        Clock::Ticks smooth(Clock::Ticks estimate, Clock::Ticks sample) {
+            if (sample >= estimate)
+                return sample;
+            return estimate - (estimate - sample) / 16;
+        }
+
+        Clock::Ticks periodOf(double fps) {
+            return fps > 0.0 ? static_cast<Clock::Ticks>(std::llround(1.0e9 / fps)) : 0;
+        }
+    }
+
+    double FramePacer::Stats::stddev() const {
+        return std::sqrt(variance);
+    }
+
+    FramePacer::Mode FramePacer::parseMode(const std::string& name) {
+        if (name.empty() || name == "Off")
+            return Mode::OFF;
+        if (name == "Limit")
+            return Mode::LIMIT;
+        if (name == "Adaptive")
+            return Mode::ADAPTIVE;
+
+        std::stringstream ss;
+        ss << __FILE__ << "::" << __FUNCTION__ << " Unknown frame limiter: '" << name
+           << "', expected Off, Limit or Adaptive.";
+        throw std::invalid_argument(ss.str());
+    }
+
+    const char* FramePacer::modeName(Mode mode) {
+        switch (mode) {
+            case Mode::LIMIT:
+                return "Limit";
+            case Mode::ADAPTIVE:
+                return "Adaptive";
+            default:
+                return "Off";
+        }
+    }
+
+    void FramePacer::configure(Mode mode, double targetFps, double idleFps, double spinMargin) {
+        if (mode != Mode::OFF && targetFps <= 0.0) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " " << modeName(mode)
+               << " needs a target FPS > 0, not: " << targetFps;
+            throw std::invalid_argument(ss.str());
+        }
+
+        _mode = mode;
+        _targetPeriod = periodOf(targetFps);
+        _idlePeriod = periodOf(idleFps);
+        _spinMargin = Clock::fromMilliseconds(std::max(spinMargin, 0.0));
+
+        _deadline = -1;
+        _frameStart = -1;
+        _rendered = -1;
+        _lastPresent = -1;
+        _cost = 0;
+        _oversleep = 0;
+        resetStats();
+    }
+
+    void FramePacer::wait() {
+        Clock::Ticks now = Clock::now();
+
+        if (isIdle()) {
+            // Low power: no spinning, and resync when focus comes back.
+            if (_frameStart >= 0)
+                _waitUntil(_frameStart + _idlePeriod, false);
+            _frameStart = Clock::now();
+            _deadline = -1;
+            return;
+        }
+
+        switch (_mode) {
+            case Mode::LIMIT:
+                // A frame or more behind: start now rather than burst to
+                // catch up.
+                if (_deadline < 0 || now - _deadline > _targetPeriod)
+                    _deadline = now;
+                _waitUntil(_deadline, true);
+                _deadline += _targetPeriod;
+                break;
+            case Mode::ADAPTIVE:
+                // Wake just soon enough to poll, update and render by the
+                // present deadline.
+                if (_deadline >= 0)
+                    _waitUntil(_deadline - _cost - _spinMargin, true);
+                break;
+            default:
+                break;
+        }
+
+        _frameStart = Clock::now();
+    }
+
+    void FramePacer::presented() {
+        Clock::Ticks now = Clock::now();
+
+        if (_frameStart >= 0 && !isIdle()) {
+            Clock::Ticks end = _rendered >= _frameStart ? _rendered : now;
+            _cost = smooth(_cost, end - _frameStart);
+        }
+
+        if (_lastPresent >= 0) {
+            bool late = _record(now - _lastPresent);
+            // Woke too close to the present; wake earlier from now on.
+            if (late && _mode == Mode::ADAPTIVE)
+                _cost += _spinMargin;
+        }
+        _lastPresent = now;
+
+        if (_mode == Mode::ADAPTIVE && !isIdle()) {
+            if (_deadline < 0) {
+                _deadline = now + _targetPeriod;
+            }
+            else {
+                _deadline += _targetPeriod;
+                // Missed: keep the phase, skip to the next slot.
+                if (_deadline <= now)
+                    _deadline = now + _targetPeriod - (now - _deadline) % _targetPeriod;
+            }
+        }
+    }
+
+    void FramePacer::resetStats() {
+        _stats = Stats{};
+        _slept = 0;
+        _spun = 0;
+    }
+
+    void FramePacer::_waitUntil(Clock::Ticks deadline, bool spin) {
+        Clock::Ticks start = Clock::now();
+        if (deadline <= start)
+            return;
+
+        Clock::Ticks wakeBy = spin ? deadline - _spinMargin - _oversleep : deadline;
+        if (wakeBy > start) {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(wakeBy - start));
+            Clock::Ticks woke = Clock::now();
+            _oversleep = smooth(_oversleep, std::clamp(woke - wakeBy, Clock::Ticks(0), MAX_OVERSLEEP));
+            _slept += woke - start;
+            start = woke;
+        }
+
+        if (!spin)
+            return;
+
+        // Yielding lets the simulation thread, or anyone else, have the
+        // core for the last stretch.
+        Clock::Ticks now = start;
+        while (now < deadline) {
+            std::this_thread::yield();
+            now = Clock::now();
+        }
+        _spun += now - start;
+    }
+
+    Clock::Ticks FramePacer::_period() const {
+        return isIdle() ? _idlePeriod : _targetPeriod;
+    }
+
+    bool FramePacer::_record(Clock::Ticks interval) {
+        double ms = Clock::toMilliseconds(interval);
+        Stats& s = _stats;
+
+        s.frames++;
+        if (s.frames == 1) {
+            s.min = s.max = ms;
+        }
+        else {
+            s.min = std::min(s.min, ms);
+            s.max = std::max(s.max, ms);
+        }
+
+        // Welford, recovering the sum of squares from the population variance.
+        double delta = ms - s.mean;
+        s.mean += delta / double(s.frames);
+        double m2 = s.variance * double(s.frames - 1) + delta * (ms - s.mean);
+        s.variance = m2 / double(s.frames);
+
+        Clock::Ticks period = _period();
+        if (period > 0 && interval * 2 > period * 3) {
+            s.late++;
+            return true;
+        }
+        return false;
+    }
+}
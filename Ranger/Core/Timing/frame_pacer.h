@@ -0,0 +1,136 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_FRAME_PACER_H
+#define RANGERALPHA_FRAME_PACER_H
+
+#include <cstdint>
+#include <string>
+
+#include "clock.h"
+
+namespace Ranger {
+    //! Paces the Engine loop when vsync doesn't (or isn't wanted to).
+    /*!
+     * The loop calls [wait] before polling input and [presented] right after
+     * the swap.
+     *
+     * LIMIT starts a frame every 1/targetFps seconds. ADAPTIVE instead aims
+     * the *present* at every 1/targetFps seconds and wakes only as long
+     * before it as a frame has recently taken (poll to swap), so input is
+     * sampled as late as possible. OFF leaves pacing to vsync.
+     *
+     * Waiting sleeps until [spinMargin] (plus how much sleeps have recently
+     * overshot) before the deadline and spins the rest, which is accurate to
+     * a few microseconds without burning a core.
+     *
+     * While the window is unfocused, and [idleFps] > 0, every mode drops to
+     * [idleFps] using plain sleeps.
+     */
+    class FramePacer final {
+    public:
+        enum class Mode {
+            OFF, LIMIT, ADAPTIVE
+        };
+
+        //! Present to present intervals since [resetStats], in ms.
+        struct Stats {
+            uint64_t frames{0};
+            double mean{0.0};
+            double variance{0.0};
+            double min{0.0};
+            double max{0.0};
+            //! Intervals over 1.5 periods.
+            uint64_t late{0};
+
+            double stddev() const;
+        };
+
+        //! "Off", "Limit" or "Adaptive"; throws on anything else.
+        static Mode parseMode(const std::string& name);
+
+        static const char* modeName(Mode mode);
+
+        void configure(Mode mode, double targetFps, double idleFps = 10.0, double spinMargin = 1.0);
+
+        //! Called once a frame, before [wait].
+        void focused(bool focused) {
+            _focused = focused;
+        }
+
+        //! Blocks until the next frame should start.
+        void wait();
+
+        //! Marks the end of the frame's work, so time blocked in a vsync'd
+        // swap isn't counted as frame cost.
+        void rendered() {
+            _rendered = Clock::now();
+        }
+
+        //! Called when the frame has been swapped (or skipped).
+        void presented();
+
+        Mode mode() const {
+            return _mode;
+        }
+
+        bool isIdle() const {
+            return !_focused && _idlePeriod > 0;
+        }
+
+        //! The current estimate of a frame's poll to swap time, in ms.
+        double frameCost() const {
+            return Clock::toMilliseconds(_cost);
+        }
+
+        //! Ms spent sleeping and spinning since [resetStats].
+        double sleptMilliseconds() const {
+            return Clock::toMilliseconds(_slept);
+        }
+
+        double spunMilliseconds() const {
+            return Clock::toMilliseconds(_spun);
+        }
+
+        const Stats& stats() const {
+            return _stats;
+        }
+
+        void resetStats();
+
+    private:
+        //! Sleeps, then spins if [spin], until [deadline].
+        void _waitUntil(Clock::Ticks deadline, bool spin);
+
+        Clock::Ticks _period() const;
+
+        //! True if [interval] was late.
+        bool _record(Clock::Ticks interval);
+
+        Mode _mode{Mode::OFF};
+        Clock::Ticks _targetPeriod{0};
+        Clock::Ticks _idlePeriod{0};
+        Clock::Ticks _spinMargin{Clock::NS_PER_MS};
+
+        bool _focused{true};
+
+        //! LIMIT: when the next frame starts. ADAPTIVE: when it presents.
+        Clock::Ticks _deadline{-1};
+        Clock::Ticks _frameStart{-1};
+        Clock::Ticks _rendered{-1};
+        Clock::Ticks _lastPresent{-1};
+
+        //! Frame cost; rises at once with a slow frame and decays slowly.
+        Clock::Ticks _cost{0};
+        //! How late sleeps have been waking up, same smoothing.
+        Clock::Ticks _oversleep{0};
+
+        Clock::Ticks _slept{0};
+        Clock::Ticks _spun{0};
+
+        Stats _stats;
+    };
+}
+
+#endif //RANGERALPHA_FRAME_PACER_H
@@ -0,0 +1,162 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "frame_stats.h"
+
+namespace Ranger {
+    namespace {
+        const char* PHASE_NAMES[] = {"update", "render", "swap", "total"};
+
+        double toMilliseconds(int64_t micros) {
+            return static_cast<double>(micros) / 1000.0;
+        }
+    }
+
+    const char* FrameStats::phaseName(Phase phase) {
+        return PHASE_NAMES[phase];
+    }
+
+    void FrameStats::configure(double budget, double window) {
+        if (budget <= 0.0 || window <= 0.0) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " Budget (" << budget << " ms) and window ("
+               << window << " s) must be > 0";
+            throw std::invalid_argument(ss.str());
+        }
+
+        _budget = budget;
+        _slicePeriod = window * 1000.0 / SLICES;
+        reset();
+    }
+
+    void FrameStats::record(double update, double render, double swap, double total) {
+        const double times[PHASES] = {update, render, swap, total};
+
+        for (int phase = 0; phase < PHASES; phase++) {
+            int64_t micros = _micros(times[phase]);
+            _slices[_slice][phase].record(micros);
+            _window[phase].record(micros);
+            _overall[phase].record(micros);
+            if (times[phase] > _budget) {
+                _sliceHitches[_slice][phase]++;
+                _windowHitches[phase]++;
+                _hitches[phase]++;
+            }
+        }
+
+        _sliceFilled += total;
+        if (_sliceFilled >= _slicePeriod)
+            _rotate();
+    }
+
+    FrameStats::Summary FrameStats::overall(Phase phase) const {
+        return _summarize(_overall[phase], _hitches[phase], _overall[phase].max());
+    }
+
+    void FrameStats::reset() {
+        for (int phase = 0; phase < PHASES; phase++) {
+            for (auto& slice : _slices)
+                slice[phase].clear();
+            for (auto& hitches : _sliceHitches)
+                hitches[phase] = 0;
+            _window[phase].clear();
+            _windowHitches[phase] = 0;
+            _overall[phase].clear();
+            _hitches[phase] = 0;
+            _recent[phase] = Summary{};
+        }
+        _slice = 0;
+        _sliceFilled = 0.0;
+    }
+
+    void FrameStats::_rotate() {
+        for (int phase = 0; phase < PHASES; phase++) {
+            // The window's max can't survive subtraction; the slices' can.
+            int64_t max = 0;
+            for (auto& slice : _slices)
+                max = std::max(max, slice[phase].max());
+            _recent[phase] = _summarize(_window[phase], _windowHitches[phase], max);
+        }
+
+        // The oldest slice leaves the window and becomes the current one.
+        _slice = (_slice + 1) % SLICES;
+        for (int phase = 0; phase < PHASES; phase++) {
+            _window[phase].subtract(_slices[_slice][phase]);
+            _windowHitches[phase] -= _sliceHitches[_slice][phase];
+            _slices[_slice][phase].clear();
+            _sliceHitches[_slice][phase] = 0;
+        }
+        _sliceFilled = 0.0;
+    }
+
+    FrameStats::Summary FrameStats::_summarize(const Histogram& histogram, uint64_t hitches, int64_t max) {
+        static constexpr double FRACTIONS[] = {0.50, 0.90, 0.99, 0.999};
+        int64_t values[4];
+        histogram.percentiles(FRACTIONS, values, 4);
+
+        Summary summary;
+        summary.frames = histogram.count();
+        summary.mean = histogram.mean() / 1000.0;
+        summary.p50 = toMilliseconds(std::min(values[0], max));
+        summary.p90 = toMilliseconds(std::min(values[1], max));
+        summary.p99 = toMilliseconds(std::min(values[2], max));
+        summary.p999 = toMilliseconds(std::min(values[3], max));
+        summary.max = toMilliseconds(max);
+        summary.hitches = hitches;
+        return summary;
+    }
+
+    void FrameStats::writeJson(std::ostream& os) const {
+        const Histogram& total = _overall[TOTAL];
+        os << "{\n"
+           << "  \"frames\": " << total.count() << ",\n"
+           << "  \"seconds\": " << total.mean() * double(total.count()) / 1000000.0 << ",\n"
+           << "  \"budget\": " << _budget << ",\n"
+           << "  \"phases\": {";
+
+        for (int phase = 0; phase < PHASES; phase++) {
+            Summary summary = overall(static_cast<Phase>(phase));
+            os << (phase > 0 ? "," : "") << "\n"
+               << "    \"" << PHASE_NAMES[phase] << "\": {\n"
+               << "      \"mean\": " << summary.mean << ",\n"
+               << "      \"p50\": " << summary.p50 << ",\n"
+               << "      \"p90\": " << summary.p90 << ",\n"
+               << "      \"p99\": " << summary.p99 << ",\n"
+               << "      \"p99.9\": " << summary.p999 << ",\n"
+               << "      \"max\": " << summary.max << ",\n"
+               << "      \"hitches\": " << summary.hitches << ",\n"
+               << "      \"histogram\": [";
+
+            // [upper bound ms, count] pairs.
+            const Histogram& histogram = _overall[phase];
+            bool first = true;
+            for (int bucket = 0; bucket < Histogram::BUCKETS; bucket++) {
+                uint32_t count = histogram.bucketCount(bucket);
+                if (count == 0)
+                    continue;
+                os << (first ? "" : ", ") << "[" << toMilliseconds(Histogram::upperBound(bucket)) << ", " << count << "]";
+                first = false;
+            }
+            os << "]\n"
+               << "    }";
+        }
+
+        os << "\n  }\n"
+           << "}\n";
+    }
+
+    bool FrameStats::writeJson(const std::string& path) const {
+        std::ofstream file(path);
+        if (!file)
+            return false;
+
+        writeJson(file);
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,115 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_FRAME_STATS_H
+#define RANGERALPHA_FRAME_STATS_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+#include "histogram.h"
+
+namespace Ranger {
+    //! Every frame's update, render, swap and total time, as histograms.
+    /*!
+     * Averages hide hitches; percentiles don't. Each phase is recorded into
+     * a @see Histogram for the whole run and into a ring of slices that
+     * together cover the last [window] seconds, plus their running sum.
+     * When a slice fills, the oldest is subtracted from the sum and the
+     * recent summaries are recomputed from it, so reading them (every
+     * frame, for the overlay) is free and they are at most one slice old.
+     *
+     * Slices are filled by recorded frame time, not wall time, so a paused
+     * or replayed run slices the same way.
+     *
+     * A frame whose phase took longer than [budget] counts as a hitch of
+     * that phase; TOTAL hitches are the dropped frames.
+     */
+    class FrameStats final {
+    public:
+        enum Phase {
+            UPDATE, RENDER, SWAP, TOTAL, PHASES
+        };
+
+        static constexpr int SLICES = 10;
+
+        //! In milliseconds.
+        struct Summary {
+            uint64_t frames{0};
+            double mean{0.0};
+            double p50{0.0};
+            double p90{0.0};
+            double p99{0.0};
+            double p999{0.0};
+            double max{0.0};
+            uint64_t hitches{0};
+        };
+
+        static const char* phaseName(Phase phase);
+
+        //! [budget] in ms, [window] in seconds. Clears everything.
+        void configure(double budget, double window = 10.0);
+
+        //! One frame's times in ms.
+        void record(double update, double render, double swap, double total);
+
+        //! Over the last [window], as of the last slice boundary.
+        const Summary& recent(Phase phase) const {
+            return _recent[phase];
+        }
+
+        //! Over the whole run; walks the histogram, so not every frame.
+        Summary overall(Phase phase) const;
+
+        const Histogram& histogram(Phase phase) const {
+            return _overall[phase];
+        }
+
+        uint64_t frames() const {
+            return _overall[TOTAL].count();
+        }
+
+        double budget() const {
+            return _budget;
+        }
+
+        void reset();
+
+        //! The [overall] summaries and non empty buckets of every phase.
+        void writeJson(std::ostream& os) const;
+
+        //! False if [path] can't be written.
+        bool writeJson(const std::string& path) const;
+
+    private:
+        void _rotate();
+
+        static Summary _summarize(const Histogram& histogram, uint64_t hitches, int64_t max);
+
+        static int64_t _micros(double ms) {
+            return static_cast<int64_t>(ms * 1000.0 + 0.5);
+        }
+
+        double _budget{1.5 * 1000.0 / 60.0};
+        //! Frame time each slice covers, in ms.
+        double _slicePeriod{1000.0};
+        double _sliceFilled{0.0};
+        int _slice{0};
+
+        Histogram _slices[SLICES][PHASES];
+        uint64_t _sliceHitches[SLICES][PHASES]{};
+
+        Histogram _overall[PHASES];
+        uint64_t _hitches[PHASES]{};
+
+        //! The sum of the slices.
+        Histogram _window[PHASES];
+        uint64_t _windowHitches[PHASES]{};
+
+        Summary _recent[PHASES];
+    };
+}
+
+#endif //RANGERALPHA_FRAME_STATS_H
@@ -0,0 +1,162 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_HISTOGRAM_H
+#define RANGERALPHA_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace Ranger {
+    //! A fixed size, HDR style, histogram of microsecond values.
+    /*!
+     * Values below 128 us get a bucket each; above that every power of two
+     * range is split into 64 linear buckets, so any recorded value is known
+     * to within 1/64 (~1.6%) from 1 us up to ~67 s. Larger values are
+     * clamped. Recording is an increment; no allocation ever, and two
+     * histograms merge by adding counts.
+     *
+     * Percentiles report the upper bound of the bucket they fall in, so
+     * they never understate; [max] is exact.
+     */
+    class Histogram final {
+    public:
+        static constexpr int SUB_BITS = 7;
+        static constexpr int SUB_COUNT = 1 << SUB_BITS;
+        static constexpr int HALF_COUNT = SUB_COUNT / 2;
+        //! Powers of two above the first SUB_COUNT values.
+        static constexpr int MAGNITUDES = 20;
+        static constexpr int BUCKETS = (MAGNITUDES + 2) * HALF_COUNT;
+        static constexpr int64_t MAX_VALUE = (int64_t(SUB_COUNT) << MAGNITUDES) - 1;
+
+        void record(int64_t micros) {
+            micros = std::clamp(micros, int64_t(0), MAX_VALUE);
+            _counts[index(micros)]++;
+            if (_count == 0 || micros < _min)
+                _min = micros;
+            _max = std::max(_max, micros);
+            _sum += micros;
+            _count++;
+        }
+
+        void merge(const Histogram& other) {
+            if (other._count == 0)
+                return;
+            for (int i = 0; i < BUCKETS; i++)
+                _counts[i] += other._counts[i];
+            _min = _count == 0 ? other._min : std::min(_min, other._min);
+            _max = std::max(_max, other._max);
+            _sum += other._sum;
+            _count += other._count;
+        }
+
+        //! Takes back an earlier [merge] of [other]. [min] and [max] can't be
+        // taken back and are left as they were.
+        void subtract(const Histogram& other) {
+            for (int i = 0; i < BUCKETS; i++)
+                _counts[i] -= other._counts[i];
+            _sum -= other._sum;
+            _count -= other._count;
+            if (_count == 0) {
+                _min = 0;
+                _max = 0;
+            }
+        }
+
+        void clear() {
+            _counts.fill(0);
+            _count = 0;
+            _sum = 0;
+            _min = 0;
+            _max = 0;
+        }
+
+        //! The smallest value v such that [fraction] (0.0 - 1.0) of the
+        // recorded values are <= v, to the bucket's precision.
+        int64_t percentile(double fraction) const {
+            if (_count == 0)
+                return 0;
+
+            uint64_t rank = _rank(fraction);
+            uint64_t seen = 0;
+            for (int i = 0; i < BUCKETS; i++) {
+                seen += _counts[i];
+                if (seen >= rank)
+                    return std::min(upperBound(i), _max);
+            }
+            return _max;
+        }
+
+        //! [percentile] of each of [count] ascending [fractions], in one pass.
+        void percentiles(const double* fractions, int64_t* values, int count) const {
+            int f = 0;
+            uint64_t seen = 0;
+            for (int i = 0; i < BUCKETS && f < count && _count > 0; i++) {
+                seen += _counts[i];
+                while (f < count && seen >= _rank(fractions[f]))
+                    values[f++] = std::min(upperBound(i), _max);
+            }
+            for (; f < count; f++)
+                values[f] = _max;
+        }
+
+        //! Values > [micros]; exact when [micros] is a bucket's upper bound,
+        // otherwise whole buckets are counted from the one holding it.
+        uint64_t countAbove(int64_t micros) const {
+            micros = std::clamp(micros, int64_t(0), MAX_VALUE);
+            uint64_t above = 0;
+            for (int i = index(micros) + 1; i < BUCKETS; i++)
+                above += _counts[i];
+            return above;
+        }
+
+        uint64_t count() const {
+            return _count;
+        }
+
+        uint32_t bucketCount(int bucket) const {
+            return _counts[bucket];
+        }
+
+        int64_t min() const {
+            return _min;
+        }
+
+        int64_t max() const {
+            return _max;
+        }
+
+        double mean() const {
+            return _count > 0 ? double(_sum) / double(_count) : 0.0;
+        }
+
+        static int index(int64_t micros) {
+            uint64_t v = static_cast<uint64_t>(micros);
+            // How far [v] has to be shifted to fit SUB_BITS.
+            int shift = std::max(0, 63 - __builtin_clzll(v | 1) - (SUB_BITS - 1));
+            return shift * HALF_COUNT + static_cast<int>(v >> shift);
+        }
+
+        //! The largest value that lands in [bucket].
+        static int64_t upperBound(int bucket) {
+            int shift = std::max(0, bucket / HALF_COUNT - 1);
+            int64_t sub = bucket - shift * HALF_COUNT;
+            return ((sub + 1) << shift) - 1;
+        }
+
+    private:
+        uint64_t _rank(double fraction) const {
+            return std::max<uint64_t>(1, static_cast<uint64_t>(fraction * double(_count) + 0.5));
+        }
+
+        std::array<uint32_t, BUCKETS> _counts{};
+        uint64_t _count{0};
+        int64_t _sum{0};
+        int64_t _min{0};
+        int64_t _max{0};
+    };
+}
+
+#endif //RANGERALPHA_HISTOGRAM_H
@@ -0,0 +1,253 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_SCHEDULE_HANDLE_H
+#define RANGERALPHA_SCHEDULE_HANDLE_H
+
+#include <cstdint>
+#include <vector>
+
+namespace Ranger {
+    //! A stable reference to something scheduled with the @see Scheduler.
+    /*!
+     * Handles stay valid while the dense arrays behind them are reordered
+     * (swap-remove). Once the item is unscheduled the handle's generation no
+     * longer matches and the handle is simply ignored, so a stale handle can
+     * never reach a different, newer, item that reuses the slot.
+     */
+    struct ScheduleHandle {
+        static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+        uint32_t index{INVALID};
+        uint32_t generation{0};
+
+        bool valid() const {
+            return index != INVALID;
+        }
+
+        bool operator==(const ScheduleHandle& other) const {
+            return index == other.index && generation == other.generation;
+        }
+
+        bool operator!=(const ScheduleHandle& other) const {
+            return !(*this == other);
+        }
+    };
+
+    //! Maps @see ScheduleHandle(s) to locations in dense arrays.
+    /*!
+     * A location is a (bucket, position) pair; containers with a single array
+     * just use bucket 0. All operations are O(1). Released slots are recycled
+     * through a free list.
+     */
+    class HandleTable final {
+    public:
+        struct Location {
+            uint32_t bucket;
+            uint32_t position;
+        };
+
+        ScheduleHandle acquire(uint32_t bucket, uint32_t position) {
+            uint32_t index;
+            if (_freeHead != ScheduleHandle::INVALID) {
+                index = _freeHead;
+                _freeHead = _slots[index].nextFree;
+            }
+            else {
+                index = static_cast<uint32_t>(_slots.size());
+                _slots.push_back(Slot{});
+            }
+
+            Slot& slot = _slots[index];
+            slot.location = Location{bucket, position};
+            slot.live = true;
+            _live++;
+
+            return ScheduleHandle{index, slot.generation};
+        }
+
+        void release(ScheduleHandle handle) {
+            if (!valid(handle))
+                return;
+
+            Slot& slot = _slots[handle.index];
+            slot.live = false;
+            slot.generation++;
+            slot.nextFree = _freeHead;
+            _freeHead = handle.index;
+            _live--;
+        }
+
+        bool valid(ScheduleHandle handle) const {
+            return handle.index < _slots.size()
+                   && _slots[handle.index].live
+                   && _slots[handle.index].generation == handle.generation;
+        }
+
+        //! Only meaningful for a [valid] handle.
+        const Location& location(ScheduleHandle handle) const {
+            return _slots[handle.index].location;
+        }
+
+        //! Called when the item owned by slot [index] moved within its array.
+        void relocate(uint32_t index, uint32_t position) {
+            _slots[index].location.position = position;
+        }
+
+        //! Called when the item owned by slot [index] moved to another array.
+        void relocate(uint32_t index, uint32_t bucket, uint32_t position) {
+            _slots[index].location = Location{bucket, position};
+        }
+
+        //! Rebuilds the handle for a slot index stored alongside a dense item.
+        ScheduleHandle handle(uint32_t index) const {
+            return ScheduleHandle{index, _slots[index].generation};
+        }
+
+        //! Invalidates every handle handed out so far.
+        void clear() {
+            _freeHead = ScheduleHandle::INVALID;
+            for (uint32_t i = 0; i < _slots.size(); i++) {
+                if (_slots[i].live) {
+                    _slots[i].live = false;
+                    _slots[i].generation++;
+                }
+                _slots[i].nextFree = _freeHead;
+                _freeHead = i;
+            }
+            _live = 0;
+        }
+
+        size_t size() const {
+            return _live;
+        }
+
+        void reserve(size_t count) {
+            _slots.reserve(count);
+        }
+
+    private:
+        struct Slot {
+            Location location{0, 0};
+            uint32_t generation{0};
+            uint32_t nextFree{ScheduleHandle::INVALID};
+            bool live{false};
+        };
+
+        std::vector<Slot> _slots;
+        uint32_t _freeHead{ScheduleHandle::INVALID};
+        size_t _live{0};
+    };
+
+    //! Target id -> @see ScheduleHandle.
+    /*!
+     * Open addressing with linear probing and backward shift deletion, so
+     * inserting and erasing never allocate once the table has grown to the
+     * peak number of ids; unlike std::unordered_map which allocates a node
+     * per insert. Ids must be >= 0.
+     */
+    class IdMap final {
+    public:
+        //! An invalid handle if [id] isn't mapped.
+        ScheduleHandle find(int id) const {
+            if (_size == 0)
+                return ScheduleHandle{};
+
+            for (size_t i = _home(id);; i = (i + 1) & _mask) {
+                if (_entries[i].id == EMPTY)
+                    return ScheduleHandle{};
+                if (_entries[i].id == id)
+                    return _entries[i].handle;
+            }
+        }
+
+        //! Maps [id], replacing any existing mapping.
+        void insert(int id, ScheduleHandle handle) {
+            if ((_size + 1) * 2 > _entries.size())
+                _grow();
+
+            for (size_t i = _home(id);; i = (i + 1) & _mask) {
+                if (_entries[i].id == EMPTY) {
+                    _entries[i] = Entry{id, handle};
+                    _size++;
+                    return;
+                }
+                if (_entries[i].id == id) {
+                    _entries[i].handle = handle;
+                    return;
+                }
+            }
+        }
+
+        void erase(int id) {
+            if (_size == 0)
+                return;
+
+            size_t hole = _home(id);
+            while (_entries[hole].id != id) {
+                if (_entries[hole].id == EMPTY)
+                    return;
+                hole = (hole + 1) & _mask;
+            }
+
+            // Shift following entries back into the hole unless that would
+            // move them before their home.
+            for (size_t i = (hole + 1) & _mask; _entries[i].id != EMPTY; i = (i + 1) & _mask) {
+                size_t home = _home(_entries[i].id);
+                if (((i - home) & _mask) >= ((i - hole) & _mask)) {
+                    _entries[hole] = _entries[i];
+                    hole = i;
+                }
+            }
+            _entries[hole].id = EMPTY;
+            _size--;
+        }
+
+        void clear() {
+            for (auto& entry : _entries)
+                entry.id = EMPTY;
+            _size = 0;
+        }
+
+        void reserve(size_t count) {
+            while (count * 2 > _entries.size())
+                _grow();
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+    private:
+        static constexpr int EMPTY = -1;
+
+        struct Entry {
+            int id{EMPTY};
+            ScheduleHandle handle;
+        };
+
+        size_t _home(int id) const {
+            // Ids are sequential; spread them with a multiplicative hash.
+            return (static_cast<uint32_t>(id) * 2654435769u) & _mask;
+        }
+
+        void _grow() {
+            std::vector<Entry> old;
+            old.swap(_entries);
+            _entries.resize(old.empty() ? 16 : old.size() * 2);
+            _mask = _entries.size() - 1;
+            _size = 0;
+            for (const auto& entry : old) {
+                if (entry.id != EMPTY)
+                    insert(entry.id, entry.handle);
+            }
+        }
+
+        std::vector<Entry> _entries;
+        size_t _mask{0};
+        size_t _size{0};
+    };
+}
+
+#endif //RANGERALPHA_SCHEDULE_HANDLE_H
@@ -7,6 +7,9 @@
 #include <algorithm>
 
 #include "scheduler.h"
+#include "behavior.h"
+#include "../Jobs/job_system.h"
+#include "../Logging/log.h"
 
 namespace Ranger {
     //Scheduler::Scheduler(Scheduler const &aRef) = delete ;
@@ -17,49 +20,196 @@ namespace Ranger {
 ////        //_testTimer->arm();
 //    }
 
-//    Scheduler::~Scheduler() {
-//        // Note: call-site for destructors of unique_ptr(s).
-//    }
+    Scheduler::~Scheduler() {
+        // Note: call-site for destructors of unique_ptr(s).
+        stopAllBehaviors();
+    }
 
     void Scheduler::initialize() {
-//        for (int i = 0; i < TIMER_POOL_SIZE; i++) {
-//            std::unique_ptr<Timer> t = make_unique<Timer>();
-//            _timerPool.add(std::move(t));
-//        }
+        for (auto& pool : _timerPools)
+            pool.reserve(TIMER_POOL_SIZE);
+        _commands.reserve(COMMAND_BUFFER_SIZE);
+    }
+
+    void Scheduler::reserve(size_t timingTargets, size_t updateTargets) {
+        _targetHandles.reserve(timingTargets);
+        _targetIds.reserve(timingTargets);
+
+        for (auto& pool : _timerPools)
+            pool.reserve(updateTargets);
+        _timerHandles.reserve(updateTargets);
+        _timerIds.reserve(updateTargets);
     }
 
     void Scheduler::unScheduleAll() {
-        std::cout << "Scheduler: " << "unscheduling all targets." << std::endl;
-        _highPriorityTargets.clear();
-        _normalPriorityTargets.clear();
-        _updateTargets.clear();
+        if (_updating) {
+            _defer(Command{Command::UNSCHEDULE_ALL});
+            return;
+        }
+
+        LOG_DEBUG(LogCategory::TIMING, "Scheduler: unscheduling all targets.");
+        // Buckets are kept, with their capacity, for reuse.
+        for (auto& bucket : _buckets) {
+            bucket.targets.clear();
+            bucket.owners.clear();
+            bucket.slots.clear();
+        }
+        _targetHandles.clear();
+        _targetIds.clear();
+        _plannedTargets = 0;
+        _planDirty = true;
+
+        for (auto& pool : _timerPools)
+            pool.clear();
+        _wheel.clear();
+        _timerHandles.clear();
+        _timerIds.clear();
     }
 
     /**
      * @param dt delta in milliseconds.
      */
     void Scheduler::update(double dt) {
-        if (_timeScale != 1.0) {
-            dt *= _timeScale;
+        // Structural changes made by the targets are recorded rather than
+        // applied while the containers are being iterated.
+        struct Updating {
+            bool& flag;
+            ~Updating() { flag = false; }
+        } updating{_updating};
+        _updating = true;
+
+        if (_plannedTargets > 0) {
+            _updatePlan(dt);
         }
+        else {
+            // Update targets from lowest to highest priority.
+            for (uint32_t b : _bucketOrder) {
+                const std::vector<TimingTarget*>& targets = _buckets[b].targets;
+                for (size_t i = 0; i < targets.size(); i++) {
+                    TimingTarget* target = targets[i];
+                    if (!target->isPaused())
+                        target->update(dt);
+                }
+            }
+        }
+
+        // Interval timers: only those coming due are touched.
+        _wheel.advance(dt, [this](uint32_t slot) { _fireTimer(slot); });
 
-        // Update targets from lowest to highest priority.
-        for(const auto& target : _highPriorityTargets) {
-            if (!target->isPaused())
-                target->update(dt);
+        TimerPool& timers = _timerPools[FRAME_TIMERS];
+        for (uint32_t i = 0; i < timers.size(); i++) {
+            Timer& timer = timers[i];
+            if (!timer.isPaused())
+                timer.update(dt);
         }
 
-        for(const auto& target : _normalPriorityTargets) {
-            if (!target->isPaused())
-                target->update(dt);
+        _updating = false;
+        // The sync point.
+        if (!_commands.empty())
+            _applyCommands();
+
+        // Behaviors look everything up by handle as they go, so they may
+        // change the schedule directly.
+        if (!_behaviors.empty())
+            _updateBehaviors(dt);
+    }
+
+    // ##########################################################################
+    // Deferred changes
+    // ##########################################################################
+    void Scheduler::_defer(const Command& command) {
+        _commands.push_back(command);
+    }
+
+    void Scheduler::_applyCommands() {
+        // Commands may record more commands (ex: unScheduleAll's output);
+        // none are, as nothing is updating, but index rather than iterate.
+        for (size_t i = 0; i < _commands.size(); i++) {
+            const Command command = _commands[i];
+            switch (command.type) {
+                case Command::SCHEDULE_TARGET:
+                    if (_targetHandles.valid(command.handle))
+                        _placeTimingTarget(command.handle, _pendingTargets[command.owner]);
+                    break;
+                case Command::UNSCHEDULE_TARGET:
+                    unScheduleTimingTarget(command.handle);
+                    break;
+                case Command::PAUSE_TARGET:
+                    pauseTimingTarget(command.handle);
+                    break;
+                case Command::RESUME_TARGET:
+                    resumeTimingTarget(command.handle);
+                    break;
+                case Command::SCHEDULE_TIMER:
+                    if (_timerHandles.valid(command.handle))
+                        _placeTimer(command.handle, _pendingUpdateTargets[command.owner], command.value, command.count, command.arm);
+                    break;
+                case Command::UNSCHEDULE_TIMER:
+                    unscheduleUpdateTarget(command.handle);
+                    break;
+                case Command::ARM_TIMER:
+                    armUpdateTarget(command.handle);
+                    break;
+                case Command::ARM_TIMER_DELAY:
+                    armUpdateTargetWithDelay(command.handle, command.value);
+                    break;
+                case Command::DISARM_TIMER:
+                    disarmUpdateTarget(command.handle);
+                    break;
+                case Command::TIMER_INTERVAL:
+                    changeUpdateTargetInterval(command.handle, command.value);
+                    break;
+                case Command::TIMER_REPEAT:
+                    changeUpdateTargetRepeat(command.handle, command.count);
+                    break;
+                case Command::UNSCHEDULE_ALL:
+                    _removePlaced();
+                    break;
+            }
         }
 
-        for(const auto& target : _updateTargets) {
-            if (!target->isPaused())
-                target->update(dt);
+        // Capacity is kept, so a steady state frame doesn't allocate.
+        _commands.clear();
+        _pendingTargets.clear();
+        _pendingUpdateTargets.clear();
+    }
+
+    void Scheduler::_removePlaced() {
+        // Unlike unScheduleAll, handles of targets scheduled after the
+        // request, still pending, must survive.
+        for (auto& bucket : _buckets) {
+            for (size_t i = 0; i < bucket.targets.size(); i++) {
+                ScheduleHandle handle = _targetHandles.handle(bucket.slots[i]);
+                if (_targetIds.find(bucket.targets[i]->getId()) == handle)
+                    _targetIds.erase(bucket.targets[i]->getId());
+                _targetHandles.release(handle);
+            }
+            bucket.targets.clear();
+            bucket.owners.clear();
+            bucket.slots.clear();
         }
+        _plannedTargets = 0;
+        _planDirty = true;
+
+        for (auto& pool : _timerPools) {
+            while (pool.size() > 0) {
+                uint32_t last = pool.size() - 1;
+                _removeTimer(_timerHandles.handle(pool.slot(last)));
+            }
+        }
+    }
+
+    void Scheduler::_fireTimer(uint32_t slot) {
+        const HandleTable::Location& location = _timerHandles.location(_timerHandles.handle(slot));
+        Timer& timer = _timerPools[location.bucket][location.position];
+
+        if (timer.fire(_wheel.now()))
+            _wheel.insert(slot, timer.interval());
     }
 
+    // ##########################################################################
+    // TimingTargets
+    // ##########################################################################
     /*!
      * The smaller value for [TimingTarget.priority] the higher priority,
      * meaning they will be updated first before progressing to the lower priority
@@ -68,192 +218,554 @@ namespace Ranger {
      * Scheduling a @see TimingTarget here means it will be called forever which also
      * means it will never be added back to the [ObjectPool].
      */
-    void Scheduler::scheduleTimingTarget(SharedTimingTarget target) {
-        // Check normals first as they are the most abundant.
-        auto it = std::find(_normalPriorityTargets.begin(), _normalPriorityTargets.end(), target);
-
-        bool scheduled = false;
-        if (it == _normalPriorityTargets.end()) {
-            // The target wasn't found in the normal list, how about the highs.
-            it = std::find(_highPriorityTargets.begin(), _highPriorityTargets.end(), target);
-            if (it == _highPriorityTargets.end()) {
-                // It wasn't found in the highs either. This means it hasn't been scheduled yet.
-            }
-            else
-                scheduled = true;
+    ScheduleHandle Scheduler::scheduleTimingTarget(SharedTimingTarget target) {
+        ScheduleHandle found = _targetIds.find(target->getId());
+        if (found.valid()) {
+            LOG_WARN(LogCategory::TIMING, "Scheduler: target with priority [{}] already scheduled.", target->getPriority());
+            return found;
         }
 
-        if (scheduled) {
-            std::cout << "Scheduler: " << "target with priority [" << target->getPriority() << "] already scheduled." << std::endl;
-            return;
-        }
+        ScheduleHandle handle = _targetHandles.acquire(PENDING, 0);
+        _targetIds.insert(target->getId(), handle);
 
-        // What collection is the Target destine for.
-        if (target->getPriority() < 0) {
-            _highPriorityTargets.insert(target);
-            // Resort
-            //_highPriorityTargets.sort((TimingTarget a, TimingTarget b) => a.priority.compareTo(b.priority));
+        if (_updating) {
+            Command command{Command::SCHEDULE_TARGET, handle};
+            command.owner = static_cast<uint32_t>(_pendingTargets.size());
+            _pendingTargets.push_back(std::move(target));
+            _defer(command);
         }
-        else if (target->getPriority() == SchedulePriority::NORMAL_PRIORITY) {
-            _normalPriorityTargets.insert(target);
+        else {
+            _placeTimingTarget(handle, target);
         }
+
+        return handle;
+    }
+
+    void Scheduler::_placeTimingTarget(ScheduleHandle handle, const SharedTimingTarget& target) {
+        uint32_t b = _bucketFor(target->getPriority());
+        Bucket& bucket = _buckets[b];
+
+        auto position = static_cast<uint32_t>(bucket.targets.size());
+        _targetHandles.relocate(handle.index, b, position);
+
+        bucket.targets.push_back(target.get());
+        bucket.owners.push_back(target);
+        bucket.slots.push_back(handle.index);
+
+        if (target->isParallelSafe() || target->isMainThreadOnly())
+            _plannedTargets++;
+        _planDirty = true;
     }
 
     void Scheduler::unScheduleTimingTarget(SharedTimingTarget target) {
-        if (target->getPriority() < 0) {
-            _highPriorityTargets.erase(target);
-        }
-        else if (target->getPriority() == SchedulePriority::NORMAL_PRIORITY) {
-            if (!_normalPriorityTargets.empty()) {
-                unsigned long count = _normalPriorityTargets.erase(target);
-                if (count == 0) {
-                    std::stringstream ss;
-                    ss << __FILE__ << "::" << __FUNCTION__ << ": TimingTarget {" << target->getId() << "} " <<
-                    "not found." << std::endl;
-                    std::cout << ss.str();
-                }
-            }
+        ScheduleHandle found = _targetIds.find(target->getId());
+        if (!found.valid()) {
+            LOG_WARN(LogCategory::TIMING, "Scheduler::unScheduleTimingTarget: TimingTarget {{}} not found.", target->getId());
+            return;
         }
+
+        unScheduleTimingTarget(found);
     }
 
-    void Scheduler::pauseTimingTargetsByPriority(int priority) {
-        if (priority < 0) {
-            std::for_each(_highPriorityTargets.begin(), _highPriorityTargets.end(),
-                          [priority](const SharedTimingTarget& tt) { if (priority == tt->getPriority()) tt->pause(); });
+    void Scheduler::unScheduleTimingTarget(ScheduleHandle handle) {
+        if (!_targetHandles.valid(handle))
+            return;
+
+        if (_updating) {
+            _defer(Command{Command::UNSCHEDULE_TARGET, handle});
+            return;
         }
-        else if (priority == SchedulePriority::NORMAL_PRIORITY) {
-            std::for_each(_normalPriorityTargets.begin(), _normalPriorityTargets.end(),
-                          [priority](const SharedTimingTarget& tt) { if (priority == tt->getPriority()) tt->pause(); });
+
+        if (_targetHandles.location(handle).bucket == PENDING) {
+            // Scheduled and unscheduled before it was ever placed.
+            _releaseTargetHandle(handle, -1);
+            return;
         }
+
+        _removeTimingTarget(handle);
+    }
+
+    void Scheduler::_releaseTargetHandle(ScheduleHandle handle, int id) {
+        // The id may have been rescheduled, under a new handle, meanwhile.
+        if (id >= 0 && _targetIds.find(id) == handle)
+            _targetIds.erase(id);
+        _targetHandles.release(handle);
+    }
+
+    void Scheduler::_removeTimingTarget(ScheduleHandle handle) {
+        HandleTable::Location location = _targetHandles.location(handle);
+        Bucket& bucket = _buckets[location.bucket];
+
+        TimingTarget* target = bucket.targets[location.position];
+        int id = target->getId();
+
+        if (target->isParallelSafe() || target->isMainThreadOnly())
+            _plannedTargets--;
+        _planDirty = true;
+
+        // Swap-remove: the last entry fills the hole.
+        uint32_t last = static_cast<uint32_t>(bucket.targets.size()) - 1;
+        if (location.position != last) {
+            bucket.targets[location.position] = bucket.targets[last];
+            bucket.owners[location.position] = std::move(bucket.owners[last]);
+            bucket.slots[location.position] = bucket.slots[last];
+            _targetHandles.relocate(bucket.slots[location.position], location.position);
+        }
+
+        bucket.targets.pop_back();
+        bucket.owners.pop_back();
+        bucket.slots.pop_back();
+
+        _releaseTargetHandle(handle, id);
+    }
+
+    void Scheduler::pauseTimingTarget(ScheduleHandle handle) {
+        if (!_targetHandles.valid(handle))
+            return;
+        const HandleTable::Location& location = _targetHandles.location(handle);
+        if (location.bucket == PENDING)
+            _defer(Command{Command::PAUSE_TARGET, handle});
+        else
+            _buckets[location.bucket].targets[location.position]->pause();
+    }
+
+    void Scheduler::resumeTimingTarget(ScheduleHandle handle) {
+        if (!_targetHandles.valid(handle))
+            return;
+        const HandleTable::Location& location = _targetHandles.location(handle);
+        if (location.bucket == PENDING)
+            _defer(Command{Command::RESUME_TARGET, handle});
+        else
+            _buckets[location.bucket].targets[location.position]->resume();
+    }
+
+    void Scheduler::pauseTimingTargetsByPriority(int priority) {
+        auto found = _bucketByPriority.find(priority);
+        if (found == _bucketByPriority.end())
+            return;
+
+        for (TimingTarget* target : _buckets[found->second].targets)
+            target->pause();
     }
 
     void Scheduler::resumeTimingTargetsByPriority(int priority) {
-        if (priority < 0) {
-            std::for_each(_highPriorityTargets.begin(), _highPriorityTargets.end(),
-                          [priority](const SharedTimingTarget& tt) { if (priority == tt->getPriority()) tt->resume(); });
+        auto found = _bucketByPriority.find(priority);
+        if (found == _bucketByPriority.end())
+            return;
+
+        for (TimingTarget* target : _buckets[found->second].targets)
+            target->resume();
+    }
+
+    uint32_t Scheduler::_bucketFor(int priority) {
+        auto found = _bucketByPriority.find(priority);
+        if (found != _bucketByPriority.end())
+            return found->second;
+
+        // A new priority. This is rare, there are only ever a handful of
+        // distinct priorities, so keeping the order sorted here is cheap.
+        auto b = static_cast<uint32_t>(_buckets.size());
+        _buckets.push_back(Bucket{priority});
+        _bucketByPriority.emplace(priority, b);
+
+        auto it = std::upper_bound(_bucketOrder.begin(), _bucketOrder.end(), priority,
+                                   [this](int p, uint32_t other) { return p < _buckets[other].priority; });
+        _bucketOrder.insert(it, b);
+
+        return b;
+    }
+
+    // ##########################################################################
+    // Parallel plan
+    // ##########################################################################
+    void Scheduler::_buildPlan() {
+        static constexpr int COMPONENTS = 64;
+
+        // The last level that wrote/read each component.
+        int lastWrite[COMPONENTS];
+        int lastRead[COMPONENTS];
+        std::fill(lastWrite, lastWrite + COMPONENTS, -1);
+        std::fill(lastRead, lastRead + COMPONENTS, -1);
+
+        // Nothing may be placed at or below a barrier: the level of the last
+        // serial target or parallel group.
+        int barrier = -1;
+        int maxLevel = -1;
+        int openGroup = TimingTarget::NO_GROUP;
+
+        _targetLevels.clear();
+
+        for (uint32_t b : _bucketOrder) {
+            if (_strictPriorities)
+                barrier = maxLevel;
+
+            for (TimingTarget* target : _buckets[b].targets) {
+                int level;
+
+                if (target->isAccessDeclared()) {
+                    level = barrier + 1;
+
+                    TimingTarget::ComponentSet reads = target->reads();
+                    TimingTarget::ComponentSet writes = target->writes();
+
+                    for (int c = 0; c < COMPONENTS; c++) {
+                        TimingTarget::ComponentSet bit = TimingTarget::ComponentSet(1) << c;
+                        if (reads & bit)
+                            level = std::max(level, lastWrite[c] + 1);
+                        if (writes & bit)
+                            level = std::max(level, std::max(lastWrite[c], lastRead[c]) + 1);
+                    }
+
+                    for (int c = 0; c < COMPONENTS; c++) {
+                        TimingTarget::ComponentSet bit = TimingTarget::ComponentSet(1) << c;
+                        if (reads & bit)
+                            lastRead[c] = std::max(lastRead[c], level);
+                        if (writes & bit)
+                            lastWrite[c] = level;
+                    }
+
+                    openGroup = TimingTarget::NO_GROUP;
+                }
+                else if (target->parallelGroup() != TimingTarget::NO_GROUP
+                         && target->parallelGroup() == openGroup) {
+                    // Joins the group opened by the previous target(s).
+                    level = barrier;
+                }
+                else {
+                    // A serial target, or the first of a group: after
+                    // everything so far, and before everything that follows.
+                    level = maxLevel + 1;
+                    barrier = level;
+                    openGroup = target->parallelGroup();
+                }
+
+                maxLevel = std::max(maxLevel, level);
+                _targetLevels.push_back(static_cast<uint32_t>(level));
+            }
+        }
+
+        // Counting sort by level, stable so the plan is deterministic. Within
+        // a level main thread only targets go last.
+        auto levelCount = static_cast<size_t>(maxLevel + 1);
+        std::vector<uint32_t> counts(levelCount * 2 + 1, 0);
+
+        size_t i = 0;
+        for (uint32_t b : _bucketOrder) {
+            for (TimingTarget* target : _buckets[b].targets)
+                counts[_targetLevels[i++] * 2 + (target->isMainThreadOnly() ? 1 : 0) + 1]++;
         }
-        else if (priority == SchedulePriority::NORMAL_PRIORITY) {
-            std::for_each(_normalPriorityTargets.begin(), _normalPriorityTargets.end(),
-                          [priority](const SharedTimingTarget& tt) { if (priority == tt->getPriority()) tt->resume(); });
+        for (size_t c = 1; c < counts.size(); c++)
+            counts[c] += counts[c - 1];
+
+        _levels.resize(levelCount);
+        for (size_t l = 0; l < levelCount; l++)
+            _levels[l] = Level{counts[l * 2], counts[l * 2 + 1], counts[l * 2 + 2]};
+
+        _plan.resize(_targetLevels.size());
+        i = 0;
+        for (uint32_t b : _bucketOrder) {
+            for (TimingTarget* target : _buckets[b].targets)
+                _plan[counts[_targetLevels[i++] * 2 + (target->isMainThreadOnly() ? 1 : 0)]++] = target;
         }
+
+        _planDirty = false;
     }
 
-    bool Scheduler::PrioritySortCriterion::operator()(SharedTimingTarget p1, SharedTimingTarget p2) const {
-        return p1->getPriority() <= p2->getPriority();
+    void Scheduler::_updatePlan(double dt) {
+        if (_planDirty)
+            _buildPlan();
+
+        auto updateRange = [this, dt](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                TimingTarget* target = _plan[i];
+                if (!target->isPaused())
+                    target->update(dt);
+            }
+        };
+
+        bool jobs = _jobs && _jobs->isRunning();
+        bool parallel = jobs && _jobs->threadCount() > 1;
+        // Ex: the Engine's pipelined simulation thread.
+        bool offMain = jobs && !_jobs->isMainThread();
+
+        for (const Level& level : _levels) {
+            bool spread = parallel && level.mainBegin - level.begin > _parallelGrain;
+            bool pin = offMain && level.end > level.mainBegin;
+
+            if (!spread && !pin) {
+                updateRange(level.begin, level.end);
+                continue;
+            }
+
+            Job* root = spread
+                        ? _jobs->parallelForJob(nullptr, level.begin, level.mainBegin, _parallelGrain, updateRange)
+                        : _jobs->create([] {});
+
+            if (pin) {
+                // Picked up by the main thread's next JobSystem::pumpMainThread.
+                _jobs->runOnMain(_jobs->createChild(root, [&updateRange, &level] {
+                    updateRange(level.mainBegin, level.end);
+                }));
+            }
+
+            _jobs->run(root);
+            if (!spread)
+                updateRange(level.begin, level.mainBegin);
+            if (!pin)
+                updateRange(level.mainBegin, level.end);
+            _jobs->wait(root);
+        }
     }
 
     // ##########################################################################
     // UpdateTargets
     // ##########################################################################
-    void Scheduler::scheduleUpdateTarget(UpdateTargetSPtr target, bool autoArm) {
-        // Lamba style
-        //auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(),
-        //                       [&target] (const std::unique_ptr<Timer>& t) { return t->getId() == target.getId(); });
+    ScheduleHandle Scheduler::scheduleUpdateTarget(UpdateTargetSPtr target, bool autoArm) {
+        ScheduleHandle handle = _timerHandle(target);
+
+        if (handle.valid()) {
+            LOG_WARN(LogCategory::TIMING, "Scheduler: UpdateTarget [{}] already scheduled.", target->getId());
+            return handle;
+        }
 
-        // Formal class style
-        auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
+        return _addTimer(std::move(target), 0.0, Timer::REPEAT_FOREVER, autoArm);
+    }
 
-        if (it == _updateTargets.end()) {
-            //std::unique_ptr<Timer> t = std::unique_ptr<Timer>(new Timer(target));
-            //std::unique_ptr<Timer> t = make_unique<Timer>(std::make_shared(target));
-            std::unique_ptr<Timer> timer = std::unique_ptr<Timer>(new Timer(target));
-            //SmartObjectPool<Timer>::ptr_type timer = _timerPool.acquire();
-            timer->setTarget(target);
-            //std::unique_ptr<Timer> t = std::unique_ptr<Timer>(new Timer(target));
+    ScheduleHandle Scheduler::scheduleUpdateTarget(UpdateTargetSPtr target, double interval, int repeatCount, bool autoArm) {
+        ScheduleHandle handle = _timerHandle(target);
 
-            if (autoArm)
-                timer->arm();
+        if (handle.valid()) {
+            LOG_DEBUG(LogCategory::TIMING, "Scheduler: UpdateTarget [{}] already scheduled, changing interval and count.", target->getId());
+            changeUpdateTargetInterval(handle, interval);
+            changeUpdateTargetRepeat(handle, repeatCount);
+            return handle;
+        }
 
-            _updateTargets.push_back(std::move(timer));
-            //_updateTargets.push_back(timer);
+        return _addTimer(std::move(target), interval, repeatCount, autoArm);
+    }
+
+    ScheduleHandle Scheduler::_addTimer(UpdateTargetSPtr target, double interval, int repeatCount, bool autoArm) {
+        ScheduleHandle handle = _timerHandles.acquire(PENDING, 0);
+        _timerIds.insert(target->getId(), handle);
+
+        if (_updating) {
+            Command command{Command::SCHEDULE_TIMER, handle, interval, repeatCount};
+            command.arm = autoArm;
+            command.owner = static_cast<uint32_t>(_pendingUpdateTargets.size());
+            _pendingUpdateTargets.push_back(std::move(target));
+            _defer(command);
         }
         else {
-            std::cout << "Scheduler: " << "UpdateTarget ["<< target->getId() << "] already scheduled." << std::endl;
+            _placeTimer(handle, target, interval, repeatCount, autoArm);
+        }
+
+        return handle;
+    }
+
+    void Scheduler::_placeTimer(ScheduleHandle handle, const UpdateTargetSPtr& target, double interval, int repeatCount, bool autoArm) {
+        // A freshly reset Timer is armed.
+        TimerPool& pool = _timerPools[FRAME_TIMERS];
+        uint32_t position = pool.acquire(handle.index);
+        pool[position].reset(target, interval, repeatCount);
+        if (!autoArm)
+            pool[position].disarm();
+        _timerHandles.relocate(handle.index, FRAME_TIMERS, position);
+
+        _timerHighWater = std::max(_timerHighWater, _timerHandles.size());
+
+        _syncTimer(handle);
+    }
+
+    void Scheduler::unscheduleUpdateTarget(UpdateTargetSPtr target) {
+        ScheduleHandle handle = _timerHandle(target);
+        if (!handle.valid()) {
+            LOG_WARN(LogCategory::TIMING, "Scheduler: Couldn't find UpdateTarget [{}] to remove.", target->getId());
+            return;
         }
+
+        unscheduleUpdateTarget(handle);
     }
 
-    void Scheduler::scheduleUpdateTarget(UpdateTargetSPtr target, double interval, int repeatCount, bool autoArm) {
-        // Lamba style
-        //auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(),
-        //                       [&target] (const std::unique_ptr<Timer>& t) { return t->getId() == target.getId(); });
+    void Scheduler::unscheduleUpdateTarget(ScheduleHandle handle) {
+        if (!_timerHandles.valid(handle))
+            return;
 
-        // Formal class style
-        auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
+        if (_updating) {
+            _defer(Command{Command::UNSCHEDULE_TIMER, handle});
+            return;
+        }
 
-        if (it == _updateTargets.end()) {
-            //std::unique_ptr<Timer> t = std::unique_ptr<Timer>(new Timer(target, interval));
-            //std::unique_ptr<Timer> t = make_unique<Timer>(target, interval);
-            std::unique_ptr<Timer> timer = std::unique_ptr<Timer>(new Timer(target));
-            //SmartObjectPool<Timer>::ptr_type timer = _timerPool.acquire();
+        if (_timerHandles.location(handle).bucket == PENDING) {
+            _releaseTimerHandle(handle, -1);
+            return;
+        }
 
-            timer->changeInterval(interval);
-            timer->changeRepeats(repeatCount);
+        _removeTimer(handle);
+    }
+
+    void Scheduler::_releaseTimerHandle(ScheduleHandle handle, int id) {
+        if (id >= 0 && _timerIds.find(id) == handle)
+            _timerIds.erase(id);
+        _timerHandles.release(handle);
+    }
+
+    void Scheduler::_removeTimer(ScheduleHandle handle) {
+        HandleTable::Location location = _timerHandles.location(handle);
+        TimerPool& pool = _timerPools[location.bucket];
+
+        int id = pool[location.position].getId();
+        _wheel.cancel(handle.index);
+
+        pool.release(location.position, _timerHandles);
 
-            if (autoArm)
-                timer->arm();
+        _releaseTimerHandle(handle, id);
+    }
+
+    void Scheduler::_syncTimer(ScheduleHandle handle) {
+        HandleTable::Location location = _timerHandles.location(handle);
+        Timer* timer = &_timerPools[location.bucket][location.position];
 
-            _updateTargets.push_back(std::move(timer));
+        uint32_t wanted = timer->hasInterval() ? WHEEL_TIMERS : FRAME_TIMERS;
+        if (location.bucket != wanted) {
+            uint32_t position = _timerPools[location.bucket].moveTo(location.position, _timerPools[wanted], wanted, _timerHandles);
+            timer = &_timerPools[wanted][position];
         }
-        else {
-            Timer* timer = it->get();
-            timer->changeInterval(interval);
-            timer->changeRepeats(repeatCount);
-            std::cout << "Scheduler: " << "UpdateTarget ["<< target->getId() << "] already scheduled, changing interval and count." << std::endl;
+
+        _wheel.cancel(handle.index);
+
+        if (wanted == WHEEL_TIMERS && timer->isActive()) {
+            timer->start(_wheel.now());
+            _wheel.insert(handle.index, timer->firstDue());
         }
     }
 
-    bool Scheduler::TimerUnaryPredicate::operator()(const std::unique_ptr<Timer>& t) {
-        return t->getId() == uta->getId();
+    Timer* Scheduler::_timer(ScheduleHandle handle) const {
+        if (!_timerHandles.valid(handle))
+            return nullptr;
+        const HandleTable::Location& location = _timerHandles.location(handle);
+        if (location.bucket == PENDING)
+            return nullptr;
+        return const_cast<Timer*>(&_timerPools[location.bucket][location.position]);
     }
 
-    void Scheduler::unscheduleUpdateTarget(UpdateTargetSPtr target) {
-        auto it = std::remove_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
-        if (it == _updateTargets.end()) {
-            std::cout << "Scheduler: " << "Couldn't find UpdateTarget ["<< target->getId() << "] to remove." << std::endl;
+    ScheduleHandle Scheduler::_timerHandle(const UpdateTargetSPtr& target) const {
+        return _timerIds.find(target->getId());
+    }
+
+    Scheduler::TimerPoolStats Scheduler::timerPoolStats() const {
+        TimerPoolStats stats{_timerHandles.size(), _timerHighWater, 0, 0, 0};
+        for (const auto& pool : _timerPools) {
+            stats.constructed += pool.constructed();
+            stats.acquired += pool.acquired();
+            stats.reused += pool.reused();
         }
+        return stats;
     }
 
     void Scheduler::armUpdateTarget(UpdateTargetSPtr target) {
-        auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
-        if (it != _updateTargets.end()) {
-            Timer* timer = it->get();
+        armUpdateTarget(_timerHandle(target));
+    }
+
+    void Scheduler::armUpdateTarget(ScheduleHandle handle) {
+        if (_updating) {
+            if (_timerHandles.valid(handle))
+                _defer(Command{Command::ARM_TIMER, handle});
+            return;
+        }
+
+        Timer* timer = _timer(handle);
+        if (timer) {
             timer->arm();
+            _syncTimer(handle);
+        }
+    }
+
+    void Scheduler::armUpdateTargetWithDelay(UpdateTargetSPtr target, double delay) {
+        armUpdateTargetWithDelay(_timerHandle(target), delay);
+    }
+
+    void Scheduler::armUpdateTargetWithDelay(ScheduleHandle handle, double delay) {
+        if (_updating) {
+            if (_timerHandles.valid(handle))
+                _defer(Command{Command::ARM_TIMER_DELAY, handle, delay});
+            return;
+        }
+
+        Timer* timer = _timer(handle);
+        if (timer) {
+            timer->armWithDelay(delay);
+            _syncTimer(handle);
         }
     }
 
     void Scheduler::changeUpdateTargetInterval(UpdateTargetSPtr target, double interval) {
-        auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
-        if (it != _updateTargets.end()) {
-            Timer* timer = it->get();
-            std::cout << "Scheduler: " << "changing UpdateTarget ["<< target->getId() << "] interval." << std::endl;
+        ScheduleHandle handle = _timerHandle(target);
+        if (handle.valid()) {
+            LOG_DEBUG(LogCategory::TIMING, "Scheduler: changing UpdateTarget [{}] interval.", target->getId());
+            changeUpdateTargetInterval(handle, interval);
+        }
+    }
+
+    void Scheduler::changeUpdateTargetInterval(ScheduleHandle handle, double interval) {
+        if (_updating) {
+            if (_timerHandles.valid(handle))
+                _defer(Command{Command::TIMER_INTERVAL, handle, interval});
+            return;
+        }
+
+        Timer* timer = _timer(handle);
+        if (timer) {
             timer->changeInterval(interval);
+            _syncTimer(handle);
         }
     }
 
     void Scheduler::changeUpdateTargetRepeat(UpdateTargetSPtr target, int count) {
-        auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
-        if (it != _updateTargets.end()) {
-            Timer* timer = it->get();
-            std::cout << "Scheduler: " << "changing UpdateTarget ["<< target->getId() << "] repeat count." << std::endl;
+        ScheduleHandle handle = _timerHandle(target);
+        if (handle.valid()) {
+            LOG_DEBUG(LogCategory::TIMING, "Scheduler: changing UpdateTarget [{}] repeat count.", target->getId());
+            changeUpdateTargetRepeat(handle, count);
+        }
+    }
+
+    void Scheduler::changeUpdateTargetRepeat(ScheduleHandle handle, int count) {
+        if (_updating) {
+            if (_timerHandles.valid(handle))
+                _defer(Command{Command::TIMER_REPEAT, handle, 0.0, count});
+            return;
+        }
+
+        Timer* timer = _timer(handle);
+        if (timer) {
             timer->changeRepeats(count);
+            _syncTimer(handle);
         }
     }
 
     void Scheduler::disarmUpdateTarget(UpdateTargetSPtr target) {
-        auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
-        if (it != _updateTargets.end()) {
-            Timer* timer = it->get();
+        disarmUpdateTarget(_timerHandle(target));
+    }
+
+    void Scheduler::disarmUpdateTarget(ScheduleHandle handle) {
+        if (_updating) {
+            if (_timerHandles.valid(handle))
+                _defer(Command{Command::DISARM_TIMER, handle});
+            return;
+        }
+
+        Timer* timer = _timer(handle);
+        if (timer) {
             timer->disarm();
+            _syncTimer(handle);
         }
     }
 
     Timer const* Scheduler::getUpdateTargetTimer(UpdateTargetSPtr target) {
-        auto it = std::find_if(_updateTargets.begin(), _updateTargets.end(), TimerUnaryPredicate(target));
-        if (it != _updateTargets.end()) {
-            Timer* timer = it->get();
-            return dynamic_cast<Timer const*>(timer);
-        }
-        return nullptr;
+        return _timer(_timerHandle(target));
+    }
+
+    Timer const* Scheduler::getUpdateTargetTimer(ScheduleHandle handle) const {
+        return _timer(handle);
     }
 
     std::string Scheduler::toString(UpdateTargetSPtr target) {
@@ -270,11 +782,166 @@ namespace Ranger {
     }
 
     //! toString()
+    // ##########################################################################
+    // Behaviors
+    // ##########################################################################
+    static Behavior::Handle coroutineOf(void* frame) {
+        return Behavior::Handle::from_address(frame);
+    }
+
+    ScheduleHandle Scheduler::startBehavior(Behavior&& behavior) {
+        if (!behavior.valid()) {
+            std::stringstream ss;
+            ss << __FILE__ << "::" << __FUNCTION__ << " Behavior is empty (moved from or already started).";
+            throw std::invalid_argument(ss.str());
+        }
+
+        auto position = static_cast<uint32_t>(_behaviors.size());
+        ScheduleHandle handle = _behaviorHandles.acquire(0, position);
+
+        Behavior::Handle coroutine = behavior.release();
+        coroutine.promise().wait = BehaviorWait{BehaviorWait::FRAME};
+        _behaviors.push_back(coroutine.address());
+        _behaviorSlots.push_back(handle.index);
+
+        _waitingBehaviors.push_back(handle);
+
+        return handle;
+    }
+
+    void Scheduler::stopBehavior(ScheduleHandle handle) {
+        if (!_behaviorHandles.valid(handle))
+            return;
+
+        if (handle.index == _runningBehavior) {
+            // Can't destroy a coroutine from within itself.
+            _stopRunningBehavior = true;
+            return;
+        }
+
+        _removeBehavior(handle);
+    }
+
+    void Scheduler::stopAllBehaviors() {
+        // From the back so a swap-remove only moves entries already visited.
+        for (size_t i = _behaviors.size(); i-- > 0;) {
+            uint32_t slot = _behaviorSlots[i];
+            if (slot == _runningBehavior)
+                _stopRunningBehavior = true;
+            else
+                _removeBehavior(_behaviorHandles.handle(slot));
+        }
+
+        _waitingBehaviors.clear();
+        _resumingBehaviors.clear();
+    }
+
+    void Scheduler::_updateBehaviors(double dt) {
+        // Anything that suspends from here on waits for the next update.
+        _resumingBehaviors.swap(_waitingBehaviors);
+        _waitingBehaviors.clear();
+
+        _behaviorWheel.advance(dt, [this](uint32_t slot) { _resumeBehavior(slot); });
+
+        for (size_t i = 0; i < _resumingBehaviors.size(); i++) {
+            ScheduleHandle handle = _resumingBehaviors[i];
+            if (!_behaviorHandles.valid(handle))
+                continue; // Stopped meanwhile.
+
+            const HandleTable::Location& location = _behaviorHandles.location(handle);
+            BehaviorWait& wait = coroutineOf(_behaviors[location.position]).promise().wait;
+
+            if (wait.kind == BehaviorWait::POLL && !wait.poll(wait.awaiter, dt)) {
+                _waitingBehaviors.push_back(handle);
+                continue;
+            }
+
+            _resumeBehavior(handle.index);
+        }
+        _resumingBehaviors.clear();
+    }
+
+    void Scheduler::_resumeBehavior(uint32_t slot) {
+        ScheduleHandle handle = _behaviorHandles.handle(slot);
+        Behavior::Handle coroutine = coroutineOf(_behaviors[_behaviorHandles.location(handle).position]);
+
+        _runningBehavior = slot;
+        _stopRunningBehavior = false;
+        try {
+            coroutine.resume();
+        }
+        catch (...) {
+            _runningBehavior = ScheduleHandle::INVALID;
+            _removeBehavior(_behaviorHandles.handle(slot));
+            throw;
+        }
+        _runningBehavior = ScheduleHandle::INVALID;
+
+        // The Behavior may have started others, or stopped them all, so
+        // look it up again.
+        handle = _behaviorHandles.handle(slot);
+        if (coroutine.done() || _stopRunningBehavior)
+            _removeBehavior(handle);
+        else
+            _parkBehavior(slot);
+    }
+
+    void Scheduler::_parkBehavior(uint32_t slot) {
+        ScheduleHandle handle = _behaviorHandles.handle(slot);
+        const BehaviorWait& wait = coroutineOf(_behaviors[_behaviorHandles.location(handle).position]).promise().wait;
+
+        if (wait.kind == BehaviorWait::TIME)
+            _behaviorWheel.insert(slot, wait.delay);
+        else
+            _waitingBehaviors.push_back(handle);
+    }
+
+    void Scheduler::_removeBehavior(ScheduleHandle handle) {
+        uint32_t position = _behaviorHandles.location(handle).position;
+        coroutineOf(_behaviors[position]).destroy();
+        _behaviorWheel.cancel(handle.index);
+
+        // Swap-remove; entries in the waiting lists go stale with the handle.
+        auto last = static_cast<uint32_t>(_behaviors.size() - 1);
+        if (position != last) {
+            _behaviors[position] = _behaviors[last];
+            _behaviorSlots[position] = _behaviorSlots[last];
+            _behaviorHandles.relocate(_behaviorSlots[position], position);
+        }
+        _behaviors.pop_back();
+        _behaviorSlots.pop_back();
+
+        _behaviorHandles.release(handle);
+    }
+
+    Scheduler::Counts Scheduler::counts() const {
+        Counts counts;
+        for (const auto& bucket : _buckets) {
+            if (bucket.priority < 0)
+                counts.highPriority += bucket.targets.size();
+            else
+                counts.normalPriority += bucket.targets.size();
+        }
+
+        counts.levels = levelCount();
+        counts.updateTargets = _timerPools[FRAME_TIMERS].size();
+        counts.intervalTargets = _timerPools[WHEEL_TIMERS].size();
+        counts.timersConstructed = _timerPools[FRAME_TIMERS].constructed() + _timerPools[WHEEL_TIMERS].constructed();
+        counts.behaviors = _behaviors.size();
+        return counts;
+    }
+
     std::ostream& operator<<(std::ostream &os, const Scheduler &t) {
+        Scheduler::Counts counts = t.counts();
+
         return os << "Scheduler: " <<
-                "HighPriority(s)= " << t._highPriorityTargets.size() <<
-                ", NormalPriority(s)= " << t._normalPriorityTargets.size() <<
-                ", UpdateTarget(s)= " << t._updateTargets.size();
+                "HighPriority(s)= " << counts.highPriority <<
+                ", NormalPriority(s)= " << counts.normalPriority <<
+                ", Level(s)= " << counts.levels <<
+                ", UpdateTarget(s)= " << counts.updateTargets <<
+                ", IntervalTarget(s)= " << counts.intervalTargets <<
+                ", Timer(s) constructed= " << counts.timersConstructed <<
+                ", Behavior(s)= " << counts.behaviors;
     }
 
 }
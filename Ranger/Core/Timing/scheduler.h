@@ -5,28 +5,86 @@
 #ifndef RANGERALPHA_SCHEDULER_H
 #define RANGERALPHA_SCHEDULER_H
 
-#include <list>
-#include <set>
+#include <array>
+#include <memory>
+#include <vector>
 #include "../../ranger.h"
 #include "update_target.h"
 #include "timer.h"
-
-//#include "../Pooling/SmartObjectPool.h"
+#include "timer_pool.h"
+#include "schedule_handle.h"
+#include "timing_wheel.h"
 
 namespace Ranger {
+    class Behavior;
+
     /*! \class Scheduler Scheduler.h "Ranger/Timing/Scheduler.h"
      *  \brief Scheduler responsible of updating the scheduled callbacks.
      *
      * There are 2 different types of callbacks:
      * - @see TimingTarget the callback will be called every frame. You can customize the priority.
      * - @see UpdateTarget A custom target that will be called every frame, or with a custom interval of time.
-     *   UpdateTargets are driven by an internal Timer object.
+     *   UpdateTargets are driven by an internal Timer object, taken from a @see TimerPool.
+     *
+     * Everything scheduled is kept in dense arrays (one per priority for TimingTargets) and
+     * is addressed through a @see ScheduleHandle. Scheduling returns a handle; handle based calls
+     * are O(1). The target based calls are kept for convenience and cost one hash lookup.
+     *
+     * UpdateTargets with an interval are parked in a @see TimingWheel and cost nothing
+     * until their interval elapses; only interval-less UpdateTargets are visited every frame.
+     *
+     * TimingTargets that declare their access (@see TimingTarget::access, parallelGroup) can be
+     * updated concurrently on a @see JobSystem. The scheduler arranges all TimingTargets into
+     * levels: a target lands one level past every earlier (by priority, then scheduling order)
+     * target it conflicts with, and targets that declare nothing act as barriers. A level's
+     * targets run concurrently; levels run one after the other. Conflicting targets therefore
+     * always run in the same order as a serial update would run them, which keeps the result
+     * deterministic. Main thread only targets run within their level on the calling thread or,
+     * if that isn't the JobSystem's main thread, as jobs pinned to it.
+     *
+     * @see Behavior coroutines are resumed after the targets and timers, in the order they
+     * became due. Like interval UpdateTargets, a Behavior awaiting time sits in a TimingWheel.
+     *
+     * Targets may schedule, unschedule, arm or change targets (themselves included) from within
+     * [update]. Such changes are recorded in a command buffer and applied, in the order they were
+     * made, once the targets and timers have been updated; handles are returned right away and
+     * are valid immediately. The parallel plan is then rebuilt once for the whole batch. Parallel
+     * safe targets must not change the schedule; make such a target mainThreadOnly. Behaviors
+     * run after that sync point and change the schedule directly.
      */
     class Scheduler final {
 
     public:
 
-        const int TIMER_POOL_SIZE = 32;
+        //! Timers each pool starts with; the pools grow as needed.
+        static constexpr uint32_t TIMER_POOL_SIZE = 32;
+        //! Deferred changes per update before the command buffer grows.
+        static constexpr uint32_t COMMAND_BUFFER_SIZE = 256;
+
+        struct TimerPoolStats {
+            size_t live;
+            //! The most Timers live at once.
+            size_t highWater;
+            size_t constructed;
+            uint64_t acquired;
+            uint64_t reused;
+
+            //! [0.0, 1.0] of the schedules served without constructing a Timer.
+            double reuseRate() const {
+                return acquired > 0 ? double(reused) / double(acquired) : 0.0;
+            }
+        };
+
+        //! What operator<< prints.
+        struct Counts {
+            size_t highPriority{0};
+            size_t normalPriority{0};
+            size_t levels{0};
+            size_t updateTargets{0};
+            size_t intervalTargets{0};
+            size_t timersConstructed{0};
+            size_t behaviors{0};
+        };
 
         // Our Constructor/Destructor CAN NOT be defined inline because of a unique_ptr being used.
         // The link below talks about the term call-sites.
@@ -42,97 +100,309 @@ namespace Ranger {
          * TimingTarget destructor is anyway in Scheduler.cpp
          */
 //        Scheduler();
-//        ~Scheduler();
+        //! Destroys the Behaviors still running.
+        ~Scheduler();
         //Scheduler(Scheduler const &aRef) = delete ;
 
         //Scheduler(Scheduler&& other) = delete;
         //Scheduler& operator=(Scheduler&& other) = delete;
 
+        //! Pre-sizes the timer pools with TIMER_POOL_SIZE Timers each.
         void initialize();
 
+        //! Pre-sizes the dense arrays and handle tables.
+        /*!
+         * Optional; scheduling grows them on demand.
+         */
+        void reserve(size_t timingTargets, size_t updateTargets);
+
         // ##########################################################################
         // TimingTargets
         // ##########################################################################
         //! Un-schedule all targets
         /*!
-         *  More detail here.
+         *  All handles handed out so far become invalid.
          */
         void unScheduleAll();
 
-        void scheduleTimingTarget(SharedTimingTarget target);
+        //! Schedules [target] into the bucket of its current priority.
+        /*!
+         * Changing a target's priority after it is scheduled has no effect
+         * until it is unscheduled and scheduled again.
+         * \return a handle for O(1) unschedule/pause/resume. If the target was
+         * already scheduled its existing handle is returned.
+         */
+        ScheduleHandle scheduleTimingTarget(SharedTimingTarget target);
         void unScheduleTimingTarget(SharedTimingTarget target);
+        void unScheduleTimingTarget(ScheduleHandle handle);
+
+        void pauseTimingTarget(ScheduleHandle handle);
+        void resumeTimingTarget(ScheduleHandle handle);
 
         void pauseTimingTargetsByPriority(int priority);
         void resumeTimingTargetsByPriority(int priority);
 
+        //! Jobs used to update parallel safe TimingTargets. nullptr = serial.
+        void useJobSystem(JobSystem* jobs) {
+            _jobs = jobs;
+        }
+
+        //! Targets per job within a level.
+        void parallelGrain(size_t grain) {
+            _parallelGrain = grain > 0 ? grain : 1;
+        }
+
+        //! If true a priority never overlaps the previous one, even when
+        // their targets don't conflict.
+        void strictPriorities(bool strict) {
+            _strictPriorities = strict;
+            _planDirty = true;
+        }
+
+        //! Levels in the current parallel plan, 0 if all targets are serial.
+        size_t levelCount() const {
+            return _plannedTargets > 0 ? _levels.size() : 0;
+        }
+
+        bool isScheduled(ScheduleHandle handle) const {
+            return _targetHandles.valid(handle);
+        }
+
         // ##########################################################################
         // UpdateTargets
         // ##########################################################################
-        void scheduleUpdateTarget(UpdateTargetSPtr target, bool autoArm = true);
-        void scheduleUpdateTarget(UpdateTargetSPtr target, double interval, int repeatCount, bool autoArm = true);
+        //! [autoArm] false leaves a newly scheduled target paused until armUpdateTarget.
+        ScheduleHandle scheduleUpdateTarget(UpdateTargetSPtr target, bool autoArm = true);
+        ScheduleHandle scheduleUpdateTarget(UpdateTargetSPtr target, double interval, int repeatCount, bool autoArm = true);
 
         void armUpdateTarget(UpdateTargetSPtr target);
+        void armUpdateTargetWithDelay(UpdateTargetSPtr target, double delay);
         void disarmUpdateTarget(UpdateTargetSPtr target);
         void changeUpdateTargetInterval(UpdateTargetSPtr target, double interval);
         void changeUpdateTargetRepeat(UpdateTargetSPtr target, int count);
         void unscheduleUpdateTarget(UpdateTargetSPtr target);
+        //! Valid until the next UpdateTarget is scheduled or unscheduled;
+        // pooled Timers move. nullptr until a target scheduled during
+        // [update] is placed.
         Timer const* getUpdateTargetTimer(UpdateTargetSPtr target);
         std::string toString(UpdateTargetSPtr target);
 
+        //! Handle based versions of the above, all O(1).
+        void armUpdateTarget(ScheduleHandle handle);
+        void armUpdateTargetWithDelay(ScheduleHandle handle, double delay);
+        void disarmUpdateTarget(ScheduleHandle handle);
+        void changeUpdateTargetInterval(ScheduleHandle handle, double interval);
+        void changeUpdateTargetRepeat(ScheduleHandle handle, int count);
+        void unscheduleUpdateTarget(ScheduleHandle handle);
+        Timer const* getUpdateTargetTimer(ScheduleHandle handle) const;
+
+        bool isUpdateTargetScheduled(ScheduleHandle handle) const {
+            return _timerHandles.valid(handle);
+        }
+
+        TimerPoolStats timerPoolStats() const;
+
+        //! Walks the buckets, cheap enough to call every frame.
+        Counts counts() const;
+
+        // ##########################################################################
+        // Behaviors
+        // ##########################################################################
+        //! Takes over [behavior]; it first runs on the next [update].
+        /*!
+         * Requires C++20; see behavior.h.
+         * \return a handle valid until the Behavior returns or is stopped.
+         */
+        ScheduleHandle startBehavior(Behavior&& behavior);
+
+        //! Destroys the Behavior where it is suspended. A Behavior may stop
+        // itself; it is then destroyed once it suspends.
+        void stopBehavior(ScheduleHandle handle);
+        void stopAllBehaviors();
+
+        bool isBehaviorRunning(ScheduleHandle handle) const {
+            return _behaviorHandles.valid(handle);
+        }
+
+        size_t behaviorCount() const {
+            return _behaviorHandles.size();
+        }
+
         // ##########################################################################
         // Core update
         // ##########################################################################
         //! Update all targets
         /*!
+         * Slow/hyper motion and pausing are up to the caller, see @see FrameClock.
          *  \param dt time per frame in milliseconds
          */
         void update(double dt);
 
     private:
-        //! Slow/Hyper motion control
+        // #############################################################################
+        // Deferred changes
+        // #############################################################################
+        //! The bucket of a handle whose target isn't placed yet.
+        static constexpr uint32_t PENDING = 0xFFFFFFFF;
+
+        struct Command {
+            enum Type : uint8_t {
+                SCHEDULE_TARGET,
+                UNSCHEDULE_TARGET,
+                PAUSE_TARGET,
+                RESUME_TARGET,
+                SCHEDULE_TIMER,
+                UNSCHEDULE_TIMER,
+                ARM_TIMER,
+                ARM_TIMER_DELAY,
+                DISARM_TIMER,
+                TIMER_INTERVAL,
+                TIMER_REPEAT,
+                UNSCHEDULE_ALL
+            };
+
+            Type type;
+            ScheduleHandle handle{};
+            double value{0.0};
+            int count{0};
+            //! SCHEDULE_TIMER: autoArm.
+            bool arm{true};
+            //! Index into [_pendingTargets] or [_pendingUpdateTargets].
+            uint32_t owner{0};
+        };
+
+        void _defer(const Command& command);
+        void _applyCommands();
+        //! unScheduleAll, sparing targets still pending.
+        void _removePlaced();
+
+        //! True while [update] iterates; changes are deferred meanwhile.
+        bool _updating{false};
+        std::vector<Command> _commands;
+        //! Keeps targets scheduled during [update] alive until placed.
+        std::vector<SharedTimingTarget> _pendingTargets;
+        std::vector<UpdateTargetSPtr> _pendingUpdateTargets;
+
+        // #############################################################################
+        // TimingTarget types
+        // #############################################################################
+        //! All targets sharing one priority, stored densely.
         /*!
-         * For slow motion set the value to < 1.0
-         * For hyper motion set the value to > 1.0
+         * The update loop walks [targets] front to back; the parallel arrays
+         * are only touched when scheduling. Removal swaps the last entry into
+         * the hole, so order within a bucket is not preserved, but order
+         * between buckets (priorities) is.
          */
-        double _timeScale = 1.0;
+        struct Bucket {
+            int priority{0};
+            std::vector<TimingTarget*> targets{};
+            // We don't want the Scheduler to be the owner of TimingTargets but
+            // they must stay alive while scheduled, hence shared_ptr(s).
+            std::vector<SharedTimingTarget> owners{};
+            //! The handle slot of each entry, used to fix up handles after a swap.
+            std::vector<uint32_t> slots{};
+        };
+
+        uint32_t _bucketFor(int priority);
+        void _placeTimingTarget(ScheduleHandle handle, const SharedTimingTarget& target);
+        void _removeTimingTarget(ScheduleHandle handle);
+        //! Releases [handle] and unmaps [id] (-1 = unknown) if it maps to it.
+        void _releaseTargetHandle(ScheduleHandle handle, int id);
 
         // #############################################################################
-        // TimingTarget types
+        // Parallel plan
         // #############################################################################
-        // I could have used a lambda for sorting but class types are generally optimized better by the compiler.
-        struct PrioritySortCriterion {
-            // Again, because of the use of smart pointers the implementation must be in the
-            // location where the full type specification occurs which is in the implementation file.
-            // Hence, I can't have the operator defined as inline here.
-            bool operator() (SharedTimingTarget p1, SharedTimingTarget p2) const;
+        //! A range of [_plan]; [begin, mainBegin) may run on workers,
+        // [mainBegin, end) runs on the calling thread.
+        struct Level {
+            uint32_t begin;
+            uint32_t mainBegin;
+            uint32_t end;
         };
 
-        // We don't want the Scheduler to be the owner of TimingTargets so we use
-        // shared_ptr(s).
-        // I chose an std::set because:
-        // 1) To maintain priority ordering.
-        // 2) Disallow a TimingTarget to be scheduled more than once.
-        std::set<SharedTimingTarget, PrioritySortCriterion> _highPriorityTargets; // (-∞ to 0)
-        std::set<SharedTimingTarget, PrioritySortCriterion> _normalPriorityTargets; // [0 to ∞)
+        void _buildPlan();
+        void _updatePlan(double dt);
+
+        JobSystem* _jobs{nullptr};
+        size_t _parallelGrain{64};
+        bool _strictPriorities{false};
+
+        //! Scheduled targets that are parallel safe or main thread only.
+        // While 0 there is no plan.
+        size_t _plannedTargets{0};
+        bool _planDirty{true};
+        //! All TimingTargets ordered by level.
+        std::vector<TimingTarget*> _plan;
+        std::vector<Level> _levels;
+        //! Scratch for [_buildPlan], kept to avoid reallocating.
+        std::vector<uint32_t> _targetLevels;
+
+        std::vector<Bucket> _buckets;
+        //! Bucket indices sorted by priority, smallest (highest priority) first.
+        std::vector<uint32_t> _bucketOrder;
+        std::unordered_map<int, uint32_t> _bucketByPriority;
+
+        HandleTable _targetHandles;
+        //! Target id -> handle, for the target based API.
+        IdMap _targetIds;
 
         // #############################################################################
         // UpdateTarget types
         // #############################################################################
-        // Defining a class predicate allows for reuse.
-        struct TimerUnaryPredicate {
-            TimerUnaryPredicate(UpdateTargetSPtr t) : uta(t) {};
-            // Again Timer is only forward declared in this .h file.
-            bool operator() (const std::unique_ptr<Timer>& t);
-
-        private:
-            UpdateTargetSPtr uta;
-        };
+        Timer* _timer(ScheduleHandle handle) const;
+        ScheduleHandle _timerHandle(const UpdateTargetSPtr& target) const;
+        //! A handle for [target], placed now or, while updating, deferred.
+        ScheduleHandle _addTimer(UpdateTargetSPtr target, double interval, int repeatCount, bool autoArm);
+        //! Resets a pooled Timer for [target] and files it, paused unless [autoArm].
+        void _placeTimer(ScheduleHandle handle, const UpdateTargetSPtr& target, double interval, int repeatCount, bool autoArm);
+        void _removeTimer(ScheduleHandle handle);
+        void _releaseTimerHandle(ScheduleHandle handle, int id);
+        //! Moves the timer between the frame and wheel arrays and (re)inserts
+        // it in the wheel. Called after anything that changes its schedule.
+        void _syncTimer(ScheduleHandle handle);
+        void _fireTimer(uint32_t slot);
+
+        //! Timers updated every frame (no interval).
+        static constexpr uint32_t FRAME_TIMERS = 0;
+        //! Timers driven by [_wheel].
+        static constexpr uint32_t WHEEL_TIMERS = 1;
+
+        //! Timers associated with UpdateTargets, by FRAME_TIMERS/WHEEL_TIMERS.
+        std::array<TimerPool, 2> _timerPools;
+        size_t _timerHighWater{0};
+
+        //! Keyed by timer handle slot.
+        TimingWheel _wheel;
+
+        HandleTable _timerHandles;
+        //! UpdateTarget id -> handle.
+        IdMap _timerIds;
+
+        // #############################################################################
+        // Behaviors
+        // #############################################################################
+        void _updateBehaviors(double dt);
+        void _resumeBehavior(uint32_t slot);
+        //! Files the suspended Behavior according to what it awaits.
+        void _parkBehavior(uint32_t slot);
+        void _removeBehavior(ScheduleHandle handle);
+
+        //! Coroutine frames (std::coroutine_handle addresses), stored densely.
+        std::vector<void*> _behaviors;
+        //! The handle slot of each Behavior.
+        std::vector<uint32_t> _behaviorSlots;
+        HandleTable _behaviorHandles;
 
-        //! A pool of Timers associated with UpdateTargets
-        //SmartObjectPool<Timer> _timerPool;
+        //! Behaviors awaiting the next update or polling a condition.
+        std::vector<ScheduleHandle> _waitingBehaviors;
+        //! The previous update's [_waitingBehaviors], being resumed.
+        std::vector<ScheduleHandle> _resumingBehaviors;
+        //! Behaviors awaiting time, keyed by handle slot.
+        TimingWheel _behaviorWheel;
 
-        std::list<std::unique_ptr<Timer>> _updateTargets;
-        //std::list<SmartObjectPool<Timer>::ptr_type> _updateTargets;
+        //! The slot of the Behavior being resumed, if any.
+        uint32_t _runningBehavior{ScheduleHandle::INVALID};
+        bool _stopRunningBehavior{false};
 
         //! toString
         friend std::ostream& operator<<(std::ostream&, const Scheduler&);
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <iomanip>
 #include "timer.h"
+#include "clock.h"
 #include "scheduler.h"
 #include "../../Extensions/math.h"
 
@@ -51,10 +52,6 @@ namespace Ranger {
         _targetGone = false;
     }
 
-    Timer::~Timer() {
-        std::cout << "Timer::~Timer: " << _id << std::endl;
-    }
-
     void Timer::setTarget(UpdateTargetWPtr target, bool paused) {
 
         if (target.expired()) {
@@ -70,8 +67,37 @@ namespace Ranger {
         _targetGone = false;
     }
 
+    void Timer::reset(UpdateTargetWPtr target, double interval, int repeat) {
+        if (target.expired()) {
+            throw std::invalid_argument("A valid UpdateTarget is required.");
+        }
+
+        _target = target;
+        _id = _target.lock()->getId();
+
+        _interval = interval;
+        _repeatCount = repeat;
+        _runForever = repeat == Timer::REPEAT_FOREVER;
+
+        _elapsed = 0;
+        _useDelay = false;
+        _delay = 0.0;
+        _delayComplete = false;
+        _paused = false;
+        _intervalCount = 0;
+        _expired = false;
+        _targetGone = false;
+        _callbackCount = 0;
+        _startedAt = 0.0;
+    }
+
+    void Timer::release() {
+        _target.reset();
+        _targetGone = true;
+    }
+
     void Timer::arm() {
-        _elapsed = 0.0;
+        _elapsed = 0;
         _expired = false;
         _intervalCount = 0;
         _paused = false;
@@ -104,11 +130,12 @@ namespace Ranger {
         if (_paused || _expired)
             return;
 
-        _elapsed += dt;
+        // Integer nanoseconds: summing frame times doesn't drift.
+        _elapsed += Clock::fromMilliseconds(dt);
         //std::cout << "Timer: elapsed " << "id: " << _id << ", " << std::showpoint << std::setprecision(16) << _elapsed << ", " << _intervalCount << std::endl;
 
         if (_useDelay && !_delayComplete) {
-            if (_elapsed >= _delay) {
+            if (_elapsed >= Clock::fromMilliseconds(_delay)) {
                 // Delay completed change state.
                 //std::cout << "Timer: delay complete" << "id: " << _id << ", " << _elapsed << ", " << _interval << std::endl;
                 _delayComplete = true;
@@ -124,7 +151,7 @@ namespace Ranger {
             //UpdateTargetSPtr spTarget(_target);
 
             UpdateTargetSPtr spTarget = _target.lock();
-            spTarget->update(_elapsed);
+            spTarget->update(Clock::toMilliseconds(_elapsed));
         }
         else {
             _targetGone = true;
@@ -133,21 +160,20 @@ namespace Ranger {
 
         if (_runForever) {
             //standard timer usage
-            if (_elapsed >= _interval) {
+            if (_elapsed >= Clock::fromMilliseconds(_interval)) {
                 //std::cout << "Timer: runforever, elapsed " << "id: " << _id << ", " << _elapsed << std::endl;
-                _elapsed = 0.0;
+                _elapsed = 0;
             }
 
             return;
         }
 
-        if ((_interval - _elapsed) < Math::Epsilon) {
-        //if (_elapsed >= _interval) {
+        if (_elapsed >= Clock::fromMilliseconds(_interval)) {
             //std::cout << "Timer: _intervalCount " << "id: " << _id << ", " << _elapsed << ", " << _intervalCount << std::endl;
             //std::cout << "Timer: _interval " << "id: " << _id << ", " << _interval << std::endl;
             //std::cout << "Timer: " << "callback count: " << _callbackCount << std::endl;
             //std::cout << "Timer: " << "_repeatCount count: " << _repeatCount << std::endl;
-            _elapsed = 0.0;
+            _elapsed = 0;
             _intervalCount++;
         }
 
@@ -161,6 +187,50 @@ namespace Ranger {
 
     }
 
+    void Timer::start(double now) {
+        _startedAt = now;
+        if (_useDelay && !_delayComplete)
+            _startedAt += _delay;
+    }
+
+    double Timer::firstDue() const {
+        if (_useDelay && !_delayComplete)
+            return _delay + _interval;
+        return _interval;
+    }
+
+    bool Timer::fire(double now) {
+        if (_paused || _expired)
+            return false;
+
+        _delayComplete = true;
+
+        double elapsed = now - _startedAt;
+        _startedAt = now;
+
+        if (!_target.expired()) {
+            UpdateTargetSPtr spTarget = _target.lock();
+            spTarget->update(elapsed);
+        }
+        else {
+            _targetGone = true;
+            return false;
+        }
+
+        if (_runForever)
+            return true;
+
+        // Same counting as [update]: 0 = once, 1 = (2 x executed)
+        _intervalCount++;
+        if (_intervalCount > _repeatCount) {
+            _expired = true;
+            return false;
+        }
+        _callbackCount++;
+
+        return true;
+    }
+
     //! toString()
     std::ostream& operator<<(std::ostream &os, const Timer &t) {
         return os << "Timer: " <<
@@ -18,8 +18,6 @@ namespace Ranger {
         Timer(UpdateTargetWPtr target, bool paused = false);
         Timer(UpdateTargetWPtr target, double interval, int repeat = Timer::REPEAT_FOREVER, bool paused = false);
 
-        ~Timer();   // suppresses move constructor.
-
         //Timer(Timer& other) = delete;
         //Timer& operator=(Timer& other) = delete;
 
@@ -36,6 +34,15 @@ namespace Ranger {
 
         void setTarget(UpdateTargetWPtr target, bool paused = false);
 
+        //! Reinitializes a pooled Timer as if it was just constructed.
+        /*!
+         * \param interval 0 = every frame.
+         */
+        void reset(UpdateTargetWPtr target, double interval = 0.0, int repeat = Timer::REPEAT_FOREVER);
+
+        //! Drops the target; called when the Timer returns to its pool.
+        void release();
+
         void arm();
         void armWithDelay(double delay);
         void disarm();
@@ -44,8 +51,43 @@ namespace Ranger {
         //! Changes how many times the interval is repeated and re-arms without delay.
         void changeRepeats(int count);
 
+        //! Every frame update. Used by timers without an interval.
         void update(double dt);
 
+        // ------------------------------------------------------------------
+        // Interval timers
+        // ------------------------------------------------------------------
+        // A Timer with an interval is driven by the Scheduler's TimingWheel
+        // instead of [update]; its target is only called when an interval
+        // elapses, with the elapsed time since the previous call.
+
+        //! Starts measuring from [now] (milliseconds), after any pending delay.
+        void start(double now);
+
+        //! Milliseconds from [start] until the first fire, delay included.
+        double firstDue() const;
+
+        //! Calls the target. Returns true if the timer should fire again
+        // after another [interval].
+        bool fire(double now);
+
+        bool hasInterval() const {
+            return _interval > 0.0;
+        }
+
+        double interval() const {
+            return _interval;
+        }
+
+        //! Armed, not paused and not done.
+        bool isActive() const {
+            return !_paused && !_expired && !_targetGone;
+        }
+
+        bool isExpired() const {
+            return _expired;
+        }
+
         bool isPaused() const {
             return _paused;
         }
@@ -68,7 +110,8 @@ namespace Ranger {
          */
         double _interval{0.0};
 
-        double _elapsed{0.0};
+        //! Nanoseconds, @see Clock.
+        int64_t _elapsed{0};
 
         bool _runForever{false};
 
@@ -93,6 +136,9 @@ namespace Ranger {
 
         int64_t _callbackCount{0};
 
+        //! Wheel time the current interval started at.
+        double _startedAt{0.0};
+
         //! toString
         friend std::ostream& operator<<(std::ostream&, const Timer&);
     };
@@ -0,0 +1,128 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TIMER_POOL_H
+#define RANGERALPHA_TIMER_POOL_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "schedule_handle.h"
+#include "timer.h"
+
+namespace Ranger {
+    //! A growable pool of @see Timer(s), stored contiguously.
+    /*!
+     * The live Timers are [0, size()); released Timers stay constructed
+     * past the end and are handed out again, [reset] by the caller, so
+     * schedule/unschedule churn never allocates once the pool has grown to
+     * its high-water mark. Acquire and release are O(1); release swaps the
+     * last live Timer into the hole and fixes its handle.
+     *
+     * Positions, and so Timer addresses, change whenever a Timer is released.
+     */
+    class TimerPool final {
+    public:
+        //! A live Timer for handle [slot]; the caller resets it.
+        uint32_t acquire(uint32_t slot) {
+            uint32_t position = _take(slot);
+            _acquired++;
+            if (position < _constructed)
+                _reused++;
+            _constructed = static_cast<uint32_t>(_timers.size());
+            return position;
+        }
+
+        void release(uint32_t position, HandleTable& handles) {
+            uint32_t last = _size - 1;
+            if (position != last) {
+                std::swap(_timers[position], _timers[last]);
+                _slots[position] = _slots[last];
+                handles.relocate(_slots[position], position);
+            }
+            // Don't keep the target's control block alive.
+            _timers[last].release();
+            _size--;
+        }
+
+        //! Moves the Timer at [position] into [to], returning its new
+        // position there. Not counted as an acquisition.
+        uint32_t moveTo(uint32_t position, TimerPool& to, uint32_t bucket, HandleTable& handles) {
+            uint32_t slot = _slots[position];
+            uint32_t moved = to._take(slot);
+            to._constructed = static_cast<uint32_t>(to._timers.size());
+            to._timers[moved] = _timers[position];
+            release(position, handles);
+            handles.relocate(slot, bucket, moved);
+            return moved;
+        }
+
+        Timer& operator[](uint32_t position) {
+            return _timers[position];
+        }
+
+        const Timer& operator[](uint32_t position) const {
+            return _timers[position];
+        }
+
+        uint32_t slot(uint32_t position) const {
+            return _slots[position];
+        }
+
+        uint32_t size() const {
+            return _size;
+        }
+
+        //! Timers constructed so far, live or not.
+        uint32_t constructed() const {
+            return _constructed;
+        }
+
+        uint64_t acquired() const {
+            return _acquired;
+        }
+
+        //! Acquisitions served by an already constructed Timer.
+        uint64_t reused() const {
+            return _reused;
+        }
+
+        void reserve(size_t count) {
+            _timers.reserve(count);
+            _slots.reserve(count);
+        }
+
+        //! Releases every Timer; the storage is kept.
+        void clear() {
+            for (uint32_t i = 0; i < _size; i++)
+                _timers[i].release();
+            _size = 0;
+        }
+
+    private:
+        uint32_t _take(uint32_t slot) {
+            uint32_t position = _size++;
+            if (position == _timers.size()) {
+                _timers.emplace_back();
+                _slots.push_back(slot);
+            }
+            else {
+                _slots[position] = slot;
+            }
+            return position;
+        }
+
+        std::vector<Timer> _timers;
+        //! The handle slot of each Timer.
+        std::vector<uint32_t> _slots;
+        uint32_t _size{0};
+        uint32_t _constructed{0};
+
+        uint64_t _acquired{0};
+        uint64_t _reused{0};
+    };
+}
+
+#endif //RANGERALPHA_TIMER_POOL_H
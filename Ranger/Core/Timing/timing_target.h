@@ -5,13 +5,29 @@
 #ifndef RANGERALPHA_TIMINGTARGET_H
 #define RANGERALPHA_TIMINGTARGET_H
 
+#include <cstdint>
 #include "update_target.h"
 #include "../../ranger.h"
 
 namespace Ranger {
     //! Interface for timing targets.
+    /*!
+     * By default a target is updated serially, in priority order. A target
+     * can opt in to being updated concurrently with others by declaring what
+     * it touches, @see Scheduler::update:
+     * - [access]: the components it reads and writes. Two targets conflict
+     *   if either writes a component the other reads or writes.
+     * - [parallelGroup]: targets of the same group never conflict with each
+     *   other (ex: independent AI agents) but conflict with everything else.
+     * Declare before scheduling; like the priority, changes take effect when
+     * the target is scheduled again.
+     */
     class TimingTarget : public UpdateTarget {
     public:
+        //! Bit i = component i. What a component is, is up to the app.
+        using ComponentSet = uint64_t;
+
+        static constexpr int NO_GROUP = -1;
         bool isPaused() const {
             return _paused;
         }
@@ -36,6 +52,50 @@ namespace Ranger {
             _priority = SchedulePriority::NORMAL_PRIORITY;
         }
 
+        //---------------------------------------------------------------------
+        // Parallel update
+        //---------------------------------------------------------------------
+        void access(ComponentSet reads, ComponentSet writes) {
+            _reads = reads;
+            _writes = writes;
+            _accessDeclared = true;
+        }
+
+        ComponentSet reads() const {
+            return _reads;
+        }
+
+        ComponentSet writes() const {
+            return _writes;
+        }
+
+        bool isAccessDeclared() const {
+            return _accessDeclared;
+        }
+
+        void parallelGroup(int group) {
+            _group = group;
+        }
+
+        int parallelGroup() const {
+            return _group;
+        }
+
+        //! True if the target may run on a worker thread at all.
+        bool isParallelSafe() const {
+            return _accessDeclared || _group != NO_GROUP;
+        }
+
+        //! Targets making GL calls must be updated on the main thread. They
+        // still take part in the ordering, they just never move to a worker.
+        void mainThreadOnly(bool mainOnly) {
+            _mainThreadOnly = mainOnly;
+        }
+
+        bool isMainThreadOnly() const {
+            return _mainThreadOnly;
+        }
+
         //~TimingTarget() { std::cout << "~TimingTarget" << std::endl;}
 
     protected:
@@ -47,6 +107,12 @@ namespace Ranger {
 
         //! Is this TimingTarget paused.
         bool _paused = false;
+
+        ComponentSet _reads{0};
+        ComponentSet _writes{0};
+        bool _accessDeclared{false};
+        int _group{NO_GROUP};
+        bool _mainThreadOnly{false};
     };
 
 }
@@ -0,0 +1,127 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <cmath>
+
+#include "timing_wheel.h"
+
+namespace Ranger {
+    TimingWheel::TimingWheel(double tick)
+            : _tick(tick) {
+        _heads.fill(INVALID);
+    }
+
+    void TimingWheel::insert(uint32_t id, double delay) {
+        if (id >= _nodes.size())
+            _nodes.resize(id + 1);
+
+        if (contains(id))
+            _unlink(id);
+        else
+            _size++;
+
+        double ticks = std::ceil(delay / _tick);
+        uint64_t delta = ticks < 1.0 ? 1 : static_cast<uint64_t>(ticks);
+
+        _nodes[id].expires = _now + (delta > MAX_DELTA ? MAX_DELTA : delta);
+        _place(id);
+    }
+
+    void TimingWheel::cancel(uint32_t id) {
+        if (!contains(id))
+            return;
+
+        _unlink(id);
+        _size--;
+    }
+
+    void TimingWheel::clear() {
+        _heads.fill(INVALID);
+        for (Node& node : _nodes)
+            node = Node{};
+        _size = 0;
+    }
+
+    void TimingWheel::_step() {
+        _now++;
+
+        uint32_t index = static_cast<uint32_t>(_now & (ROOT_SIZE - 1));
+
+        // The root wrapped; pull the next block of each level down, stopping
+        // at the first level that didn't wrap as well.
+        if (index == 0) {
+            for (uint32_t level = 0; level < LEVELS; level++) {
+                if (_cascade(level) != 0)
+                    break;
+            }
+        }
+
+        uint32_t id;
+        while ((id = _heads[index]) != INVALID) {
+            _unlink(id);
+            _link(id, FIRING);
+        }
+    }
+
+    uint32_t TimingWheel::_cascade(uint32_t level) {
+        uint32_t index = static_cast<uint32_t>((_now >> (ROOT_BITS + level * LEVEL_BITS)) & (LEVEL_SIZE - 1));
+        uint32_t slot = ROOT_SIZE + level * LEVEL_SIZE + index;
+
+        // Every entry in the slot is now closer than this level's span, so
+        // re-placing it lands it in a lower level.
+        uint32_t id;
+        while ((id = _heads[slot]) != INVALID) {
+            _unlink(id);
+            _place(id);
+        }
+
+        return index;
+    }
+
+    void TimingWheel::_place(uint32_t id) {
+        uint64_t expires = _nodes[id].expires;
+        uint64_t delta = expires - _now;
+
+        uint32_t slot;
+        if (delta < ROOT_SIZE) {
+            slot = static_cast<uint32_t>(expires & (ROOT_SIZE - 1));
+        }
+        else {
+            uint32_t level = 0;
+            while (level < LEVELS - 1 && delta >= (uint64_t(1) << (ROOT_BITS + (level + 1) * LEVEL_BITS)))
+                level++;
+
+            uint32_t index = static_cast<uint32_t>((expires >> (ROOT_BITS + level * LEVEL_BITS)) & (LEVEL_SIZE - 1));
+            slot = ROOT_SIZE + level * LEVEL_SIZE + index;
+        }
+
+        _link(id, slot);
+    }
+
+    void TimingWheel::_link(uint32_t id, uint32_t slot) {
+        Node& node = _nodes[id];
+        node.slot = slot;
+        node.prev = INVALID;
+        node.next = _heads[slot];
+
+        if (node.next != INVALID)
+            _nodes[node.next].prev = id;
+
+        _heads[slot] = id;
+    }
+
+    void TimingWheel::_unlink(uint32_t id) {
+        Node& node = _nodes[id];
+
+        if (node.prev != INVALID)
+            _nodes[node.prev].next = node.next;
+        else
+            _heads[node.slot] = node.next;
+
+        if (node.next != INVALID)
+            _nodes[node.next].prev = node.prev;
+
+        node.next = node.prev = node.slot = INVALID;
+    }
+}
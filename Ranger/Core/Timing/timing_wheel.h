@@ -0,0 +1,126 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TIMING_WHEEL_H
+#define RANGERALPHA_TIMING_WHEEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Ranger {
+    //! A hierarchical timing wheel.
+    /*!
+     * Entries are identified by a caller chosen id (the @see Scheduler uses
+     * timer handle slots) and fire once their delay has elapsed.
+     *
+     * Time is quantized into ticks (1ms by default). The wheel has 4 levels:
+     *   level 0: 256 slots of 1 tick          (~256ms)
+     *   level 1:  64 slots of 256 ticks       (~16s)
+     *   level 2:  64 slots of 16384 ticks     (~17min)
+     *   level 3:  64 slots of 1048576 ticks   (~18h)
+     * Each slot is an intrusive doubly linked list so insert and cancel are
+     * O(1). [advance] only visits the level 0 slot of each elapsed tick and,
+     * every 256 ticks, re-distributes (cascades) one higher level slot. The
+     * cost of a frame is therefore proportional to the entries that fire, not
+     * to the entries waiting.
+     *
+     * Delays longer than the top level are clamped to it; the entry then
+     * fires early, at ~18h, rather than being lost.
+     */
+    class TimingWheel final {
+    public:
+        static constexpr uint32_t INVALID = 0xFFFFFFFF;
+
+        //! \param tick milliseconds per tick
+        explicit TimingWheel(double tick = 1.0);
+
+        //! Schedules [id] to fire [delay] milliseconds from now.
+        /*!
+         * If [id] is already in the wheel it is rescheduled. Delays are
+         * rounded up to whole ticks with a minimum of one tick.
+         */
+        void insert(uint32_t id, double delay);
+
+        //! Removes [id] if present.
+        void cancel(uint32_t id);
+
+        bool contains(uint32_t id) const {
+            return id < _nodes.size() && _nodes[id].slot != INVALID;
+        }
+
+        //! Advances time by [dt] milliseconds calling [fire(id)] for every
+        // entry that comes due, tick by tick.
+        /*!
+         * [fire] may insert or cancel entries, including the one firing.
+         */
+        template<typename Fire>
+        void advance(double dt, Fire&& fire) {
+            _remainder += dt / _tick;
+            // Whole ticks only; the fraction carries over to the next call.
+            auto ticks = static_cast<uint64_t>(_remainder);
+            _remainder -= static_cast<double>(ticks);
+
+            while (ticks-- > 0) {
+                _step();
+
+                while (_heads[FIRING] != INVALID) {
+                    uint32_t id = _heads[FIRING];
+                    _unlink(id);
+                    _size--;
+                    fire(id);
+                }
+            }
+        }
+
+        //! Time, in milliseconds, the wheel has advanced through.
+        double now() const {
+            return (static_cast<double>(_now) + _remainder) * _tick;
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        void clear();
+
+    private:
+        static constexpr uint32_t ROOT_BITS = 8;
+        static constexpr uint32_t LEVEL_BITS = 6;
+        static constexpr uint32_t ROOT_SIZE = 1 << ROOT_BITS;
+        static constexpr uint32_t LEVEL_SIZE = 1 << LEVEL_BITS;
+        static constexpr uint32_t LEVELS = 3; // Above the root.
+
+        static constexpr uint32_t SLOTS = ROOT_SIZE + LEVELS * LEVEL_SIZE;
+        //! A pseudo slot holding the entries due on the current tick.
+        static constexpr uint32_t FIRING = SLOTS;
+
+        static constexpr uint64_t MAX_DELTA = (uint64_t(1) << (ROOT_BITS + LEVELS * LEVEL_BITS)) - 1;
+
+        struct Node {
+            uint32_t next{INVALID};
+            uint32_t prev{INVALID};
+            uint32_t slot{INVALID};
+            uint64_t expires{0};
+        };
+
+        void _step();
+        uint32_t _cascade(uint32_t level);
+        void _place(uint32_t id);
+        void _link(uint32_t id, uint32_t slot);
+        void _unlink(uint32_t id);
+
+        double _tick;
+        double _remainder{0.0};
+        uint64_t _now{0};
+
+        std::vector<Node> _nodes;
+        std::array<uint32_t, SLOTS + 1> _heads;
+
+        size_t _size{0};
+    };
+}
+
+#endif //RANGERALPHA_TIMING_WHEEL_H
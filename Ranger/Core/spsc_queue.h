@@ -0,0 +1,78 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_SPSC_QUEUE_H
+#define RANGERALPHA_SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Ranger {
+    //! A bounded FIFO from one producer thread to one consumer thread.
+    /*!
+     * Lock-free: each side owns one index and only reads the other's, so a
+     * push or pop is a couple of loads and one release store. Each side
+     * also caches the other's index and only reloads it (touching the
+     * other's cache line) when the queue looks full or empty.
+     *
+     * [CAPACITY] must be a power of two. The indices run freely and are
+     * masked, so all CAPACITY slots are usable.
+     */
+    template<typename T, size_t CAPACITY>
+    class SpscQueue final {
+        static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+    public:
+        //! Producer: false, and [item] dropped, if the queue is full.
+        bool tryPush(const T& item) {
+            uint64_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cachedHead == CAPACITY) {
+                _cachedHead = _head.load(std::memory_order_acquire);
+                if (tail - _cachedHead == CAPACITY)
+                    return false;
+            }
+            _items[tail & MASK] = item;
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Consumer: false if the queue is empty.
+        bool tryPop(T& item) {
+            uint64_t head = _head.load(std::memory_order_relaxed);
+            if (head == _cachedTail) {
+                _cachedTail = _tail.load(std::memory_order_acquire);
+                if (head == _cachedTail)
+                    return false;
+            }
+            item = _items[head & MASK];
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //! Approximate unless called from a quiescent state.
+        size_t size() const {
+            return static_cast<size_t>(_tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire));
+        }
+
+        static constexpr size_t capacity() {
+            return CAPACITY;
+        }
+
+    private:
+        static constexpr uint64_t MASK = CAPACITY - 1;
+
+        T _items[CAPACITY];
+
+        // Consumer side.
+        alignas(64) std::atomic<uint64_t> _head{0};
+        uint64_t _cachedTail{0};
+
+        // Producer side.
+        alignas(64) std::atomic<uint64_t> _tail{0};
+        uint64_t _cachedHead{0};
+    };
+}
+
+#endif //RANGERALPHA_SPSC_QUEUE_H
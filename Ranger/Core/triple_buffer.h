@@ -0,0 +1,63 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TRIPLE_BUFFER_H
+#define RANGERALPHA_TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace Ranger {
+    //! Hands the latest value from one writer thread to one reader thread.
+    /*!
+     * Three buffers: the writer fills [back], the reader reads [acquire]'s
+     * and the third sits in the middle holding the latest published one.
+     * Publishing and acquiring are a single atomic exchange each; neither
+     * side ever waits for the other. The reader may skip values (it sees
+     * the latest) and may see the same value twice (nothing new yet).
+     */
+    template<typename T>
+    class TripleBuffer final {
+    public:
+        //! Writer: the buffer to fill. Its content is whatever it held three
+        // publishes ago, reuse it to avoid reallocating.
+        T& back() {
+            return _buffers[_back];
+        }
+
+        //! Writer: makes [back] the latest and gets a new back buffer.
+        void publish() {
+            uint8_t previous = _middle.exchange(static_cast<uint8_t>(_back | FRESH), std::memory_order_acq_rel);
+            _back = previous & INDEX;
+        }
+
+        //! Reader: true if something was published since the last [acquire].
+        bool fresh() const {
+            return (_middle.load(std::memory_order_relaxed) & FRESH) != 0;
+        }
+
+        //! Reader: the latest published buffer. Stays valid, and unchanged,
+        // until the next [acquire].
+        const T& acquire() {
+            if (fresh()) {
+                uint8_t previous = _middle.exchange(_front, std::memory_order_acq_rel);
+                _front = previous & INDEX;
+            }
+            return _buffers[_front];
+        }
+
+    private:
+        static constexpr uint8_t INDEX = 0x3;
+        static constexpr uint8_t FRESH = 0x4;
+
+        T _buffers[3];
+        // Owned by the writer and the reader respectively.
+        uint8_t _back{0};
+        uint8_t _front{1};
+        //! Index of the middle buffer + FRESH if the reader hasn't seen it.
+        alignas(64) std::atomic<uint8_t> _middle{2};
+    };
+}
+
+#endif //RANGERALPHA_TRIPLE_BUFFER_H
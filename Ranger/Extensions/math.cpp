@@ -2,5 +2,21 @@
 // Created by William DeVore on 3/21/16.
 //
 
+#include "math.h"
+
 namespace Ranger {
-}
\ No newline at end of file
+    uint64_t Math::_seed = 1;
+    uint64_t Math::_random = 1;
+
+    void Math::seed(uint64_t seed) {
+        _seed = seed != 0 ? seed : 1;
+
+        // splitmix64, so nearby seeds don't start out alike.
+        uint64_t z = _seed + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        _random = z ^ (z >> 31);
+        if (_random == 0)
+            _random = 1;
+    }
+}
@@ -6,6 +6,7 @@
 #define RANGERBETA_MATH_H
 
 
+#include <cstdint>
 #include <cstdlib>
 #include <math.h>
 
@@ -41,9 +42,24 @@ namespace Ranger {
             return value;
         }
 
+        //! Restarts the random sequence. Replays seed with the recorded
+        // value so they see the same numbers; 0 is treated as 1.
+        static void seed(uint64_t seed);
+
+        static uint64_t seedValue() { return _seed; }
+
+        //! xorshift64*: fast, and the same sequence on every platform, which
+        // rand() isn't. Not thread safe; draw from the simulation only.
+        static uint32_t genInt() {
+            _random ^= _random >> 12;
+            _random ^= _random << 25;
+            _random ^= _random >> 27;
+            return static_cast<uint32_t>((_random * 2685821657736338717ULL) >> 32);
+        }
+
+        //! [0.0, 1.0)
         static float genFloat() {
-            float r = static_cast <float> (rand()) / static_cast <float> (RAND_MAX);
-            return r;
+            return static_cast<float>(genInt() >> 8) * (1.0f / 16777216.0f);
         }
 
         /** Returns true if the value is zero (using the default tolerance as upper bound) */
@@ -64,6 +80,10 @@ namespace Ranger {
             return fabsf(a - b) <= FLOAT_ROUNDING_ERROR;
         }
 
+    private:
+        static uint64_t _seed;
+        static uint64_t _random;
+
     };
 }
 
@@ -2,11 +2,11 @@
 // Created by William DeVore on 3/8/16.
 //
 
-#include <GLFW/glfw3.h>
 #include "time.h"
+#include "../Core/Timing/clock.h"
 
 namespace Ranger {
     double Time::getTime() {
-        return glfwGetTime();
+        return Clock::seconds();
     }
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 namespace Ranger {
 
+    //! Seconds since startup, @see Clock. Doesn't need GLFW.
     class Time {
     public:
         double getTime();
@@ -2,6 +2,7 @@
 // Created by William DeVore on 3/6/16.
 //
 
+#include <algorithm>
 #include <iostream>
 
 // GLEW
@@ -11,6 +12,7 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 
+#include "../Core/Logging/log.h"
 #include "../IO/configuration.h"
 #include "../Rendering/rendercontext.h"
 #include "window.h"
@@ -22,11 +24,11 @@ Window::Window() {}
 
 Window::~Window()
 {
-    std::cout << "Window::~Window" << std::endl;
+    LOG_DEBUG(LogCategory::WINDOW, "Window::~Window");
 
     // Terminate GLFW, clearing any resources allocated by GLFW.
     if (!_destroyed) {
-        std::cout << "Window::~Window terminating GLFW" << std::endl;
+        LOG_DEBUG(LogCategory::WINDOW, "Window::~Window terminating GLFW");
         glfwTerminate();
     }
 
@@ -51,9 +53,8 @@ bool Window::initGLFW(const ConfigurationPtr& config)
 
     // Set all the required options for GLFW.
     if (config->isShowGLInfo())
-        std::cout << "Window::construct "
-                  << "Requesting OpenGL minimum of: " << config->GLMajorVersion()
-                  << "." << config->GLMinorVersion() << std::endl;
+        LOG_INFO(LogCategory::WINDOW, "Window::construct Requesting OpenGL minimum of: {}.{}",
+            config->GLMajorVersion(), config->GLMinorVersion());
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -69,8 +70,7 @@ bool Window::initGLFW(const ConfigurationPtr& config)
         config->title().c_str(), nullptr, nullptr);
 
     if (_window == nullptr) {
-        std::cerr << "Window: "
-                  << "Failed to create GLFW window." << std::endl;
+        LOG_ERROR(LogCategory::WINDOW, "Window: Failed to create GLFW window.");
         // Terminate GLFW, clearing any resources allocated by GLFW.
         glfwTerminate();
         return false;
@@ -100,46 +100,40 @@ bool Window::initGLFW(const ConfigurationPtr& config)
 
     if (config->isShowMonitorInfo()) {
         const GLFWvidmode* mode = glfwGetVideoMode(primary);
-        std::cout << "Monitor refresh rate: " << mode->refreshRate << " Hz"
-                  << std::endl;
-        std::cout << "Monitor colors: "
-                  << "RGB(" << mode->redBits << "," << mode->greenBits << ","
-                  << mode->blueBits << ")" << std::endl;
-        std::cout << "Monitor dimensions: " << mode->width << " x " << mode->height
-                  << std::endl;
+        LOG_INFO(LogCategory::WINDOW, "Monitor refresh rate: {} Hz", mode->refreshRate);
+        LOG_INFO(LogCategory::WINDOW, "Monitor colors: RGB({},{},{})", mode->redBits, mode->greenBits, mode->blueBits);
+        LOG_INFO(LogCategory::WINDOW, "Monitor dimensions: {} x {}", mode->width, mode->height);
 
         int windowWidth;
         int windowHeight;
         glfwGetWindowSize(_window, &windowWidth, &windowHeight);
-        std::cout << "Windowsize: " << windowWidth << " x " << windowHeight << std::endl;
+        LOG_INFO(LogCategory::WINDOW, "Windowsize: {} x {}", windowWidth, windowHeight);
 
-        std::cout << "Framesize: "
-                  << "left-top : " << frameLeft << " x " << frameTop
-                  << ", right-bottom : " << frameRight << " x " << frameBottom << std::endl;
+        LOG_INFO(LogCategory::WINDOW, "Framesize: left-top : {} x {}, right-bottom : {} x {}",
+            frameLeft, frameTop, frameRight, frameBottom);
     }
 
     // Set keyboard callback function
     glfwSetKeyCallback(_window, &Window::KeyPressCallback);
+    glfwSetWindowFocusCallback(_window, &Window::FocusCallback);
+    glfwSetMouseButtonCallback(_window, &Window::MouseButtonCallback);
+    glfwSetCursorPosCallback(_window, &Window::CursorPosCallback);
+    glfwSetScrollCallback(_window, &Window::ScrollCallback);
 
     int joy1Present = glfwJoystickPresent(GLFW_JOYSTICK_1);
     if (joy1Present == GLFW_TRUE) {
-        std::cout << "Window: "
-                  << "Joystick 1 is present " << std::endl;
         const char* name = glfwGetJoystickName(GLFW_JOYSTICK_1);
-        std::cout << "and its name is: '"
-                  << name << "'" << std::endl;
+        LOG_INFO(LogCategory::INPUT, "Window: Joystick 1 is present and its name is: '{}'", name);
     }
 
     int joy2Present = glfwJoystickPresent(GLFW_JOYSTICK_2);
     if (joy2Present == GLFW_TRUE) {
-        std::cout << "Window: "
-                  << "Joystick 2 is present" << std::endl;
+        LOG_INFO(LogCategory::INPUT, "Window: Joystick 2 is present");
     }
 
     int joy3Present = glfwJoystickPresent(GLFW_JOYSTICK_3);
     if (joy3Present == GLFW_TRUE) {
-        std::cout << "Window: "
-                  << "Joystick 3 is present" << std::endl;
+        LOG_INFO(LogCategory::INPUT, "Window: Joystick 3 is present");
     }
 
     return true;
@@ -157,20 +151,20 @@ void Window::initGL(const ConfigurationPtr& config)
     glewInit();
 
     if (config->isShowGLInfo()) {
-        std::cout << "GL Version obtained: " << glGetString(GL_VERSION)
-                  << std::endl;
-        std::cout << "GL vender: " << glGetString(GL_VENDOR) << std::endl;
-        std::cout << "GL renderer: " << glGetString(GL_RENDERER) << std::endl;
-        std::cout << "GLSL version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
+        auto glString = [](GLenum name) {
+            return reinterpret_cast<const char*>(glGetString(name));
+        };
+        LOG_INFO(LogCategory::RENDERING, "GL Version obtained: {}", glString(GL_VERSION));
+        LOG_INFO(LogCategory::RENDERING, "GL vender: {}", glString(GL_VENDOR));
+        LOG_INFO(LogCategory::RENDERING, "GL renderer: {}", glString(GL_RENDERER));
+        LOG_INFO(LogCategory::RENDERING, "GLSL version: {}", glString(GL_SHADING_LANGUAGE_VERSION));
         GLint nrAttributes;
         glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &nrAttributes);
-        std::cout << "Max # of vertex attributes supported: " << nrAttributes
-                  << std::endl;
+        LOG_INFO(LogCategory::RENDERING, "Max # of vertex attributes supported: {}", nrAttributes);
     }
 
     if (config->is_lockToVSync()) {
-        std::cout << "Window: "
-                  << "Locking to VSync." << std::endl;
+        LOG_INFO(LogCategory::WINDOW, "Window: Locking to VSync.");
         glfwSwapInterval(1); // lock to vsync
     }
 
@@ -179,14 +173,13 @@ void Window::initGL(const ConfigurationPtr& config)
     bool initialized = App::renderContext()->initialize();
 
     if (!initialized) {
-        std::cerr << "Window::construct: Failed to initialize render context"
-                  << std::endl;
+        LOG_ERROR(LogCategory::RENDERING, "Window::construct: Failed to initialize render context");
     }
 
     int frameBufWidth;
     int frameBufHeight;
     glfwGetFramebufferSize(_window, &frameBufWidth, &frameBufHeight);
-    std::cout << "FrameBuffer size: " << frameBufWidth << " x " << frameBufHeight << std::endl;
+    LOG_INFO(LogCategory::WINDOW, "FrameBuffer size: {} x {}", frameBufWidth, frameBufHeight);
 }
 
 bool Window::running() const { return !glfwWindowShouldClose(_window); }
@@ -218,13 +211,43 @@ void Window::poll()
     // Will cause any callbacks to be triggered.
     if (Window::_quitTriggered) {
         glfwSetWindowShouldClose(_window, GL_TRUE);
-    } else
+    } else {
         glfwPollEvents();
+        pollJoysticks();
+    }
+}
+
+void Window::pollJoysticks()
+{
+    for (int joystick = 0; joystick < InputSnapshot::JOYSTICKS; joystick++) {
+        if (glfwJoystickPresent(GLFW_JOYSTICK_1 + joystick) != GLFW_TRUE)
+            continue;
+
+        int count;
+        const float* axes = glfwGetJoystickAxes(GLFW_JOYSTICK_1 + joystick, &count);
+        count = std::min(count, InputSnapshot::JOYSTICK_AXES);
+        for (int i = 0; i < count; i++) {
+            if (axes[i] != _axes[joystick][i]) {
+                _axes[joystick][i] = axes[i];
+                _input.axis(joystick, i, axes[i]);
+            }
+        }
+
+        const unsigned char* buttons = glfwGetJoystickButtons(GLFW_JOYSTICK_1 + joystick, &count);
+        count = std::min(count, InputSnapshot::JOYSTICK_BUTTONS);
+        for (int i = 0; i < count; i++) {
+            if (buttons[i] != _buttons[joystick][i]) {
+                _buttons[joystick][i] = buttons[i];
+                _input.joystickButton(joystick, i, buttons[i]);
+            }
+        }
+    }
 }
 
 void Window::keyPressed(int key, int scancode, int action, int mode)
 {
-    std::cout << "keypressed" << std::endl;
+    _input.key(key, action);
+
     if (key == GLFW_KEY_Q && action == GLFW_PRESS) {
         _quitTriggered = true;
     }
@@ -236,6 +259,9 @@ void Window::keyPressed(int key, int scancode, int action, int mode)
 
     if (key == GLFW_KEY_F && action == GLFW_PRESS)
         fillPolyMode = !fillPolyMode;
+
+    if (key == GLFW_KEY_F3 && action == GLFW_PRESS)
+        debugOverlay = !debugOverlay;
 }
 
 void Window::KeyPressCallback(GLFWwindow* win, int key, int scancode,
@@ -245,8 +271,32 @@ void Window::KeyPressCallback(GLFWwindow* win, int key, int scancode,
     window->keyPressed(key, scancode, action, mode);
 }
 
+void Window::FocusCallback(GLFWwindow* win, int focused)
+{
+    Window* window = static_cast<Window*>(glfwGetWindowUserPointer(win));
+    window->_focused = focused == GLFW_TRUE;
+}
+
+void Window::MouseButtonCallback(GLFWwindow* win, int button, int action, int mods)
+{
+    Window* window = static_cast<Window*>(glfwGetWindowUserPointer(win));
+    window->_input.mouseButton(button, action);
+}
+
+void Window::CursorPosCallback(GLFWwindow* win, double x, double y)
+{
+    Window* window = static_cast<Window*>(glfwGetWindowUserPointer(win));
+    window->_input.cursor(x, y);
+}
+
+void Window::ScrollCallback(GLFWwindow* win, double x, double y)
+{
+    Window* window = static_cast<Window*>(glfwGetWindowUserPointer(win));
+    window->_input.scroll(x, y);
+}
+
 void Window::FrameBufferSizeCallback(GLFWwindow* win, int width, int height)
 {
-    std::cout << "FrameBuffer re-size: " << width << " x " << height << std::endl;
+    LOG_INFO(LogCategory::WINDOW, "FrameBuffer re-size: {} x {}", width, height);
 }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #ifndef RANGERALPHA_WINDOW_H
 #define RANGERALPHA_WINDOW_H
 
+#include "../Core/Input/input_queue.h"
 #include "../ranger.h"
 
 class GLFWwindow;
@@ -35,6 +36,16 @@ namespace Ranger {
 
         void keyPressed(int key, int scancode, int action, int mode);
 
+        //! Everything captured by [poll], for the simulation to drain.
+        InputQueue& input() {
+            return _input;
+        }
+
+        //! Whether the window has input focus; the frame pacer idles when not.
+        bool isFocused() const {
+            return _focused;
+        }
+
         //---------------------------------------------------------------------
         // OpenGL related
         //---------------------------------------------------------------------
@@ -45,6 +56,7 @@ namespace Ranger {
         bool toggle{false};
         bool fillPolyMode{true};
         bool drawAllShapes{false};
+        bool debugOverlay{false};
 
         int frameLeft{};
         int frameTop{};
@@ -61,12 +73,29 @@ namespace Ranger {
         // Here are our callbacks.
         static void KeyPressCallback(GLFWwindow* win, int key, int scancode, int action, int mode);
 
+        static void FocusCallback(GLFWwindow* win, int focused);
+
+        static void MouseButtonCallback(GLFWwindow* win, int button, int action, int mods);
+
+        static void CursorPosCallback(GLFWwindow* win, double x, double y);
+
+        static void ScrollCallback(GLFWwindow* win, double x, double y);
+
+        //! Joysticks have no callbacks; queues what changed since last poll.
+        void pollJoysticks();
+
         GLFWwindow* _window;
 
         bool _destroyed{false};
 
         // Window related events
         bool _quitTriggered{false};
+        bool _focused{true};
+
+        InputQueue _input;
+        //! Joystick state as of the last poll.
+        float _axes[InputSnapshot::JOYSTICKS][InputSnapshot::JOYSTICK_AXES]{};
+        unsigned char _buttons[InputSnapshot::JOYSTICKS][InputSnapshot::JOYSTICK_BUTTONS]{};
 
     };
 }
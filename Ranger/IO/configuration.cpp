@@ -83,11 +83,24 @@ void Configuration::configure(const std::string& file)
 
     json11::Json engine = jsonObj["Engine"];
     _loopFor = engine["LoopFor"].int_value();
+    _headless = engine["Headless"].bool_value();
+    if (engine["HeadlessFrames"].int_value() > 0)
+        _headlessFrames = engine["HeadlessFrames"].int_value();
+    _recordInput = engine["RecordInput"].string_value();
+    _replayInput = engine["ReplayInput"].string_value();
+    _replayBaseline = engine["ReplayBaseline"].string_value();
+    _randomSeed = static_cast<uint64_t>(engine["RandomSeed"].number_value());
+    if (engine["AllocWarmupFrames"].is_number())
+        _allocWarmupFrames = engine["AllocWarmupFrames"].int_value();
+    _allocAbort = engine["AllocAbort"].bool_value();
+    if (engine["FrameArenaSize"].is_number())
+        _frameArenaSize = engine["FrameArenaSize"].int_value();
     _engineEnabled = engine["Enabled"].bool_value();
     _showConfig = engine["ShowConfig"].bool_value();
     _showGLInfo = engine["ShowGLInfo"].bool_value();
     _showMonitorInfo = engine["ShowMonitorInfo"].bool_value();
     _showTimingInfo = engine["ShowTimingInfo"].bool_value();
+    _showJoystickInfo = engine["ShowJoystickInfo"].bool_value();
     _GLMajorVersion = engine["GLMajorVersion"].int_value();
     _GLMinorVersion = engine["GLMinorVersion"].int_value();
 
@@ -101,6 +114,37 @@ void Configuration::configure(const std::string& file)
     _viewCentered = camera["Centered"].bool_value();
 
     _FPSRefreshRate = engine["FPSRefreshRate"].number_value();
+    if (engine["AssetUploadBudget"].is_number())
+        _assetUploadBudget = engine["AssetUploadBudget"].number_value();
+    if (engine["TickRate"].number_value() > 0.0)
+        _tickRate = engine["TickRate"].number_value();
+    if (engine["MaxCatchUpSteps"].int_value() > 0)
+        _maxCatchUpSteps = engine["MaxCatchUpSteps"].int_value();
+    if (engine["JobWorkers"].is_number())
+        _jobWorkers = engine["JobWorkers"].int_value();
+    _pipelined = engine["Pipelined"].bool_value();
+    if (engine["FrameLimiter"].is_string())
+        _frameLimiter = engine["FrameLimiter"].string_value();
+    if (engine["TargetFPS"].is_number())
+        _targetFPS = engine["TargetFPS"].number_value();
+    if (engine["IdleFPS"].is_number())
+        _idleFPS = engine["IdleFPS"].number_value();
+    if (engine["SpinMargin"].is_number())
+        _spinMargin = engine["SpinMargin"].number_value();
+    if (engine["FrameBudget"].is_number())
+        _frameBudget = engine["FrameBudget"].number_value();
+    if (engine["FrameStatsWindow"].number_value() > 0.0)
+        _frameStatsWindow = engine["FrameStatsWindow"].number_value();
+    _frameStatsFile = engine["FrameStatsFile"].string_value();
+    _glStatsFile = engine["GLStatsFile"].string_value();
+    _shaderCache = engine["ShaderCache"].string_value();
+
+    json11::Json log = jsonObj["Log"];
+    if (log["Level"].is_string())
+        _logLevel = log["Level"].string_value();
+    _logCategories.clear();
+    for (const auto& category : log["Categories"].object_items())
+        _logCategories.emplace_back(category.first, category.second.string_value());
 
     json11::Json font = jsonObj["Font"];
     _fontPath = font["Path"].string_value();
@@ -108,6 +152,7 @@ void Configuration::configure(const std::string& file)
     _fontSize = font["Size"].int_value();
     _fontScale = font["Scale"].number_value();
     _fontCharsFromSet = font["CharsFromSet"].int_value();
+    _fontCache = font["Cache"].string_value();
 
     //std::cout << *this << std::endl;
 
@@ -191,6 +236,20 @@ std::ostream& operator<<(std::ostream& os, const Configuration& t)
        << "Window position= " << t.windowPositionX() << "," << t.windowPositionY() << endl
        << "Device resolution= " << t.deviceResolutionWidth() << " x " << t.deviceResolutionHeight() << endl
        << "Virtual resolution= " << t.virtualWidth() << " x " << t.virtualHeight() << endl
+       << "Tick rate= " << t.tickRate() << " Hz, max catch up steps= " << t.maxCatchUpSteps() << endl
+       << "Pipelined= " << (t.isPipelined() ? "yes" : "no") << endl
+       << "Headless= " << (t.isHeadless() ? "yes" : "no") << ", " << t.headlessFrames() << " frames" << endl
+       << "Record input= '" << t.recordInput() << "', replay input= '" << t.replayInput()
+       << "' against '" << t.replayBaseline() << "', seed= " << t.randomSeed() << endl
+       << "Frame limiter= " << t.frameLimiter() << " at " << t.targetFPS() << " FPS, idle "
+       << t.idleFPS() << " FPS, spin margin " << t.spinMargin() << " ms" << endl
+       << "Frame budget= " << t.frameBudget() << " ms, stats over " << t.frameStatsWindow() << " s"
+       << (t.frameStatsFile().empty() ? "" : " to ") << t.frameStatsFile() << endl
+       << "GL stats file= " << t.glStatsFile() << endl
+       << "Shader cache= " << t.shaderCache() << endl
+       << "Alloc warm up= " << t.allocWarmupFrames() << " frames" << (t.isAllocAbort() ? ", abort" : "") << endl
+       << "Frame arena= " << t.frameArenaSize() << " KB per thread" << endl
+       << "Log level= " << t.logLevel() << endl
        << "-----------------------------------------------------------------" << endl;
 
     return os;
@@ -13,6 +13,7 @@
 #include "../Rendering/color.h"
 #include "../ranger.h"
 #include "json11.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -139,6 +140,11 @@ public:
         return _lockToVsync;
     }
 
+    void lockToVSync(bool lock)
+    {
+        _lockToVsync = lock;
+    }
+
     bool is_configured() const
     {
         return _configured;
@@ -154,6 +160,72 @@ public:
         _loopFor = loopFor;
     }
 
+    //! Update only, at a fixed dt, with no window, GL or rendering.
+    bool isHeadless() const
+    {
+        return _headless;
+    }
+
+    void headless(bool headless)
+    {
+        _headless = headless;
+    }
+
+    //! Frames a headless run simulates before exiting.
+    int headlessFrames() const
+    {
+        return _headlessFrames;
+    }
+
+    void headlessFrames(int frames)
+    {
+        _headlessFrames = frames;
+    }
+
+    //! Where each simulation frame's input and frame time are recorded;
+    // empty = not recording.
+    const std::string& recordInput() const
+    {
+        return _recordInput;
+    }
+
+    //! A recording to replay, as fast as possible, instead of live input.
+    const std::string& replayInput() const
+    {
+        return _replayInput;
+    }
+
+    //! The frame stats JSON of an earlier run to compare this one against.
+    const std::string& replayBaseline() const
+    {
+        return _replayBaseline;
+    }
+
+    //! Seeds Math's RNG; 0 = a random seed. Replays use the recorded one.
+    uint64_t randomSeed() const
+    {
+        return _randomSeed;
+    }
+
+    //! Frames after which every frame is expected to not allocate; see
+    // AllocTracker, which must be built in.
+    int allocWarmupFrames() const
+    {
+        return _allocWarmupFrames;
+    }
+
+    //! Abort on an allocation in a steady state frame, rather than count it.
+    bool isAllocAbort() const
+    {
+        return _allocAbort;
+    }
+
+    //! Per thread, per frame scratch memory in KB; see FrameArena.
+    int frameArenaSize() const
+    {
+        return _frameArenaSize;
+    }
+
     bool isEngineEnabled() const
     {
         return _engineEnabled;
@@ -199,6 +271,105 @@ public:
         return _FPSRefreshRate;
     }
 
+    //! Milliseconds per frame spent uploading a preloading Scene's assets.
+    double assetUploadBudget() const
+    {
+        return _assetUploadBudget;
+    }
+
+    //! Fixed update steps per second.
+    double tickRate() const
+    {
+        return _tickRate;
+    }
+
+    //! Most fixed update steps run in one frame before time is dropped.
+    int maxCatchUpSteps() const
+    {
+        return _maxCatchUpSteps;
+    }
+
+    //! Job system worker threads; -1 = one per core minus one.
+    int jobWorkers() const
+    {
+        return _jobWorkers;
+    }
+
+    //! Update frame N+1 on its own thread while frame N renders.
+    bool isPipelined() const
+    {
+        return _pipelined;
+    }
+
+    //! "Off" (vsync paces), "Limit" or "Adaptive"; see FramePacer.
+    const std::string& frameLimiter() const
+    {
+        return _frameLimiter;
+    }
+
+    double targetFPS() const
+    {
+        return _targetFPS;
+    }
+
+    //! FPS while the window is unfocused; 0 = no low power idling.
+    double idleFPS() const
+    {
+        return _idleFPS;
+    }
+
+    //! Ms spun, rather than slept, before a frame deadline.
+    double spinMargin() const
+    {
+        return _spinMargin;
+    }
+
+    //! A frame over this many ms is a hitch; 0 = 1.5 periods at TargetFPS,
+    // what the FramePacer counts as late.
+    double frameBudget() const
+    {
+        if (_frameBudget > 0.0)
+            return _frameBudget;
+        return 1.5 * 1000.0 / (_targetFPS > 0.0 ? _targetFPS : 60.0);
+    }
+
+    //! Seconds of frames the frame time percentiles cover.
+    double frameStatsWindow() const
+    {
+        return _frameStatsWindow;
+    }
+
+    //! Where the whole run's frame time histograms are written at exit;
+    // empty = nowhere.
+    const std::string& frameStatsFile() const
+    {
+        return _frameStatsFile;
+    }
+
+    //! Where GLStats are written at exit, when built in; empty = nowhere.
+    const std::string& glStatsFile() const
+    {
+        return _glStatsFile;
+    }
+
+    //! Directory of linked program binaries; empty = compile every launch.
+    const std::string& shaderCache() const
+    {
+        return _shaderCache;
+    }
+
+    //! The level of every log category, see Log::parseLevel.
+    const std::string& logLevel() const
+    {
+        return _logLevel;
+    }
+
+    //! Category name -> level overrides.
+    const std::vector<std::pair<std::string, std::string>>& logCategories() const
+    {
+        return _logCategories;
+    }
+
     const Color& clearColor() const
     {
         return _clearColor;
@@ -234,6 +405,12 @@ public:
         return _fontCharsFromSet;
     }
 
+    //! The baked glyph cache; empty = rasterize every launch.
+    const std::string& fontCache() const
+    {
+        return _fontCache;
+    }
+
 private:
     jO _setToDefault();
 
@@ -267,14 +444,41 @@ private:
     int _fontSize{ 16 };
     int _fontCharsFromSet{ 128 };
     float _fontScale{1.0f};
+    std::string _fontCache;
     
     bool _lockToVsync{ true };
     double _FPSRefreshRate{};
+    double _assetUploadBudget{ 2.0 };
+    double _tickRate{ 60.0 };
+    int _maxCatchUpSteps{ 5 };
+    int _jobWorkers{ -1 };
+    bool _pipelined{ false };
+    std::string _frameLimiter{ "Off" };
+    double _targetFPS{ 60.0 };
+    double _idleFPS{ 10.0 };
+    double _spinMargin{ 1.0 };
+    double _frameBudget{ 0.0 };
+    double _frameStatsWindow{ 10.0 };
+    std::string _frameStatsFile;
+    std::string _glStatsFile;
+    std::string _shaderCache;
+
+    std::string _logLevel{ "Info" };
+    std::vector<std::pair<std::string, std::string>> _logCategories;
 
     //! toString
     friend std::ostream& operator<<(std::ostream&, const Configuration&);
 
     int _loopFor{ -1 };
+    bool _headless{ false };
+    int _headlessFrames{ 3600 };
+    std::string _recordInput;
+    std::string _replayInput;
+    std::string _replayBaseline;
+    uint64_t _randomSeed{ 0 };
+    int _allocWarmupFrames{ 300 };
+    bool _allocAbort{ false };
+    int _frameArenaSize{ 256 };
     bool _engineEnabled{ true };
     bool _showConfig{ false };
     bool _showGLInfo{ false };
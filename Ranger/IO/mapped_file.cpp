@@ -0,0 +1,46 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.h"
+
+namespace Ranger {
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive.
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    _data = static_cast<const uint8_t*>(mapped);
+    _size = size_t(info.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_data)
+        ::munmap(const_cast<uint8_t*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+}
+}
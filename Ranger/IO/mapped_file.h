@@ -0,0 +1,70 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_MAPPED_FILE_H
+#define RANGERALPHA_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Ranger {
+//! A whole file mapped read only into memory.
+/*!
+ * The OS pages it in as it is read, nothing is copied; cheaper than
+ * streaming a file into a buffer when it is read once, start to end.
+ */
+class MappedFile final {
+public:
+    MappedFile() = default;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    //! False if [path] can't be opened or mapped, or is empty.
+    bool open(const std::string& path);
+
+    void close();
+
+    bool isOpen() const
+    {
+        return _data != nullptr;
+    }
+
+    const uint8_t* data() const
+    {
+        return _data;
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+private:
+    const uint8_t* _data{ nullptr };
+    size_t _size{ 0 };
+};
+
+//! Where an FNV-1a hash starts.
+constexpr uint64_t FNV1A_BASIS = 0xcbf29ce484222325ULL;
+
+//! 64 bit FNV-1a of [size] bytes, continuing from [hash].
+inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV1A_BASIS)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+}
+
+#endif //RANGERALPHA_MAPPED_FILE_H
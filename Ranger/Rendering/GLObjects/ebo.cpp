@@ -12,13 +12,13 @@ namespace Ranger {
 
     void EBO::gen() {
         if (!_genBound) {
-            glGenBuffers(1, &_eboId);
+            gl::genBuffers(1, &_eboId, "EBO");
             _genBound = true;
         }
     }
 
     void EBO::bind(const MeshSPtr &mesh) {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _eboId);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->indices.size() * sizeof(GLuint), &mesh->indices[0], GL_STATIC_DRAW);
+        gl::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, _eboId);
+        gl::bufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->indices.size() * sizeof(GLuint), &mesh->indices[0], GL_STATIC_DRAW);
     }
 }
@@ -10,6 +10,7 @@
 #include <GL/glew.h>
 #include <iostream>
 #include "../../ranger.h"
+#include "../gl_stats.h"
 
 namespace Ranger {
     class Mesh;
@@ -21,7 +22,7 @@ namespace Ranger {
 
         virtual ~EBO() {
             if (_genBound)
-                glDeleteBuffers(1, &_eboId);
+                gl::deleteBuffers(1, &_eboId);
             std::cout << "~EBO" << std::endl;
         }
 
@@ -0,0 +1,62 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include "fbo.h"
+#include "../gl_stats.h"
+
+namespace Ranger {
+bool FBO::gen(int width, int height)
+{
+    release();
+
+    _width = width;
+    _height = height;
+
+    gl::genTextures(1, &_textureId, "FBO");
+    gl::bindTexture(GL_TEXTURE_2D, _textureId);
+    gl::texImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    gl::bindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &_fboId);
+    gl::bindFramebuffer(GL_FRAMEBUFFER, _fboId);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _textureId, 0);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    gl::bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    _genBound = true;
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "FBO::gen: framebuffer incomplete, status: " << status << std::endl;
+        release();
+        return false;
+    }
+
+    return true;
+}
+
+void FBO::release()
+{
+    if (!_genBound)
+        return;
+
+    glDeleteFramebuffers(1, &_fboId);
+    gl::deleteTextures(1, &_textureId);
+    _genBound = false;
+}
+
+void FBO::bind()
+{
+    gl::bindFramebuffer(GL_FRAMEBUFFER, _fboId);
+}
+
+void FBO::unBind()
+{
+    gl::bindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+}
@@ -0,0 +1,62 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_FBO_H
+#define RANGERALPHA_FBO_H
+
+#include <GL/glew.h>
+#include <iostream>
+
+namespace Ranger {
+//! An offscreen framebuffer with a single RGBA color texture attached.
+class FBO final {
+public:
+    FBO() = default;
+
+    virtual ~FBO()
+    {
+        release();
+        std::cout << "~FBO" << std::endl;
+    }
+
+    //! Generates the framebuffer and its texture. Returns false if the
+    // framebuffer is incomplete.
+    bool gen(int width, int height);
+
+    void release();
+
+    //! Redirects rendering into the texture.
+    void bind();
+
+    //! Restores rendering to the default framebuffer.
+    void unBind();
+
+    GLuint texture() const
+    {
+        return _textureId;
+    }
+
+    int width() const
+    {
+        return _width;
+    }
+
+    int height() const
+    {
+        return _height;
+    }
+
+private:
+    // Indicate if an Id has been generated yet.
+    bool _genBound = false;
+
+    GLuint _fboId{};
+    GLuint _textureId{};
+
+    int _width{};
+    int _height{};
+};
+}
+
+#endif // RANGERALPHA_FBO_H
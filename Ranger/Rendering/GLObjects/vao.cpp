@@ -4,6 +4,7 @@
 
 #include "vao.h"
 #include "../../Rendering/Vectors/vector_shape.h"
+#include "../gl_stats.h"
 #include "mesh.h"
 
 namespace Ranger {
@@ -30,7 +31,7 @@ namespace Ranger {
 
         // Bind the Vertex Array Object first, then bind and set vertex buffer(s)
         // and attribute pointer(s).
-        glBindVertexArray(_vaoId);
+        gl::bindVertexArray(_vaoId);
 
         _mesh->bind();
 
@@ -40,11 +41,11 @@ namespace Ranger {
 
         // Note that this is allowed, the call to glVertexAttribPointer registered VBO as the currently bound
         // vertex buffer object so afterwards we can safely unbind
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        gl::bindBuffer(GL_ARRAY_BUFFER, 0);
 
         // Unbind VAO (it's always a good thing to unbind any buffer/array to prevent strange bugs),
         // remember: do NOT unbind the EBO, keep it bound to this VAO
-        glBindVertexArray(0);
+        gl::bindVertexArray(0);
     }
 
 
@@ -57,20 +58,20 @@ namespace Ranger {
     }
 
     void VAO::draw(int primitiveType, int offset, int count) {
-        glBindVertexArray(_vaoId);
-        glDrawElements(primitiveType, count, GL_UNSIGNED_INT, (const GLvoid*)(offset));
-        glBindVertexArray(0);
+        gl::bindVertexArray(_vaoId);
+        gl::drawElements(primitiveType, count, GL_UNSIGNED_INT, (const GLvoid*)(offset));
+        gl::bindVertexArray(0);
     }
 
     void VAO::use() {
-        glBindVertexArray(_vaoId);
+        gl::bindVertexArray(_vaoId);
     }
 
     void VAO::unUse() {
         // See opengl wiki as to why "glBindVertexArray(0)" isn't really necessary here:
         // https://www.opengl.org/wiki/Vertex_Specification#Vertex_Buffer_Object
         // Note the line "Changing the GL_ARRAY_BUFFER binding changes nothing about vertex attribute 0..."
-        glBindVertexArray(0);
+        gl::bindVertexArray(0);
     }
 
     void VAO::render(const VectorShapeSPtr &shape) {
@@ -85,7 +86,7 @@ namespace Ranger {
         // Rather than multiply repeatedly
         //glDrawElements(_shape->primitiveType, _shape->count, GL_UNSIGNED_INT, (const GLvoid*)(_shape->offset * sizeof(unsigned int)));
         // we use a pre computed version.
-        glDrawElements(shape->primitiveType, shape->count, GL_UNSIGNED_INT, (const GLvoid*)(shape->offset()));
+        gl::drawElements(shape->primitiveType, shape->count, GL_UNSIGNED_INT, (const GLvoid*)(shape->offset()));
     }
 
 
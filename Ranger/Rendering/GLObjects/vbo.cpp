@@ -13,14 +13,14 @@ void VBO::construct()
 void VBO::gen()
 {
     if (!_genBound) {
-        glGenBuffers(1, &_vboId);
+        gl::genBuffers(1, &_vboId, "VBO");
         _genBound = true;
     }
 }
 
 void VBO::bind(const MeshSPtr& mesh)
 {
-    glBindBuffer(GL_ARRAY_BUFFER, _vboId);
-    glBufferData(GL_ARRAY_BUFFER, mesh->vertices.size() * sizeof(GLfloat), &mesh->vertices[0], GL_STATIC_DRAW);
+    gl::bindBuffer(GL_ARRAY_BUFFER, _vboId);
+    gl::bufferData(GL_ARRAY_BUFFER, mesh->vertices.size() * sizeof(GLfloat), &mesh->vertices[0], GL_STATIC_DRAW);
 }
 }
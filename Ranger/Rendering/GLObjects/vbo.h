@@ -10,6 +10,7 @@
 #include <GL/glew.h>
 #include <iostream>
 #include "../../ranger.h"
+#include "../gl_stats.h"
 
 namespace Ranger {
     class VBO final {
@@ -19,7 +20,7 @@ namespace Ranger {
 
         virtual ~VBO() {
             if (_genBound)
-                glDeleteBuffers(1, &_vboId);
+                gl::deleteBuffers(1, &_vboId);
             std::cout << "~VBO" << std::endl;
         }
 
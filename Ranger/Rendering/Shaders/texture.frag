@@ -0,0 +1,9 @@
+#version 400 core
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D layer;
+
+void main() {
+    color = texture(layer, TexCoords);
+}
@@ -0,0 +1,16 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#include "texture_shader.h"
+
+namespace Ranger {
+void TextureShader::load()
+{
+    _load("Ranger/Rendering/Shaders/texture.vs", "Ranger/Rendering/Shaders/texture.frag");
+}
+
+void TextureShader::postUse()
+{
+}
+}
@@ -0,0 +1,24 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEXTURE_SHADER_H
+#define RANGERALPHA_TEXTURE_SHADER_H
+
+#include "../shader.h"
+
+namespace Ranger {
+class TextureShader final : public Shader {
+
+public:
+    virtual void postUse() override;
+
+    TextureShader() = default;
+
+    virtual ~TextureShader() = default;
+
+    virtual void load() override;
+};
+}
+
+#endif //RANGERALPHA_TEXTURE_SHADER_H
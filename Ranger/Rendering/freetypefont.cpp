@@ -1,223 +1,392 @@
 //
 // Created by William DeVore on 10/25/17.
 //
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 
+#include "../Core/Logging/log.h"
+#include "../Core/Memory/frame_arena.h"
+#include "../Core/Timing/clock.h"
 #include "../IO/configuration.h"
+#include "../IO/mapped_file.h"
 #include "../Rendering/Shaders/font_shader.h"
+#include "../Rendering/gl_stats.h"
 #include "../ranger.h"
 
 #include "freetypefont.h"
 
 namespace Ranger {
+namespace {
+    // The glyph cache: a header, one CacheGlyph per code, then the atlas
+    // rows. Native byte order; it is only ever read where it was baked.
+    constexpr char CACHE_MAGIC[4] = { 'R', 'N', 'G', 'G' };
+    constexpr uint32_t CACHE_VERSION = 1;
+
+    struct CacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t fontHash;
+        uint32_t pixelSize;
+        uint32_t glyphs;
+        uint32_t width;
+        uint32_t height;
+    };
+
+    struct CacheGlyph {
+        int32_t size[2];
+        int32_t bearing[2];
+        uint32_t advance;
+        float uv[4];
+    };
+}
+
 FreeTypeFont::FreeTypeFont()
 {
 }
 
 FreeTypeFont::~FreeTypeFont()
 {
+    if (_atlas != 0)
+        gl::deleteTextures(1, &_atlas);
+    if (VBO != 0)
+        gl::deleteBuffers(1, &VBO);
+    if (VAO != 0)
+        glDeleteVertexArrays(1, &VAO);
     std::cout << "FreeTypeFont::~FreeTypeFont" << std::endl;
 }
 
 bool FreeTypeFont::initialize()
+{
+    Clock::Ticks start = Clock::now();
+
+    // Compiles while the glyphs load; waited on at the uniform lookups.
+    _fontShader = std::make_shared<FontShader>();
+    _fontShader->load();
+
+    const ConfigurationPtr& config = App::config();
+    std::string fontPath = config->fontPath() + config->fontName();
+
+    // FreeType reads the face straight from the mapping, and the hash that
+    // keys the cache costs one pass over pages already in.
+    MappedFile font;
+    if (!font.open(fontPath)) {
+        LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: could not open '{}'", fontPath);
+        return false;
+    }
+    uint64_t fontHash = fnv1a(font.data(), font.size());
+
+    const std::string& cachePath = config->fontCache();
+    bool warm = !cachePath.empty() && _readCache(cachePath, fontHash);
+
+    if (!warm) {
+        std::vector<uint8_t> pixels;
+        if (!_bake(font.data(), font.size(), pixels))
+            return false;
+
+        _uploadAtlas(pixels.data());
+
+        if (!cachePath.empty() && !_writeCache(cachePath, fontHash, pixels))
+            LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: could not write glyph cache '{}'", cachePath);
+    }
+
+    LOG_INFO(LogCategory::RENDERING, "FreeType initialized: {} glyphs {}, {}x{} atlas in {} ms",
+        _characters.size(), warm ? "from cache" : "baked", _atlasWidth, _atlasHeight,
+        Clock::toMilliseconds(Clock::now() - start));
+
+    _colorLoc = glGetUniformLocation(_fontShader->program(), "textColor");
+
+    // Configure VAO/VBO for texture quads
+    glGenVertexArrays(1, &VAO);
+    gl::genBuffers(1, &VBO, "FreeTypeFont");
+    gl::bindVertexArray(VAO);
+    gl::bindBuffer(GL_ARRAY_BUFFER, VBO);
+    gl::bufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+    gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+    gl::bindVertexArray(0);
+
+    _mvpLoc = glGetUniformLocation(_fontShader->program(), "projection");
+
+    return true;
+}
+
+bool FreeTypeFont::_bake(const uint8_t* font, size_t size, std::vector<uint8_t>& pixels)
 {
     FT_Library ft;
 
     FT_Error ftError = FT_Init_FreeType(&ft);
     if (ftError != 0) {
-        std::cerr << "Could not init FreeType library" << std::endl;
+        LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: could not init the FreeType library");
         return false;
     }
 
     FT_Face face;
-
-    const ConfigurationPtr& config = App::config();
-    std::string fontPath = config->fontPath() + config->fontName();
-    ftError = FT_New_Face(ft, fontPath.c_str(), 0, &face);
-
+    ftError = FT_New_Memory_Face(ft, font, FT_Long(size), 0, &face);
     if (ftError != 0) {
-        std::cerr << "Could not open '" << fontPath << "' FreeType library. Error code: " << ftError << ""
-                  << std::endl;
+        LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: could not load the font face. Error code: {}", ftError);
+        FT_Done_FreeType(ft);
         return false;
     }
 
+    const ConfigurationPtr& config = App::config();
     FT_Set_Pixel_Sizes(face, 0, config->fontSize());
 
-    int gened = genCharacters(face, config->fontCharsFromSet());
+    // Shelf packed in code order; UVs are in texels until the height is known.
+    int charsFromSet = std::max(config->fontCharsFromSet(), 0);
+    _characters.assign(charsFromSet, Character{});
+    pixels.clear();
 
-    if (gened != -1) {
-        std::cerr << "Could not generate font characters: (" << gened << ")" << std::endl;
-        return false;
+    FT_GlyphSlot g = face->glyph;
+    int x = PADDING;
+    int y = PADDING;
+    int shelf = 0;
+    bool baked = true;
+
+    for (int c = 0; c < charsFromSet; c++) {
+        if (FT_Load_Char(face, FT_ULong(c), FT_LOAD_RENDER)) {
+            LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: failed to load glyph ({})", c);
+            baked = false;
+            break;
+        }
+
+        int w = int(g->bitmap.width);
+        int h = int(g->bitmap.rows);
+        if (w > ATLAS_WIDTH - 2 * PADDING) {
+            LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: glyph ({}) is wider than the atlas", c);
+            baked = false;
+            break;
+        }
+
+        if (x + w + PADDING > ATLAS_WIDTH) {
+            x = PADDING;
+            y += shelf + PADDING;
+            shelf = 0;
+        }
+
+        pixels.resize(std::max(pixels.size(), size_t(y + h + PADDING) * ATLAS_WIDTH), 0);
+        for (int row = 0; row < h; row++)
+            std::memcpy(&pixels[size_t(y + row) * ATLAS_WIDTH + x], g->bitmap.buffer + row * g->bitmap.pitch, w);
+
+        _characters[c] = Character{
+            glm::vec4(x, y, x + w, y + h),
+            glm::ivec2(w, h),
+            glm::ivec2(g->bitmap_left, g->bitmap_top),
+            static_cast<GLuint>(g->advance.x)
+        };
+
+        x += w + PADDING;
+        shelf = std::max(shelf, h);
     }
 
     // Now release resources. NOTE: We release in reverse order,
     // first Face then Type.
     ftError = FT_Done_Face(face);
     if (ftError != 0) {
-        std::cerr << "Could not free FontFace resources" << std::endl;
+        LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: could not free FontFace resources");
     }
 
     ftError = FT_Done_FreeType(ft);
     if (ftError != 0) {
-        std::cerr << "Could not free FreeType resources" << std::endl;
+        LOG_ERROR(LogCategory::RENDERING, "FreeTypeFont: could not free FreeType resources");
     }
 
-    std::cout << "FreeType initialized" << std::endl;
+    if (!baked)
+        return false;
 
-    _fontShader = std::make_shared<FontShader>();
-    _fontShader->load();
+    _atlasWidth = ATLAS_WIDTH;
+    _atlasHeight = y + shelf + PADDING;
+    pixels.resize(size_t(_atlasWidth) * _atlasHeight, 0);
 
-    std::cout << "Font shader loaded" << std::endl;
+    float width = float(_atlasWidth);
+    float height = float(_atlasHeight);
+    for (Character& ch : _characters)
+        ch.UV = glm::vec4(ch.UV.x / width, ch.UV.y / height, ch.UV.z / width, ch.UV.w / height);
 
-    _colorLoc = glGetUniformLocation(_fontShader->program(), "textColor");
+    return true;
+}
 
+void FreeTypeFont::_uploadAtlas(const uint8_t* pixels)
+{
     // Disable byte-alignment restriction
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-    // Configure VAO/VBO for texture quads
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-
-    _mvpLoc = glGetUniformLocation(_fontShader->program(), "projection");
-
-    return true;
+    gl::genTextures(1, &_atlas, "FreeTypeFont");
+    gl::bindTexture(GL_TEXTURE_2D, _atlas);
+    gl::texImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_RED,
+        _atlasWidth,
+        _atlasHeight,
+        0,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        pixels);
+    // Set texture options
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    gl::bindTexture(GL_TEXTURE_2D, 0);
 }
 
-int FreeTypeFont::genCharacters(const FT_Face& face, int charsFromSet)
+bool FreeTypeFont::_readCache(const std::string& path, uint64_t fontHash)
 {
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
-    FT_GlyphSlot g = face->glyph;
+    MappedFile cache;
+    if (!cache.open(path) || cache.size() < sizeof(CacheHeader))
+        return false;
 
-    for (GLubyte c = 0; c < charsFromSet; c++) {
-        // Load character glyph
-        if (FT_Load_Char(face, c, FT_LOAD_RENDER)) {
-            std::cerr << "ERROR::FREETYTPE: Failed to load Glyph" << std::endl;
-            return c;
-        }
-        // Generate texture
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            g->bitmap.width,
-            g->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            g->bitmap.buffer);
-        // Set texture options
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        // Now store character for later use
-        Character character = {
-            texture,
-            glm::ivec2(g->bitmap.width, g->bitmap.rows),
-            glm::ivec2(g->bitmap_left, g->bitmap_top),
-            static_cast<GLuint>(g->advance.x)
-        };
-        _characters.insert(std::pair<GLchar, Character>(c, std::move(character)));
-    }
+    CacheHeader header;
+    std::memcpy(&header, cache.data(), sizeof(CacheHeader));
 
-    return -1;
-}
+    const ConfigurationPtr& config = App::config();
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != CACHE_VERSION
+        || header.fontHash != fontHash
+        || header.pixelSize != uint32_t(config->fontSize())
+        || header.glyphs != uint32_t(std::max(config->fontCharsFromSet(), 0))
+        || header.width == 0 || header.height == 0)
+        return false;
 
-void FreeTypeFont::renderText(const glm::mat4& vp, const std::string& text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3& color)
-{
-    // Activate corresponding render state
-    _fontShader->use();
+    // A short (interrupted) or padded file is as good as a stale one.
+    size_t expected = sizeof(CacheHeader) + header.glyphs * sizeof(CacheGlyph) + size_t(header.width) * header.height;
+    if (cache.size() != expected)
+        return false;
 
-    glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(vp));
+    const uint8_t* at = cache.data() + sizeof(CacheHeader);
+    _characters.resize(header.glyphs);
+    for (Character& ch : _characters) {
+        CacheGlyph glyph;
+        std::memcpy(&glyph, at, sizeof(CacheGlyph));
+        at += sizeof(CacheGlyph);
+
+        ch = Character{
+            glm::vec4(glyph.uv[0], glyph.uv[1], glyph.uv[2], glyph.uv[3]),
+            glm::ivec2(glyph.size[0], glyph.size[1]),
+            glm::ivec2(glyph.bearing[0], glyph.bearing[1]),
+            glyph.advance
+        };
+    }
 
-    glUniform3f(_colorLoc, color.x, color.y, color.z);
+    _atlasWidth = int(header.width);
+    _atlasHeight = int(header.height);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
-
-    GLuint vertexCount = sizeof(_vertices);
-    _vertices[0][2] = 0.0;
-    _vertices[0][3] = 0.0;
-    _vertices[1][2] = 0.0;
-    _vertices[1][3] = 1.0;
-    _vertices[2][2] = 1.0;
-    _vertices[2][3] = 1.0;
-    _vertices[3][2] = 0.0;
-    _vertices[3][3] = 0.0;
-    _vertices[4][2] = 1.0;
-    _vertices[4][3] = 1.0;
-    _vertices[5][2] = 1.0;
-    _vertices[5][3] = 0.0;
+    // Straight from the mapping; the pages are read once, by the driver.
+    _uploadAtlas(at);
 
-    // Iterate through all characters
-    for (const char& c : text) {
-        Character ch = _characters[c];
+    return true;
+}
 
-        GLfloat xpos = x + ch.Bearing.x * scale;
-        GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+bool FreeTypeFont::_writeCache(const std::string& path, uint64_t fontHash, const std::vector<uint8_t>& pixels)
+{
+    const ConfigurationPtr& config = App::config();
 
-        GLfloat w = ch.Size.x * scale;
-        GLfloat h = ch.Size.y * scale;
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.fontHash = fontHash;
+    header.pixelSize = uint32_t(config->fontSize());
+    header.glyphs = uint32_t(_characters.size());
+    header.width = uint32_t(_atlasWidth);
+    header.height = uint32_t(_atlasHeight);
+
+    // Written aside and renamed over, so a reader never maps half a file.
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+        for (const Character& ch : _characters) {
+            CacheGlyph glyph{
+                { ch.Size.x, ch.Size.y },
+                { ch.Bearing.x, ch.Bearing.y },
+                ch.Advance,
+                { ch.UV.x, ch.UV.y, ch.UV.z, ch.UV.w }
+            };
+            file.write(reinterpret_cast<const char*>(&glyph), sizeof(CacheGlyph));
+        }
+        file.write(reinterpret_cast<const char*>(pixels.data()), std::streamsize(pixels.size()));
 
-        // Update VBO for each character
-        _vertices[0][0] = xpos;
-        _vertices[0][1] = ypos + h;
+        if (!file) {
+            file.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
 
-        _vertices[1][0] = xpos;
-        _vertices[1][1] = ypos;
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
 
-        _vertices[2][0] = xpos + w;
-        _vertices[2][1] = ypos;
+void FreeTypeFont::renderText(const glm::mat4& vp, std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3& color)
+{
+    if (text.empty())
+        return;
 
-        _vertices[3][0] = xpos;
-        _vertices[3][1] = ypos + h;
+    // Lay the whole text out first, into frame scratch, so every glyph
+    // goes up in one upload and down in one draw from the atlas.
+    FrameVector<glm::vec4> vertices;
+    vertices.reserve(6 * text.size());
 
-        _vertices[4][0] = xpos + w;
-        _vertices[4][1] = ypos;
+    // Iterate through all characters
+    for (const char& c : text) {
+        auto code = static_cast<unsigned char>(c);
+        if (code >= _characters.size())
+            continue;
+        const Character& ch = _characters[code];
+
+        // Blanks (space) only advance.
+        if (ch.Size.x > 0 && ch.Size.y > 0) {
+            GLfloat xpos = x + ch.Bearing.x * scale;
+            GLfloat ypos = y - (ch.Size.y - ch.Bearing.y) * scale;
+
+            GLfloat w = ch.Size.x * scale;
+            GLfloat h = ch.Size.y * scale;
+
+            const glm::vec4& uv = ch.UV;
+            vertices.emplace_back(xpos, ypos + h, uv.x, uv.y);
+            vertices.emplace_back(xpos, ypos, uv.x, uv.w);
+            vertices.emplace_back(xpos + w, ypos, uv.z, uv.w);
+
+            vertices.emplace_back(xpos, ypos + h, uv.x, uv.y);
+            vertices.emplace_back(xpos + w, ypos, uv.z, uv.w);
+            vertices.emplace_back(xpos + w, ypos + h, uv.z, uv.y);
+        }
 
-        _vertices[5][0] = xpos + w;
-        _vertices[5][1] = ypos + h;
+        // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+        x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
+    }
 
-        // GLfloat vertices[6][4] = {
-        //     { xpos, ypos + h, 0.0, 0.0 },
-        //     { xpos, ypos, 0.0, 1.0 },
-        //     { xpos + w, ypos, 1.0, 1.0 },
+    if (vertices.empty())
+        return;
 
-        //     { xpos, ypos + h, 0.0, 0.0 },
-        //     { xpos + w, ypos, 1.0, 1.0 },
-        //     { xpos + w, ypos + h, 1.0, 0.0 }
-        // };
+    // Activate corresponding render state
+    _fontShader->use();
 
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.TextureID);
+    glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(vp));
 
-        // Update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, vertexCount, _vertices); // Be sure to use glBufferSubData and not glBufferData
+    glUniform3f(_colorLoc, color.x, color.y, color.z);
 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    gl::activeTexture(GL_TEXTURE0);
+    gl::bindTexture(GL_TEXTURE_2D, _atlas);
+    gl::bindVertexArray(VAO);
 
-        // Render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    // Respecifying the store orphans the one still in use by earlier draws.
+    gl::bindBuffer(GL_ARRAY_BUFFER, VBO);
+    gl::bufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec4), vertices.data(), GL_STREAM_DRAW);
+    gl::bindBuffer(GL_ARRAY_BUFFER, 0);
 
-        // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-        x += (ch.Advance >> 6) * scale; // Bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
-    }
+    gl::drawArrays(GL_TRIANGLES, 0, GLsizei(vertices.size()));
 
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    gl::bindVertexArray(0);
+    gl::bindTexture(GL_TEXTURE_2D, 0);
 }
 
 GLenum FreeTypeFont::_glCheckError()
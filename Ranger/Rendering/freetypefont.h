@@ -4,11 +4,14 @@
 
 #ifndef RANGERALPHA_FREETYPEFONT_H
 #define RANGERALPHA_FREETYPEFONT_H
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
-#include <map>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -19,12 +22,20 @@ namespace Ranger {
 class Shader;
 
 struct Character {
-    GLuint TextureID; // ID handle of the glyph texture
+    glm::vec4 UV; // Left, top, right, bottom of the glyph in the atlas
     glm::ivec2 Size; // Size of glyph
     glm::ivec2 Bearing; // Offset from baseline to left/top of glyph
     GLuint Advance; // Offset to advance to next glyph
 };
 
+//! Text from one atlas texture holding every glyph of the configured set.
+/*!
+ * Rasterizing the set with FreeType takes most of a launch's font setup, so
+ * the packed atlas and the glyph metrics are baked into Font.Cache the
+ * first time and mapped straight back in on later launches. The cache is
+ * keyed by a hash of the font file, the pixel size and the set size; any
+ * mismatch rebakes it.
+ */
 class FreeTypeFont final {
 
 public:
@@ -33,10 +44,23 @@ public:
 
     bool initialize();
 
-    void renderText(const glm::mat4& vp, const std::string& text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3& color);
+    //! Draws [text] with its baseline starting at [x], [y].
+    void renderText(const glm::mat4& vp, std::string_view text, GLfloat x, GLfloat y, GLfloat scale, const glm::vec3& color);
 
 private:
-    int genCharacters(const FT_Face& face, int charFromSet);
+    //! Atlas width; the height is whatever the set needs.
+    static constexpr int ATLAS_WIDTH = 2048;
+    //! Texels between glyphs, so linear filtering doesn't bleed.
+    static constexpr int PADDING = 2;
+
+    //! Loads [path] if it was baked from a font hashing to [fontHash].
+    bool _readCache(const std::string& path, uint64_t fontHash);
+    bool _writeCache(const std::string& path, uint64_t fontHash, const std::vector<uint8_t>& pixels);
+
+    //! Rasterizes the set and packs it into [pixels]; fills the metrics.
+    bool _bake(const uint8_t* font, size_t size, std::vector<uint8_t>& pixels);
+
+    void _uploadAtlas(const uint8_t* pixels);
 
 private:
     const char* glGetErrorString(GLenum error);
@@ -47,13 +71,15 @@ private:
 
     GLuint _mvpLoc;
 
-    GLfloat _vertices[6][4];
-
     FT_UInt _fontSize{ 48 };
     FT_ULong _charsFromSet{ 128 };
-    std::map<GLchar, Character> _characters;
+    //! Indexed by character code.
+    std::vector<Character> _characters;
     GLuint _colorLoc{};
-    GLuint VAO, VBO;
+    GLuint _atlas{};
+    int _atlasWidth{ 0 };
+    int _atlasHeight{ 0 };
+    GLuint VAO{}, VBO{};
 };
 }
 
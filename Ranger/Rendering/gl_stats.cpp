@@ -0,0 +1,364 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <vector>
+
+#include "gl_stats.h"
+
+namespace Ranger {
+namespace {
+    //! A mirrored binding that isn't known.
+    constexpr GLuint UNKNOWN = ~GLuint(0);
+    constexpr int TEXTURE_UNITS = 32;
+
+    struct Resource {
+        const char* owner;
+        uint64_t bytes;
+        //! Textures: the bytes of each mip level specified so far.
+        std::vector<uint64_t> levels{};
+    };
+
+    GLStats::Counters g_current;
+    GLStats::Counters g_frame;
+    GLStats::Counters g_peak;
+    GLStats::Counters g_total;
+    uint64_t g_frames{ 0 };
+
+    GLStats::Resources g_resources;
+    // Ordered so the dump reads in creation order, mostly.
+    std::map<GLuint, Resource> g_buffers;
+    std::map<GLuint, Resource> g_textures;
+
+    GLuint g_arrayBuffer{ UNKNOWN };
+    GLuint g_elementBuffer{ UNKNOWN };
+    GLuint g_vertexArray{ UNKNOWN };
+    GLuint g_framebuffer{ UNKNOWN };
+    GLuint g_program{ UNKNOWN };
+    int g_unit{ 0 };
+    std::array<GLuint, TEXTURE_UNITS> g_textureUnits = [] {
+        std::array<GLuint, TEXTURE_UNITS> units;
+        units.fill(UNKNOWN);
+        return units;
+    }();
+
+    uint64_t primitives(GLenum mode, GLsizei count)
+    {
+        switch (mode) {
+        case GL_TRIANGLES:
+            return count / 3;
+        case GL_TRIANGLE_STRIP:
+        case GL_TRIANGLE_FAN:
+            return count > 2 ? count - 2 : 0;
+        case GL_LINES:
+            return count / 2;
+        case GL_LINE_STRIP:
+            return count > 1 ? count - 1 : 0;
+        case GL_LINE_LOOP:
+            return count > 1 ? count : 0;
+        default:
+            return count;
+        }
+    }
+
+    uint64_t bytesPerPixel(GLint internalFormat)
+    {
+        switch (internalFormat) {
+        case GL_RED:
+        case GL_R8:
+            return 1;
+        case GL_RG:
+        case GL_RG8:
+            return 2;
+        case GL_RGB:
+        case GL_RGB8:
+            return 3;
+        case GL_RGBA16F:
+            return 8;
+        case GL_RGBA32F:
+            return 16;
+        default:
+            return 4;
+        }
+    }
+
+    //! Counts a bind of [object] to [bound], the mirror of its binding point.
+    void bind(GLuint& bound, GLuint object)
+    {
+        g_current.binds++;
+        if (bound == object)
+            g_current.redundant++;
+        bound = object;
+    }
+
+    GLuint& boundBuffer(GLenum target)
+    {
+        static GLuint other{ UNKNOWN };
+        switch (target) {
+        case GL_ARRAY_BUFFER:
+            return g_arrayBuffer;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            return g_elementBuffer;
+        default:
+            other = UNKNOWN;
+            return other;
+        }
+    }
+
+    void resize(GLStats::Resources& resources, std::map<GLuint, Resource>& tracked, GLuint id, uint64_t bytes, bool texture)
+    {
+        auto found = tracked.find(id);
+        if (found == tracked.end())
+            return; // Not made through gl::, or not known which.
+
+        uint64_t& total = texture ? resources.textureBytes : resources.bufferBytes;
+        total = total - found->second.bytes + bytes;
+        found->second.bytes = bytes;
+    }
+
+    void writeCounters(std::ostream& os, const GLStats::Counters& counters, double scale)
+    {
+        os << "{ \"drawCalls\": " << counters.drawCalls * scale
+           << ", \"primitives\": " << counters.primitives * scale
+           << ", \"uploads\": " << counters.uploads * scale
+           << ", \"uploadBytes\": " << counters.uploadBytes * scale
+           << ", \"binds\": " << counters.binds * scale
+           << ", \"textureBinds\": " << counters.textureBinds * scale
+           << ", \"programSwitches\": " << counters.programSwitches * scale
+           << ", \"redundant\": " << counters.redundant * scale << " }";
+    }
+
+    void writeResources(std::ostream& os, const std::map<GLuint, Resource>& tracked)
+    {
+        bool first = true;
+        for (const auto& resource : tracked) {
+            os << (first ? "" : ",") << "\n      { \"id\": " << resource.first << ", \"owner\": \""
+               << resource.second.owner << "\", \"bytes\": " << resource.second.bytes << " }";
+            first = false;
+        }
+        os << "\n    ]";
+    }
+}
+
+void GLStats::Counters::add(const Counters& other)
+{
+    drawCalls += other.drawCalls;
+    primitives += other.primitives;
+    uploads += other.uploads;
+    uploadBytes += other.uploadBytes;
+    binds += other.binds;
+    textureBinds += other.textureBinds;
+    programSwitches += other.programSwitches;
+    redundant += other.redundant;
+}
+
+const GLStats::Counters& GLStats::frame()
+{
+    return g_frame;
+}
+
+const GLStats::Counters& GLStats::peak()
+{
+    return g_peak;
+}
+
+const GLStats::Counters& GLStats::total()
+{
+    return g_total;
+}
+
+uint64_t GLStats::frames()
+{
+    return g_frames;
+}
+
+const GLStats::Resources& GLStats::resources()
+{
+    return g_resources;
+}
+
+void GLStats::endFrame()
+{
+    if constexpr (!ENABLED)
+        return;
+
+    g_frame = g_current;
+    g_total.add(g_current);
+    g_frames++;
+
+    g_peak.drawCalls = std::max(g_peak.drawCalls, g_current.drawCalls);
+    g_peak.primitives = std::max(g_peak.primitives, g_current.primitives);
+    g_peak.uploads = std::max(g_peak.uploads, g_current.uploads);
+    g_peak.uploadBytes = std::max(g_peak.uploadBytes, g_current.uploadBytes);
+    g_peak.binds = std::max(g_peak.binds, g_current.binds);
+    g_peak.textureBinds = std::max(g_peak.textureBinds, g_current.textureBinds);
+    g_peak.programSwitches = std::max(g_peak.programSwitches, g_current.programSwitches);
+    g_peak.redundant = std::max(g_peak.redundant, g_current.redundant);
+
+    g_current = Counters{};
+}
+
+void GLStats::writeJson(std::ostream& os)
+{
+    double perFrame = g_frames > 0 ? 1.0 / double(g_frames) : 0.0;
+
+    os << "{\n"
+       << "  \"frames\": " << g_frames << ",\n"
+       << "  \"total\": ";
+    writeCounters(os, g_total, 1.0);
+    os << ",\n  \"perFrame\": ";
+    writeCounters(os, g_total, perFrame);
+    os << ",\n  \"peak\": ";
+    writeCounters(os, g_peak, 1.0);
+    os << ",\n  \"resources\": {\n"
+       << "    \"bufferBytes\": " << g_resources.bufferBytes << ",\n"
+       << "    \"textureBytes\": " << g_resources.textureBytes << ",\n"
+       << "    \"buffers\": [";
+    writeResources(os, g_buffers);
+    os << ",\n    \"textures\": [";
+    writeResources(os, g_textures);
+    os << "\n  }\n"
+       << "}\n";
+}
+
+bool GLStats::writeJson(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    writeJson(file);
+    return static_cast<bool>(file);
+}
+
+void GLStats::_draw(GLenum mode, GLsizei count)
+{
+    g_current.drawCalls++;
+    g_current.primitives += primitives(mode, count);
+}
+
+void GLStats::_bindBuffer(GLenum target, GLuint buffer)
+{
+    bind(boundBuffer(target), buffer);
+}
+
+void GLStats::_bindVertexArray(GLuint array)
+{
+    bind(g_vertexArray, array);
+    g_elementBuffer = UNKNOWN;
+}
+
+void GLStats::_activeTexture(GLenum unit)
+{
+    g_unit = std::min(int(unit - GL_TEXTURE0), TEXTURE_UNITS - 1);
+}
+
+void GLStats::_bindTexture(GLenum target, GLuint texture)
+{
+    g_current.textureBinds++;
+    bind(g_textureUnits[g_unit], texture);
+}
+
+void GLStats::_bindFramebuffer(GLuint framebuffer)
+{
+    bind(g_framebuffer, framebuffer);
+}
+
+void GLStats::_useProgram(GLuint program)
+{
+    g_current.programSwitches++;
+    if (g_program == program)
+        g_current.redundant++;
+    g_program = program;
+}
+
+void GLStats::_bufferData(GLenum target, GLsizeiptr size)
+{
+    g_current.uploads++;
+    g_current.uploadBytes += size;
+    resize(g_resources, g_buffers, boundBuffer(target), size, false);
+}
+
+void GLStats::_bufferSubData(GLsizeiptr size)
+{
+    g_current.uploads++;
+    g_current.uploadBytes += size;
+}
+
+void GLStats::_texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height)
+{
+    uint64_t bytes = uint64_t(width) * uint64_t(height) * bytesPerPixel(internalFormat);
+    g_current.uploads++;
+    g_current.uploadBytes += bytes;
+
+    if (target != GL_TEXTURE_2D)
+        return;
+
+    // A level specified again replaces its old bytes; the texture is the
+    // sum of its levels.
+    GLuint texture = g_textureUnits[g_unit];
+    auto found = g_textures.find(texture);
+    if (found == g_textures.end() || level < 0)
+        return;
+
+    std::vector<uint64_t>& levels = found->second.levels;
+    if (size_t(level) >= levels.size())
+        levels.resize(size_t(level) + 1, 0);
+    levels[level] = bytes;
+
+    uint64_t total = 0;
+    for (uint64_t levelBytes : levels)
+        total += levelBytes;
+    resize(g_resources, g_textures, texture, total, true);
+}
+
+void GLStats::_genBuffers(GLsizei n, const GLuint* buffers, const char* owner)
+{
+    for (GLsizei i = 0; i < n; i++)
+        g_buffers[buffers[i]] = Resource{ owner, 0 };
+    g_resources.buffers += n;
+}
+
+void GLStats::_deleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    for (GLsizei i = 0; i < n; i++) {
+        auto found = g_buffers.find(buffers[i]);
+        if (found == g_buffers.end())
+            continue;
+        g_resources.buffers--;
+        g_resources.bufferBytes -= found->second.bytes;
+        g_buffers.erase(found);
+
+        // Deleting a bound buffer unbinds it.
+        if (g_arrayBuffer == buffers[i])
+            g_arrayBuffer = 0;
+        if (g_elementBuffer == buffers[i])
+            g_elementBuffer = UNKNOWN;
+    }
+}
+
+void GLStats::_genTextures(GLsizei n, const GLuint* textures, const char* owner)
+{
+    for (GLsizei i = 0; i < n; i++)
+        g_textures[textures[i]] = Resource{ owner, 0 };
+    g_resources.textures += n;
+}
+
+void GLStats::_deleteTextures(GLsizei n, const GLuint* textures)
+{
+    for (GLsizei i = 0; i < n; i++) {
+        auto found = g_textures.find(textures[i]);
+        if (found == g_textures.end())
+            continue;
+        g_resources.textures--;
+        g_resources.textureBytes -= found->second.bytes;
+        g_textures.erase(found);
+
+        std::replace(g_textureUnits.begin(), g_textureUnits.end(), textures[i], GLuint(0));
+    }
+}
+}
@@ -0,0 +1,207 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_GL_STATS_H
+#define RANGERALPHA_GL_STATS_H
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+//! 1 counts the GL calls Rendering/ makes through the gl:: wrappers below
+// and tracks the buffers and textures they create. Off by default.
+#ifndef RANGER_GL_STATS
+#define RANGER_GL_STATS 0
+#endif
+
+namespace Ranger {
+//! GL call and GPU resource accounting, when built with RANGER_GL_STATS.
+/*!
+ * Calls are counted per frame; [endFrame], once per frame after the swap,
+ * publishes them as [frame] and adds them to [total]. Buffers and textures
+ * are tracked from gen to delete with their size (as last specified) and
+ * owner, a string literal naming who made them.
+ *
+ * Binds are mirrored so binding what is already bound counts as redundant.
+ * The element array binding is VAO state, it is forgotten on every VAO
+ * bind.
+ *
+ * The GL thread only. Without the build option every query returns zeros.
+ */
+class GLStats final {
+public:
+    static constexpr bool ENABLED = RANGER_GL_STATS != 0;
+
+    struct Counters {
+        uint64_t drawCalls{ 0 };
+        uint64_t primitives{ 0 };
+        uint64_t uploads{ 0 };
+        uint64_t uploadBytes{ 0 };
+        //! Buffer, vertex array, texture and framebuffer binds.
+        uint64_t binds{ 0 };
+        uint64_t textureBinds{ 0 };
+        uint64_t programSwitches{ 0 };
+        //! Binds and program switches to what was current already.
+        uint64_t redundant{ 0 };
+
+        void add(const Counters& other);
+    };
+
+    struct Resources {
+        uint64_t buffers{ 0 };
+        uint64_t bufferBytes{ 0 };
+        uint64_t textures{ 0 };
+        uint64_t textureBytes{ 0 };
+    };
+
+    //! The last finished frame's.
+    static const Counters& frame();
+
+    //! The most draw calls, uploaded bytes etc. any one frame had.
+    static const Counters& peak();
+
+    static const Counters& total();
+
+    static uint64_t frames();
+
+    //! Live now.
+    static const Resources& resources();
+
+    static void endFrame();
+
+    //! Totals, per frame averages and peaks, and every live resource.
+    static void writeJson(std::ostream& os);
+
+    //! False if [path] can't be written.
+    static bool writeJson(const std::string& path);
+
+    // Called by the gl:: wrappers.
+    static void _draw(GLenum mode, GLsizei count);
+    static void _bindBuffer(GLenum target, GLuint buffer);
+    static void _bindVertexArray(GLuint array);
+    static void _activeTexture(GLenum unit);
+    static void _bindTexture(GLenum target, GLuint texture);
+    static void _bindFramebuffer(GLuint framebuffer);
+    static void _useProgram(GLuint program);
+    static void _bufferData(GLenum target, GLsizeiptr size);
+    static void _bufferSubData(GLsizeiptr size);
+    static void _texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height);
+    static void _genBuffers(GLsizei n, const GLuint* buffers, const char* owner);
+    static void _deleteBuffers(GLsizei n, const GLuint* buffers);
+    static void _genTextures(GLsizei n, const GLuint* textures, const char* owner);
+    static void _deleteTextures(GLsizei n, const GLuint* textures);
+};
+
+//! The GL calls Rendering/ makes, counted by @see GLStats when built in.
+namespace gl {
+    inline void drawArrays(GLenum mode, GLint first, GLsizei count)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_draw(mode, count);
+        glDrawArrays(mode, first, count);
+    }
+
+    inline void drawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_draw(mode, count);
+        glDrawElements(mode, count, type, indices);
+    }
+
+    inline void bindBuffer(GLenum target, GLuint buffer)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_bindBuffer(target, buffer);
+        glBindBuffer(target, buffer);
+    }
+
+    inline void bindVertexArray(GLuint array)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_bindVertexArray(array);
+        glBindVertexArray(array);
+    }
+
+    inline void activeTexture(GLenum unit)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_activeTexture(unit);
+        glActiveTexture(unit);
+    }
+
+    inline void bindTexture(GLenum target, GLuint texture)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_bindTexture(target, texture);
+        glBindTexture(target, texture);
+    }
+
+    inline void bindFramebuffer(GLenum target, GLuint framebuffer)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_bindFramebuffer(framebuffer);
+        glBindFramebuffer(target, framebuffer);
+    }
+
+    inline void useProgram(GLuint program)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_useProgram(program);
+        glUseProgram(program);
+    }
+
+    inline void bufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_bufferData(target, size);
+        glBufferData(target, size, data, usage);
+    }
+
+    inline void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_bufferSubData(size);
+        glBufferSubData(target, offset, size, data);
+    }
+
+    inline void texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+        GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_texImage2D(target, level, internalFormat, width, height);
+        glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+    }
+
+    inline void genBuffers(GLsizei n, GLuint* buffers, const char* owner)
+    {
+        glGenBuffers(n, buffers);
+        if constexpr (GLStats::ENABLED)
+            GLStats::_genBuffers(n, buffers, owner);
+    }
+
+    inline void deleteBuffers(GLsizei n, const GLuint* buffers)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_deleteBuffers(n, buffers);
+        glDeleteBuffers(n, buffers);
+    }
+
+    inline void genTextures(GLsizei n, GLuint* textures, const char* owner)
+    {
+        glGenTextures(n, textures);
+        if constexpr (GLStats::ENABLED)
+            GLStats::_genTextures(n, textures, owner);
+    }
+
+    inline void deleteTextures(GLsizei n, const GLuint* textures)
+    {
+        if constexpr (GLStats::ENABLED)
+            GLStats::_deleteTextures(n, textures);
+        glDeleteTextures(n, textures);
+    }
+}
+}
+
+#endif // RANGERALPHA_GL_STATS_H
@@ -0,0 +1,120 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+
+#include "Shaders/texture_shader.h"
+#include "gl_stats.h"
+#include "layer_cache.h"
+
+namespace Ranger {
+LayerCache::LayerCache()
+{
+}
+
+LayerCache::~LayerCache()
+{
+    if (_constructed) {
+        gl::deleteBuffers(1, &_vbo);
+        glDeleteVertexArrays(1, &_vao);
+    }
+    std::cout << "LayerCache::~LayerCache" << std::endl;
+}
+
+bool LayerCache::construct(int width, int height)
+{
+    if (!_fbo.gen(width, height)) {
+        std::cerr << "LayerCache::construct: Failed to create cache framebuffer" << std::endl;
+        return false;
+    }
+
+    float hw = static_cast<float>(width) / 2.0f;
+    float hh = static_cast<float>(height) / 2.0f;
+
+    _cacheVp = glm::ortho(-hw, hw, -hh, hh);
+
+    _shader = std::make_shared<TextureShader>();
+    _shader->load();
+
+    _mvpLoc = glGetUniformLocation(_shader->program(), "mvp");
+    _layerLoc = glGetUniformLocation(_shader->program(), "layer");
+
+    // The quad never changes so it is uploaded once.
+    // <vec2 pos, vec2 tex> as two triangles.
+    GLfloat quad[6][4] = {
+        { -hw, hh, 0.0f, 1.0f },
+        { -hw, -hh, 0.0f, 0.0f },
+        { hw, -hh, 1.0f, 0.0f },
+
+        { -hw, hh, 0.0f, 1.0f },
+        { hw, -hh, 1.0f, 0.0f },
+        { hw, hh, 1.0f, 1.0f }
+    };
+
+    glGenVertexArrays(1, &_vao);
+    gl::genBuffers(1, &_vbo, "LayerCache");
+    gl::bindVertexArray(_vao);
+    gl::bindBuffer(GL_ARRAY_BUFFER, _vbo);
+    gl::bufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+    gl::bindBuffer(GL_ARRAY_BUFFER, 0);
+    gl::bindVertexArray(0);
+
+    _constructed = true;
+    markDirty();
+
+    return true;
+}
+
+void LayerCache::begin()
+{
+    _dirty.store(false, std::memory_order_release);
+
+    glGetIntegerv(GL_VIEWPORT, _prevViewport);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, _prevClearColor);
+
+    _fbo.bind();
+    glViewport(0, 0, _fbo.width(), _fbo.height());
+
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void LayerCache::end()
+{
+    _fbo.unBind();
+
+    glViewport(_prevViewport[0], _prevViewport[1], _prevViewport[2], _prevViewport[3]);
+    glClearColor(_prevClearColor[0], _prevClearColor[1], _prevClearColor[2], _prevClearColor[3]);
+}
+
+void LayerCache::composite(const glm::mat4& vp, GLenum polygonMode)
+{
+    if (!_constructed)
+        return;
+
+    // The cached layer is an image; it must be filled even when the engine
+    // is in wireframe mode.
+    if (polygonMode != GL_FILL)
+        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    _shader->use();
+    glUniformMatrix4fv(_mvpLoc, 1, GL_FALSE, glm::value_ptr(vp));
+    glUniform1i(_layerLoc, 0);
+
+    gl::activeTexture(GL_TEXTURE0);
+    gl::bindTexture(GL_TEXTURE_2D, _fbo.texture());
+
+    gl::bindVertexArray(_vao);
+    gl::drawArrays(GL_TRIANGLES, 0, 6);
+    gl::bindVertexArray(0);
+
+    gl::bindTexture(GL_TEXTURE_2D, 0);
+
+    if (polygonMode != GL_FILL)
+        glPolygonMode(GL_FRONT_AND_BACK, polygonMode);
+}
+}
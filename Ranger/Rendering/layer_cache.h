@@ -0,0 +1,99 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_LAYER_CACHE_H
+#define RANGERALPHA_LAYER_CACHE_H
+
+#include <GL/glew.h>
+#include <atomic>
+#include <glm/glm.hpp>
+#include <memory>
+
+#include "GLObjects/fbo.h"
+
+namespace Ranger {
+class Shader;
+
+/*!
+ * Caches a static layer (backgrounds, static geometry) in an offscreen
+ * texture at virtual resolution.
+ *
+ * The layer's content is rendered once between [begin] and [end]. After that
+ * [composite] draws the whole layer as a single textured quad. The content is
+ * only re-rendered after [markDirty]. A node linked with
+ * @see BaseNode::staticLayer forwards every markDirty within it here.
+ *
+ * [markDirty] may be called from any thread (nodes change on the
+ * simulation thread), the rest on the GL thread only. A mark made while
+ * the layer is being rendered is kept for the next frame.
+ *
+ * Usage:
+ *     if (cache.dirty()) {
+ *         cache.begin();
+ *         ...draw layer using cache.viewProjection()...
+ *         cache.end();
+ *     }
+ *     cache.composite(vp);
+ */
+class LayerCache final {
+public:
+    LayerCache();
+    ~LayerCache();
+
+    //! [width] x [height] is the virtual resolution. The layer is centered
+    // on the origin, same as a centered Camera. False if there is no
+    // framebuffer to cache into; the layer must then be drawn directly.
+    bool construct(int width, int height);
+
+    bool dirty() const
+    {
+        return _dirty.load(std::memory_order_acquire);
+    }
+
+    void markDirty()
+    {
+        _dirty.store(true, std::memory_order_release);
+    }
+
+    //! Maps virtual coordinates onto the cache texture.
+    const glm::mat4& viewProjection() const
+    {
+        return _cacheVp;
+    }
+
+    //! Redirects rendering into the cache and clears it to transparent. The
+    // cache is clean from here on, unless marked again.
+    void begin();
+
+    //! Restores the previous framebuffer and viewport.
+    void end();
+
+    //! Draws the cached layer with a single draw call, filled.
+    /*!
+     * \param polygonMode the mode in effect, restored afterwards. The caller
+     * knows it; querying GL for it would stall.
+     */
+    void composite(const glm::mat4& vp, GLenum polygonMode = GL_FILL);
+
+private:
+    FBO _fbo;
+
+    std::shared_ptr<Shader> _shader;
+    GLint _mvpLoc{};
+    GLint _layerLoc{};
+
+    GLuint _vao{};
+    GLuint _vbo{};
+
+    glm::mat4 _cacheVp;
+
+    GLint _prevViewport[4];
+    GLfloat _prevClearColor[4];
+
+    std::atomic<bool> _dirty{ true };
+    bool _constructed{ false };
+};
+}
+
+#endif // RANGERALPHA_LAYER_CACHE_H
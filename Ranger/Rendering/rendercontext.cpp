@@ -7,7 +7,13 @@
 
 #include <iostream>
 
+#include "../Core/Logging/log.h"
+#include "../IO/configuration.h"
+#include "../ranger.h"
+#include "Shaders/basic_shader.h"
+#include "Shaders/texture_shader.h"
 #include "rendercontext.h"
+#include "shader_cache.h"
 
 namespace Ranger {
     RenderContext::~RenderContext() {
@@ -15,6 +21,13 @@ namespace Ranger {
     }
 
     bool RenderContext::initialize() {
+        ShaderCache::initialize(App::config()->shaderCache());
+
+        // Started now, the stage's programs compile while the font bakes;
+        // its shaders get these same programs when they load.
+        BasicShader().load();
+        TextureShader().load();
+
         _ftFont = std::make_unique<FreeTypeFont>();
 
         if (_ftFont == nullptr) {
@@ -22,7 +35,13 @@ namespace Ranger {
             return false;
         }
 
-        return _ftFont->initialize();
+        bool initialized = _ftFont->initialize();
+
+        const ShaderCache::Stats& stats = ShaderCache::stats();
+        LOG_INFO(LogCategory::RENDERING, "Shaders: {} loaded, {} compiled, {} stored, waited {} ms",
+            stats.loaded, stats.compiled, stats.stored, stats.waited);
+
+        return initialized;
     }
 
     void RenderContext::clearColor(float r, float g, float b, float a) {
@@ -11,7 +11,14 @@
 
 #include <string>
 
+#include "../IO/mapped_file.h"
+
 namespace Ranger {
+//! A program from GLSL files, made through @see ShaderCache.
+/*!
+ * [load] only starts the program; it is waited on the first time it is
+ * used, so loading early overlaps the compile with other work.
+ */
 class Shader {
 public:
     Shader() = default;
@@ -20,8 +27,11 @@ public:
 
     virtual void load() = 0;
 
-    GLuint program() const
+    //! Waits for the program to link, the first time.
+    GLuint program()
     {
+        if (!_finished)
+            _finish();
         return _program;
     }
 
@@ -41,19 +51,21 @@ protected:
 private:
     void _access();
 
-    void _checkCompileErrors(GLuint shader, std::string type);
+    void _finish();
 
     // ------------------------------------------------------------------------
     // Properties
     // ------------------------------------------------------------------------
 protected:
-    GLuint _program;
+    GLuint _program{ 0 };
 
 private:
-    // 1. Retrieve the vertex/fragment source code from filePath
-    std::string _vertexCode;
-    std::string _fragmentCode;
-    std::string _geometryCode;
+    bool _finished{ false };
+
+    // Mapped only while the sources are handed to GL.
+    MappedFile _vertexFile;
+    MappedFile _fragmentFile;
+    MappedFile _geometryFile;
 
     std::string _vertexPath;
     std::string _fragmentPath;
@@ -0,0 +1,339 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <vector>
+
+#include "../Core/Logging/log.h"
+#include "../Core/Timing/clock.h"
+#include "../IO/mapped_file.h"
+#include "shader_cache.h"
+
+namespace Ranger {
+namespace {
+    // A stored binary: the header, then [length] bytes of it. Native byte
+    // order; a binary is only good for the driver that made it anyway.
+    constexpr char BINARY_MAGIC[4] = { 'R', 'N', 'G', 'S' };
+    constexpr uint32_t BINARY_VERSION = 1;
+
+    struct BinaryHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t driver;
+        uint64_t key;
+        uint32_t format;
+        uint32_t length;
+    };
+
+    struct Program {
+        uint64_t key;
+        // Compiling until [finish]; 0 once deleted, or when loaded.
+        GLuint vertex;
+        GLuint fragment;
+        GLuint geometry;
+        bool finished;
+        bool linked;
+    };
+
+    std::string g_directory;
+    //! Hash of the GL vendor, renderer and version.
+    uint64_t g_driver{ 0 };
+    std::vector<GLint> g_formats;
+    bool g_parallel{ false };
+
+    std::unordered_map<uint64_t, GLuint> g_keys;
+    std::unordered_map<GLuint, Program> g_programs;
+    ShaderCache::Stats g_stats;
+
+    uint64_t hashPart(std::string_view part, uint64_t hash)
+    {
+        // The length first, so moving text between stages changes the key.
+        uint64_t length = part.size();
+        hash = fnv1a(&length, sizeof(length), hash);
+        return fnv1a(part.data(), part.size(), hash);
+    }
+
+    uint64_t hashString(GLenum name, uint64_t hash)
+    {
+        const char* value = reinterpret_cast<const char*>(glGetString(name));
+        return value ? hashPart(value, hash) : hash;
+    }
+
+    std::string binaryPath(uint64_t key)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%016llx.bin", static_cast<unsigned long long>(key));
+        return g_directory + name;
+    }
+
+    //! A line per record: a whole info log is longer than a record holds.
+    void logInfoLog(const char* what, const char* type, const GLchar* infoLog)
+    {
+        LOG_ERROR(LogCategory::RENDERING, "ShaderCache: {} error in {}:", what, type);
+
+        std::string_view remaining(infoLog);
+        while (!remaining.empty()) {
+            size_t end = remaining.find('\n');
+            std::string_view line = remaining.substr(0, end);
+            if (!line.empty())
+                LOG_ERROR(LogCategory::RENDERING, "  {}", line);
+            remaining = end == std::string_view::npos ? std::string_view() : remaining.substr(end + 1);
+        }
+    }
+
+    void checkCompileErrors(GLuint shader, const char* type)
+    {
+        GLint success;
+        GLchar infoLog[1024];
+        if (std::strcmp(type, "PROGRAM") != 0) {
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+            if (!success) {
+                glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+                logInfoLog("compile", type, infoLog);
+            }
+        } else {
+            glGetProgramiv(shader, GL_LINK_STATUS, &success);
+            if (!success) {
+                glGetProgramInfoLog(shader, 1024, NULL, infoLog);
+                logInfoLog("link", type, infoLog);
+            }
+        }
+    }
+
+    GLuint compileShader(GLenum type, std::string_view source)
+    {
+        const GLchar* code = source.data();
+        GLint length = GLint(source.size());
+
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &code, &length);
+        glCompileShader(shader);
+        return shader;
+    }
+
+    //! Starts compiling and linking; querying anything now would wait.
+    Program compile(uint64_t key, const ShaderCache::Sources& sources, GLuint& program)
+    {
+        Program started{ key, 0, 0, 0, false, false };
+        started.vertex = compileShader(GL_VERTEX_SHADER, sources.vertex);
+        started.fragment = compileShader(GL_FRAGMENT_SHADER, sources.fragment);
+        if (!sources.geometry.empty())
+            started.geometry = compileShader(GL_GEOMETRY_SHADER, sources.geometry);
+
+        program = glCreateProgram();
+        if (ShaderCache::binaries())
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+        glAttachShader(program, started.vertex);
+        glAttachShader(program, started.fragment);
+        if (started.geometry != 0)
+            glAttachShader(program, started.geometry);
+
+        glLinkProgram(program);
+
+        return started;
+    }
+
+    //! 0 if there is no binary for [key] from this driver, or it was refused.
+    GLuint load(uint64_t key)
+    {
+        if (!ShaderCache::binaries() || g_directory.empty())
+            return 0;
+
+        MappedFile file;
+        if (!file.open(binaryPath(key)) || file.size() < sizeof(BinaryHeader))
+            return 0;
+
+        BinaryHeader header;
+        std::memcpy(&header, file.data(), sizeof(BinaryHeader));
+        if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(header.magic)) != 0
+            || header.version != BINARY_VERSION
+            || header.driver != g_driver
+            || header.key != key
+            || file.size() != sizeof(BinaryHeader) + header.length
+            || std::find(g_formats.begin(), g_formats.end(), GLint(header.format)) == g_formats.end())
+            return 0;
+
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, header.format, file.data() + sizeof(BinaryHeader), GLsizei(header.length));
+
+        GLint linked;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            glDeleteProgram(program);
+            return 0;
+        }
+
+        return program;
+    }
+
+    void store(uint64_t key, GLuint program)
+    {
+        if (!ShaderCache::binaries() || g_directory.empty())
+            return;
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+            return;
+
+        std::vector<uint8_t> binary(length);
+        GLsizei written = 0;
+        GLenum format = 0;
+        glGetProgramBinary(program, length, &written, &format, binary.data());
+        if (written <= 0)
+            return;
+
+        BinaryHeader header{};
+        std::memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+        header.version = BINARY_VERSION;
+        header.driver = g_driver;
+        header.key = key;
+        header.format = format;
+        header.length = uint32_t(written);
+
+        // Written aside and renamed over, so a reader never maps half a file.
+        std::string path = binaryPath(key);
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return;
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(BinaryHeader));
+            file.write(reinterpret_cast<const char*>(binary.data()), written);
+
+            if (!file) {
+                file.close();
+                std::remove(temporary.c_str());
+                return;
+            }
+        }
+
+        if (std::rename(temporary.c_str(), path.c_str()) == 0)
+            g_stats.stored++;
+    }
+}
+
+void ShaderCache::initialize(const std::string& directory)
+{
+    g_directory = directory;
+
+    g_driver = hashString(GL_VENDOR, FNV1A_BASIS);
+    g_driver = hashString(GL_RENDERER, g_driver);
+    g_driver = hashString(GL_VERSION, g_driver);
+
+    // Core in 4.1; the window asks for 3.3.
+    g_formats.clear();
+    if (GLEW_ARB_get_program_binary) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+        g_formats.resize(std::max(count, 0));
+        if (count > 0)
+            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, g_formats.data());
+    }
+
+    // As many threads as the driver likes.
+    if (GLEW_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        g_parallel = true;
+    } else if (GLEW_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        g_parallel = true;
+    }
+
+    if (binaries() && !g_directory.empty()) {
+        if (::mkdir(g_directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            LOG_ERROR(LogCategory::RENDERING, "ShaderCache: could not make '{}'", g_directory);
+            g_directory.clear();
+        }
+    }
+
+    LOG_INFO(LogCategory::RENDERING, "ShaderCache: {}{}{}{}", binaries() ? "binaries" : "no binaries",
+        g_directory.empty() ? "" : " in ", g_directory, g_parallel ? ", parallel compile" : "");
+}
+
+GLuint ShaderCache::request(const Sources& sources)
+{
+    uint64_t key = hashPart(sources.vertex, FNV1A_BASIS);
+    key = hashPart(sources.fragment, key);
+    key = hashPart(sources.geometry, key);
+
+    auto found = g_keys.find(key);
+    if (found != g_keys.end()) {
+        g_stats.shared++;
+        return found->second;
+    }
+
+    GLuint program = load(key);
+    if (program != 0) {
+        g_programs[program] = Program{ key, 0, 0, 0, true, true };
+        g_stats.loaded++;
+    } else {
+        Program started = compile(key, sources, program);
+        g_programs[program] = started;
+        g_stats.compiled++;
+    }
+
+    g_keys[key] = program;
+    return program;
+}
+
+bool ShaderCache::finish(GLuint program)
+{
+    auto found = g_programs.find(program);
+    if (found == g_programs.end())
+        return false;
+
+    Program& made = found->second;
+    if (made.finished)
+        return made.linked;
+
+    Clock::Ticks start = Clock::now();
+
+    checkCompileErrors(made.vertex, "VERTEX");
+    checkCompileErrors(made.fragment, "FRAGMENT");
+    if (made.geometry != 0)
+        checkCompileErrors(made.geometry, "GEOMETRY");
+    checkCompileErrors(program, "PROGRAM");
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    // Delete the shaders as they're linked into our program now and are no longer necessary
+    glDeleteShader(made.vertex);
+    glDeleteShader(made.fragment);
+    if (made.geometry != 0)
+        glDeleteShader(made.geometry);
+    made.vertex = made.fragment = made.geometry = 0;
+
+    made.finished = true;
+    made.linked = linked != 0;
+    if (made.linked)
+        store(made.key, program);
+
+    g_stats.waited += Clock::toMilliseconds(Clock::now() - start);
+    return made.linked;
+}
+
+const ShaderCache::Stats& ShaderCache::stats()
+{
+    return g_stats;
+}
+
+bool ShaderCache::binaries()
+{
+    return !g_formats.empty();
+}
+
+bool ShaderCache::parallel()
+{
+    return g_parallel;
+}
+}
@@ -0,0 +1,72 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_SHADER_CACHE_H
+#define RANGERALPHA_SHADER_CACHE_H
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Ranger {
+//! Makes every linked program, once per run and ideally once per driver.
+/*!
+ * A program is keyed by a hash of its sources. Asking for one comes back
+ * at once with one of:
+ *  - the program already made this run, so a shader loaded by several
+ *    owners is compiled once;
+ *  - a program restored with glProgramBinary from the binary stored by an
+ *    earlier run on the same GL vendor, renderer and version;
+ *  - a program whose compile and link were just started.
+ *
+ * Nothing waits until [finish], which a @see Shader calls the first time
+ * its program is used. Started early, compiles run alongside the rest of
+ * startup: on their own threads with GL_KHR_parallel_shader_compile, or
+ * as far as the driver defers them without it. A freshly linked program's
+ * binary is stored in [finish]; a stored binary the driver rejects, or
+ * made by another driver, is compiled again and replaced.
+ *
+ * Programs live as long as the GL context. The GL thread only.
+ */
+class ShaderCache final {
+public:
+    struct Sources {
+        std::string_view vertex;
+        std::string_view fragment;
+        //! Empty for none.
+        std::string_view geometry;
+    };
+
+    struct Stats {
+        //! Requests for a program already made this run.
+        uint32_t shared{ 0 };
+        uint32_t loaded{ 0 };
+        uint32_t compiled{ 0 };
+        uint32_t stored{ 0 };
+        //! Time spent in [finish], waiting on compiles and links.
+        double waited{ 0.0 };
+    };
+
+    //! Once the GL context is current. [directory] holds the binaries;
+    // empty stores none.
+    static void initialize(const std::string& directory);
+
+    static GLuint request(const Sources& sources);
+
+    //! Waits for [program] to link, reports compile and link errors and
+    // stores its binary. False if it didn't link.
+    static bool finish(GLuint program);
+
+    static const Stats& stats();
+
+    //! Whether binaries can be stored and loaded at all.
+    static bool binaries();
+
+    //! Whether compiles run on the driver's threads.
+    static bool parallel();
+};
+}
+
+#endif // RANGERALPHA_SHADER_CACHE_H
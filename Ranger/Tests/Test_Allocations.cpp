@@ -0,0 +1,101 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <charconv>
+#include <iomanip>
+#include <iostream> // For: std
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Core/Memory/alloc_tracker.h"
+#include "../Core/Timing/clock.h"
+#include "Test_Allocations.h"
+
+namespace {
+using namespace Ranger;
+
+// Counts what [body] allocates on this thread.
+template <typename F>
+void measure(const char* what, int frames, F body)
+{
+    AllocStats before = AllocTracker::thread();
+    for (int f = 0; f < frames; f++)
+        body(f);
+    AllocStats after = AllocTracker::thread();
+
+    std::cout << what << ": " << double(after.allocations - before.allocations) / frames << " allocations, "
+              << double(after.bytes - before.bytes) / frames << " bytes per frame" << std::endl;
+}
+}
+
+void Test_Allocations::test()
+{
+    using namespace std;
+    cout << "Allocation tracking benchmark" << endl;
+
+    if (!AllocTracker::ENABLED) {
+        cout << "Build with RANGER_TRACK_ALLOCATIONS to count allocations." << endl;
+        return;
+    }
+
+    static constexpr int FRAMES = 1000;
+
+    // The Stage's fps text, as it was.
+    ostringstream os;
+    measure("ostringstream + str()", FRAMES, [&os](int f) {
+        os.str("");
+        os << "u: " << fixed << setw(7) << setfill('0') << setprecision(4) << f * 0.016 << " x" << 1;
+        string text = os.str();
+    });
+
+    measure("std::to_string", FRAMES, [](int f) {
+        string text = "t: " + to_string(f);
+    });
+
+    // Formatting into storage that outlives the frame.
+    string reused;
+    reused.reserve(64);
+    measure("to_chars into a reserved string", FRAMES, [&reused](int f) {
+        char digits[16];
+        auto end = to_chars(digits, digits + sizeof(digits), f).ptr;
+        reused.assign("t: ");
+        reused.append(digits, end);
+    });
+
+    measure("make_shared<vector>", FRAMES, [](int f) {
+        auto v = make_shared<vector<float>>(16);
+    });
+
+    // Tags.
+    {
+        MemoryScope tag(MemoryTag::RENDERING);
+        vector<unique_ptr<int>> objects;
+        for (int i = 0; i < 100; i++)
+            objects.push_back(make_unique<int>(i));
+    }
+    AllocStats rendering = AllocTracker::tag(MemoryTag::RENDERING);
+    cout << "Rendering tag: " << rendering.allocations << " allocations, " << rendering.bytes
+         << " bytes, " << rendering.live << " live" << endl;
+
+    // Steady state: counted, not fatal (see abortOnViolation).
+    uint64_t violations = AllocTracker::violations();
+    {
+        NoAllocScope steady;
+        MemoryScope tag(MemoryTag::SCENE);
+        string oops = "a string too long for the small string buffer";
+    }
+    cout << "violations: " << AllocTracker::violations() - violations << ", last "
+         << AllocTracker::violationSize() << " bytes tagged " << AllocTracker::tagName(AllocTracker::violationTag()) << endl;
+
+    // Overhead of a tracked allocation.
+    static constexpr int ALLOCATIONS = 1000000;
+    Clock::Ticks start = Clock::now();
+    for (int i = 0; i < ALLOCATIONS; i++) {
+        int* p = new int(i);
+        asm volatile("" : : "r"(p) : "memory");
+        delete p;
+    }
+    cout << "new + delete: " << double(Clock::now() - start) / ALLOCATIONS << " ns" << endl;
+}
@@ -0,0 +1,14 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_ALLOCATIONS_H
+#define RANGERALPHA_TEST_ALLOCATIONS_H
+
+//! What typical frame code allocates, tags, steady state violations and
+// the cost of a tracked new/delete. Needs RANGER_TRACK_ALLOCATIONS.
+struct Test_Allocations {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_ALLOCATIONS_H
@@ -0,0 +1,211 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <chrono>
+#include <iostream> // For: std
+#include <memory>
+#include <vector>
+
+#include "../Core/Timing/behavior.h"
+#include "../Core/Timing/scheduler.h"
+#include "Test_Behaviors.h"
+
+namespace {
+using namespace Ranger;
+
+class CountingUpdateTarget final : public UpdateTarget {
+public:
+    void update(double dt) override { calls++; }
+
+    int64_t calls{ 0 };
+};
+
+Behavior everyFrame(int64_t& calls)
+{
+    while (true) {
+        calls++;
+        co_await nextFrame();
+    }
+}
+
+Behavior every(double interval, int64_t& calls)
+{
+    while (true) {
+        co_await milliseconds(interval);
+        calls++;
+    }
+}
+
+Behavior slide(float& x)
+{
+    while (true) {
+        co_await tween(x, 100.0f, 1000.0);
+        co_await tween(x, 0.0f, 1000.0);
+    }
+}
+
+// The kind of script Behaviors are meant for.
+Behavior script(std::vector<double>& marks, const double& clock, const bool& open, float& x)
+{
+    co_await seconds(2);
+    marks.push_back(clock);
+    co_await tween(x, 50.0f, 500.0);
+    marks.push_back(clock);
+    co_await until([&open] { return open; });
+    marks.push_back(clock);
+}
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const char* what, double ms, size_t ops)
+{
+    std::cout << what << ": " << ms << " ms, "
+              << (ms * 1000000.0 / double(ops)) << " ns/op" << std::endl;
+}
+
+void reportPool()
+{
+    BehaviorFramePool::Stats stats = BehaviorFramePool::stats();
+    std::cout << "frame pool: " << stats.framesInUse << " in use, "
+              << stats.allocations << " allocations, "
+              << stats.chunks << " chunks (" << stats.bytesReserved / 1024 << " KB), "
+              << stats.heapFallbacks << " heap fallbacks" << std::endl;
+}
+}
+
+void Test_Behaviors::test()
+{
+    using namespace std;
+    cout << "Behavior benchmark" << endl;
+
+    static constexpr size_t COUNT = 100000;
+    static constexpr int FRAMES = 60;
+    static constexpr double DT = 16.667;
+
+    Scheduler scheduler;
+    scheduler.reserve(0, COUNT);
+
+    // ------------------------------------------------------------------
+    // Every frame: nextFrame() vs interval-less UpdateTargets.
+    // ------------------------------------------------------------------
+    vector<int64_t> calls(COUNT, 0);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < COUNT; i++)
+        scheduler.startBehavior(everyFrame(calls[i]));
+    report("spawn Behaviors", msSince(start), COUNT);
+    reportPool();
+
+    start = Clock::now();
+    for (int f = 0; f < FRAMES; f++)
+        scheduler.update(DT);
+    report("nextFrame Behaviors (per behavior, per frame)", msSince(start) / FRAMES, COUNT);
+
+    scheduler.stopAllBehaviors();
+
+    // Respawning reuses the pooled frames.
+    start = Clock::now();
+    for (size_t i = 0; i < COUNT; i++)
+        scheduler.startBehavior(everyFrame(calls[i]));
+    report("respawn Behaviors", msSince(start), COUNT);
+    reportPool();
+    scheduler.stopAllBehaviors();
+
+    vector<shared_ptr<CountingUpdateTarget>> targets;
+    vector<ScheduleHandle> handles(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        targets.push_back(make_shared<CountingUpdateTarget>());
+        handles[i] = scheduler.scheduleUpdateTarget(targets[i]);
+    }
+
+    start = Clock::now();
+    for (int f = 0; f < FRAMES; f++)
+        scheduler.update(DT);
+    report("frame UpdateTargets (per target, per frame)", msSince(start) / FRAMES, COUNT);
+
+    for (size_t i = 0; i < COUNT; i++)
+        scheduler.unscheduleUpdateTarget(handles[i]);
+
+    // ------------------------------------------------------------------
+    // Intervals of 1-5 seconds: milliseconds() vs interval UpdateTargets.
+    // ------------------------------------------------------------------
+    static constexpr int WHEEL_FRAMES = 600; // 10 seconds at 60Hz
+
+    fill(calls.begin(), calls.end(), 0);
+    for (size_t i = 0; i < COUNT; i++)
+        scheduler.startBehavior(every(1000.0 + double(i % 4001), calls[i]));
+
+    start = Clock::now();
+    for (int f = 0; f < WHEEL_FRAMES; f++)
+        scheduler.update(DT);
+    double ms = msSince(start);
+
+    int64_t total = 0;
+    for (int64_t c : calls)
+        total += c;
+    cout << "interval Behaviors: " << (ms / WHEEL_FRAMES) << " ms/frame, "
+         << total << " resumes" << endl;
+    scheduler.stopAllBehaviors();
+
+    for (size_t i = 0; i < COUNT; i++) {
+        targets[i]->calls = 0;
+        handles[i] = scheduler.scheduleUpdateTarget(targets[i], 1000.0 + double(i % 4001), Timer::REPEAT_FOREVER);
+    }
+
+    start = Clock::now();
+    for (int f = 0; f < WHEEL_FRAMES; f++)
+        scheduler.update(DT);
+    ms = msSince(start);
+
+    total = 0;
+    for (auto& target : targets)
+        total += target->calls;
+    cout << "interval UpdateTargets: " << (ms / WHEEL_FRAMES) << " ms/frame, "
+         << total << " callbacks" << endl;
+
+    for (size_t i = 0; i < COUNT; i++)
+        scheduler.unscheduleUpdateTarget(handles[i]);
+
+    // ------------------------------------------------------------------
+    // Tweens: one poll per behavior per frame.
+    // ------------------------------------------------------------------
+    vector<float> xs(COUNT, 0.0f);
+    for (size_t i = 0; i < COUNT; i++)
+        scheduler.startBehavior(slide(xs[i]));
+
+    start = Clock::now();
+    for (int f = 0; f < FRAMES; f++)
+        scheduler.update(DT);
+    report("tween Behaviors (per behavior, per frame)", msSince(start) / FRAMES, COUNT);
+    cout << "x[0] after " << FRAMES << " frames: " << xs[0] << endl;
+    scheduler.stopAllBehaviors();
+
+    // ------------------------------------------------------------------
+    // A script: seconds(2), a 500ms tween, then a condition.
+    // ------------------------------------------------------------------
+    vector<double> marks;
+    double clock = 0.0;
+    bool open = false;
+    float x = 0.0f;
+    ScheduleHandle handle = scheduler.startBehavior(script(marks, clock, open, x));
+
+    for (int f = 0; f < 240; f++) {
+        clock += DT;
+        if (f == 200)
+            open = true;
+        scheduler.update(DT);
+    }
+
+    cout << "script marks (ms):";
+    for (double mark : marks)
+        cout << " " << mark;
+    cout << ", x= " << x << ", finished= " << !scheduler.isBehaviorRunning(handle) << endl;
+
+    reportPool();
+    cout << scheduler << endl;
+}
@@ -0,0 +1,13 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_BEHAVIORS_H
+#define RANGERALPHA_TEST_BEHAVIORS_H
+
+//! Coroutine Behaviors vs the equivalent Timer driven UpdateTargets.
+struct Test_Behaviors {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_BEHAVIORS_H
@@ -0,0 +1,81 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <iostream> // For: std
+
+#include "../Core/Timing/clock.h"
+#include "Test_Clock.h"
+
+void Test_Clock::test()
+{
+    using namespace std;
+    using namespace Ranger;
+    cout << "Clock benchmark" << endl;
+
+    static constexpr int READS = 10000000;
+
+    Clock::calibrate();
+    cout << "cycle counter: " << Clock::nanosecondsPerCycle() << " ns/cycle ("
+         << (1.0 / Clock::nanosecondsPerCycle()) << " GHz)" << endl;
+
+    // Read costs, each measured by the other.
+    Clock::Ticks sink = 0;
+    uint64_t start = Clock::cycles();
+    for (int i = 0; i < READS; i++)
+        sink += Clock::now();
+    uint64_t nowCycles = Clock::cycles() - start;
+
+    Clock::Ticks begin = Clock::now();
+    for (int i = 0; i < READS; i++)
+        sink += Clock::Ticks(Clock::cycles());
+    Clock::Ticks cyclesNs = Clock::now() - begin;
+
+    cout << "Clock::now: " << double(Clock::cyclesToNanoseconds(nowCycles)) / READS << " ns/read" << endl;
+    cout << "Clock::cycles: " << double(cyclesNs) / READS << " ns/read" << endl;
+
+    // Calibration check: a 50 ms span measured both ways.
+    ZoneStats zone;
+    begin = Clock::now();
+    {
+        ProfileZone profile(zone);
+        while (Clock::now() - begin < 50 * Clock::NS_PER_MS) {
+        }
+    }
+    double measured = Clock::toMilliseconds(Clock::now() - begin);
+    cout << "50 ms span: " << measured << " ms by Clock::now, " << zone.milliseconds()
+         << " ms by ProfileZone" << endl;
+
+    // Summing 16.667 ms frames: double milliseconds vs integer nanoseconds.
+    static constexpr int FRAMES = 60 * 60 * 60 * 10; // 10 hours at 60Hz
+    double summed = 0.0;
+    Clock::Ticks ticks = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        summed += 16.667;
+        ticks += Clock::fromMilliseconds(16.667);
+    }
+    cout << "10h of frames: double ms off by " << (summed - 16.667 * FRAMES) * 1000000.0
+         << " ns, integer ns off by " << (ticks - Clock::Ticks(FRAMES) * 16667000) << " ns" << endl;
+
+    // FrameClock: 1 real second per frame, scaled, paused and resumed.
+    FrameClock frameClock;
+    Clock::Ticks real = 0;
+    frameClock.advance(real);
+
+    frameClock.timeScale(0.25);
+    for (int f = 0; f < 3; f++)
+        frameClock.advance(real += Clock::NS_PER_SECOND);
+    frameClock.pause();
+    frameClock.advance(real += Clock::NS_PER_SECOND);
+    Clock::Ticks pausedDelta = frameClock.delta();
+    frameClock.resume();
+    frameClock.timeScale(1.0 / 3.0);
+    for (int f = 0; f < 3; f++)
+        frameClock.advance(real += Clock::NS_PER_SECOND);
+
+    cout << "FrameClock: " << Clock::toSeconds(frameClock.time()) << " s game time over "
+         << Clock::toSeconds(real) << " s real (expected 1.75), paused delta " << pausedDelta
+         << ", frames " << frameClock.frame() << endl;
+
+    if (sink == 42)
+        cout << endl; // Keep the reads.
+}
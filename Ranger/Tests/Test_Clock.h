@@ -0,0 +1,13 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_CLOCK_H
+#define RANGERALPHA_TEST_CLOCK_H
+
+//! Clock read costs, cycle calibration and FrameClock pause/scale. No GLFW.
+struct Test_Clock {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_CLOCK_H
@@ -0,0 +1,100 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <iomanip>
+#include <iostream> // For: std
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Core/Memory/frame_arena.h"
+#include "../Core/Timing/clock.h"
+#include "Test_FrameArena.h"
+
+namespace {
+using namespace Ranger;
+
+static constexpr int FRAMES = 10000;
+static constexpr int TEXTS = 4;
+static constexpr int QUADS = 64;
+
+// Keeps the results alive.
+volatile size_t g_sink;
+
+template <typename F>
+void time(const char* what, F frame)
+{
+    Clock::Ticks start = Clock::now();
+    size_t sink = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        sink += frame(f);
+        FrameArena::advance();
+    }
+    double ns = double(Clock::now() - start) / FRAMES;
+    g_sink = sink;
+    std::cout << what << ": " << std::fixed << std::setprecision(1) << ns << " ns/frame" << std::endl;
+}
+}
+
+void Test_FrameArena::test()
+{
+    using namespace std;
+    cout << "Frame arena benchmark" << endl;
+
+    FrameArena& arena = FrameArena::local();
+
+    // The overlay's texts.
+    ostringstream os;
+    os << fixed << setprecision(4);
+    time("ostringstream texts", [&os](int f) {
+        size_t length = 0;
+        for (int t = 0; t < TEXTS; t++) {
+            os.str("");
+            os << "u: " << setw(7) << setfill('0') << f * 0.016 << " x" << t;
+            length += os.str().size();
+        }
+        return length;
+    });
+
+    time("arena format texts", [&arena](int f) {
+        size_t length = 0;
+        for (int t = 0; t < TEXTS; t++)
+            length += arena.format("u: %07.4f x%d", f * 0.016, t).size();
+        return length;
+    });
+
+    // Text layout's quads.
+    time("std::vector quads", [](int f) {
+        vector<float> vertices;
+        vertices.reserve(QUADS * 24);
+        for (int q = 0; q < QUADS * 24; q++)
+            vertices.push_back(float(q + f));
+        return vertices.size();
+    });
+
+    time("FrameVector quads", [](int f) {
+        FrameVector<float> vertices;
+        vertices.reserve(QUADS * 24);
+        for (int q = 0; q < QUADS * 24; q++)
+            vertices.push_back(float(q + f));
+        return vertices.size();
+    });
+
+    // Data survives one frame, for a pipelined consumer.
+    string_view kept = arena.format("frame %llu", static_cast<unsigned long long>(FrameArena::frame()));
+    string expected(kept);
+    FrameArena::advance();
+    arena.format("%s", "the next frame's data");
+    cout << "kept into the next frame: " << (kept == expected ? "yes" : "NO") << endl;
+
+    // Overflows fall back to the heap and are counted.
+    FrameArena::Stats before = FrameArena::stats();
+    FrameArena::advance();
+    arena.allocate(arena.capacity() / 2);
+    arena.allocate(arena.capacity());
+    FrameArena::advance();
+    arena.allocate(1);
+    FrameArena::Stats after = FrameArena::stats();
+    cout << "overflows: " << after.overflows - before.overflows << " (" << after.overflowBytes - before.overflowBytes
+         << " bytes), peak " << FrameArena::takePeak() << " of " << arena.capacity() << " bytes" << endl;
+}
@@ -0,0 +1,14 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_FRAMEARENA_H
+#define RANGERALPHA_TEST_FRAMEARENA_H
+
+//! Frame arena vs heap for transient strings and vectors, the lifetime of
+// arena data across frames and overflow accounting.
+struct Test_FrameArena {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_FRAMEARENA_H
@@ -0,0 +1,103 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <chrono>
+#include <iostream> // For: std
+#include <thread>
+
+#include "../Core/Timing/clock.h"
+#include "../Core/Timing/frame_pacer.h"
+#include "Test_FramePacer.h"
+
+namespace {
+using namespace Ranger;
+
+// Busy work standing in for poll + update + render.
+void work(double ms)
+{
+    Clock::Ticks end = Clock::now() + Clock::fromMilliseconds(ms);
+    while (Clock::now() < end) {
+    }
+}
+
+// A swap locked to a [refresh] Hz display: blocks until the next vblank.
+void swap(double refresh)
+{
+    Clock::Ticks period = Clock::fromMilliseconds(1000.0 / refresh);
+    Clock::Ticks now = Clock::now();
+    std::this_thread::sleep_for(std::chrono::nanoseconds(period - now % period));
+}
+
+// Runs [frames] frames of [cost] ms and reports the pacing. Input is
+// "sampled" when wait returns.
+void run(const char* what, FramePacer& pacer, int frames, double cost, bool focused = true, double refresh = 0.0)
+{
+    pacer.focused(focused);
+    double sampleToPresent = 0.0;
+
+    Clock::Ticks start = Clock::now();
+    for (int f = 0; f < frames; f++) {
+        pacer.wait();
+        Clock::Ticks sampled = Clock::now();
+        work(cost);
+        pacer.rendered();
+        if (refresh > 0.0)
+            swap(refresh);
+        pacer.presented();
+        sampleToPresent += Clock::toMilliseconds(Clock::now() - sampled);
+    }
+    double elapsed = Clock::toMilliseconds(Clock::now() - start);
+
+    const FramePacer::Stats& stats = pacer.stats();
+    std::cout << what << ": " << (1000.0 * frames / elapsed) << " FPS, "
+              << stats.mean << " +/- " << stats.stddev() << " ms/frame ("
+              << stats.min << " - " << stats.max << "), " << stats.late << " late" << std::endl
+              << "    " << pacer.sleptMilliseconds() << " ms slept, "
+              << pacer.spunMilliseconds() << " ms spun, "
+              << (sampleToPresent / frames) << " ms input to present" << std::endl;
+}
+}
+
+void Test_FramePacer::test()
+{
+    using namespace std;
+    cout << "Frame pacer benchmark" << endl;
+
+    static constexpr double FPS = 120.0;
+    static constexpr int FRAMES = 240;
+    static constexpr double COST = 3.0;
+
+    FramePacer pacer;
+
+    pacer.configure(FramePacer::Mode::LIMIT, FPS, 10.0, 0.0);
+    run("limit, no spin margin", pacer, FRAMES, COST);
+
+    pacer.configure(FramePacer::Mode::LIMIT, FPS, 10.0, 1.0);
+    run("limit, sleep + 1ms spin", pacer, FRAMES, COST);
+
+    // Same frame rate, but input is sampled ~cost before the present
+    // instead of a whole frame before.
+    pacer.configure(FramePacer::Mode::ADAPTIVE, FPS, 10.0, 1.0);
+    run("adaptive", pacer, FRAMES, COST);
+
+    // A spike: the cost estimate jumps up at once, then decays.
+    pacer.resetStats();
+    run("adaptive, 6ms frames", pacer, 30, 6.0);
+    cout << "    frame cost estimate: " << pacer.frameCost() << " ms" << endl;
+    pacer.resetStats();
+    run("adaptive, back to 3ms", pacer, FRAMES, COST);
+    cout << "    frame cost estimate: " << pacer.frameCost() << " ms" << endl;
+
+    // With vsync a limited frame is sampled up to a refresh before it
+    // shows; adaptive wakes ~cost before the vblank instead.
+    pacer.configure(FramePacer::Mode::LIMIT, 60.0, 10.0, 1.0);
+    run("limit 60, vsync 60", pacer, 120, COST, true, 60.0);
+    pacer.configure(FramePacer::Mode::ADAPTIVE, 60.0, 10.0, 1.0);
+    run("adaptive 60, vsync 60", pacer, 120, COST, true, 60.0);
+
+    pacer.configure(FramePacer::Mode::LIMIT, FPS, 10.0, 1.0);
+    run("unfocused (idle 10 FPS)", pacer, 10, COST, false);
+
+    pacer.configure(FramePacer::Mode::OFF, FPS);
+    run("off (unbounded)", pacer, FRAMES, COST);
+}
@@ -0,0 +1,14 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_FRAME_PACER_H
+#define RANGERALPHA_TEST_FRAME_PACER_H
+
+//! Limiter accuracy (sleep only vs sleep + spin), adaptive input latency
+// and idle throttling, with simulated frames. No GLFW.
+struct Test_FramePacer {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_FRAME_PACER_H
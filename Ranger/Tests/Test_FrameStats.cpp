@@ -0,0 +1,92 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <algorithm>
+#include <iostream> // For: std
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "../Core/Timing/clock.h"
+#include "../Core/Timing/frame_stats.h"
+#include "Test_FrameStats.h"
+
+namespace {
+using namespace Ranger;
+
+// A 60 Hz frame: mostly on time, 1 in [hitchEvery] taking 2-3 periods.
+double frameTime(std::mt19937& rng, int hitchEvery)
+{
+    std::normal_distribution<double> jitter(16.667, 0.4);
+    if (hitchEvery > 0 && rng() % hitchEvery == 0)
+        return 16.667 * (2.0 + std::uniform_real_distribution<double>(0.0, 1.0)(rng));
+    return std::max(0.0, jitter(rng));
+}
+
+double exact(std::vector<double>& samples, double fraction)
+{
+    std::sort(samples.begin(), samples.end());
+    size_t rank = std::max<size_t>(1, static_cast<size_t>(fraction * samples.size() + 0.5));
+    return samples[rank - 1];
+}
+
+void print(const char* what, const FrameStats::Summary& s)
+{
+    std::cout << what << ": " << s.frames << " frames, mean " << s.mean << ", p50 " << s.p50
+              << ", p90 " << s.p90 << ", p99 " << s.p99 << ", p99.9 " << s.p999
+              << ", max " << s.max << " ms, " << s.hitches << " hitches" << std::endl;
+}
+}
+
+void Test_FrameStats::test()
+{
+    using namespace std;
+    cout << "Frame stats benchmark" << endl;
+
+    static constexpr int FRAMES = 36000; // 10 minutes at 60 FPS.
+
+    std::mt19937 rng(42);
+    FrameStats stats;
+    stats.configure(1.5 * 1000.0 / 60.0, 10.0);
+
+    // Percentiles to within a bucket (1/64) of the sorted samples.
+    vector<double> samples;
+    for (int f = 0; f < FRAMES; f++) {
+        double total = frameTime(rng, 200);
+        samples.push_back(total);
+        stats.record(total * 0.3, total * 0.2, total * 0.5, total);
+    }
+    FrameStats::Summary overall = stats.overall(FrameStats::TOTAL);
+    print("overall", overall);
+    cout << "    exact p50 " << exact(samples, 0.5) << ", p99 " << exact(samples, 0.99)
+         << ", p99.9 " << exact(samples, 0.999) << " ms" << endl;
+
+    // The mean barely moves with 1 in 200 frames hitching; p99 does.
+    print("last 10s", stats.recent(FrameStats::TOTAL));
+
+    // A smooth stretch: the window forgets the hitches once they've
+    // slid out, the whole run doesn't.
+    for (int f = 0; f < 600; f++) {
+        double total = frameTime(rng, 0);
+        stats.record(total * 0.3, total * 0.2, total * 0.5, total);
+    }
+    print("after 10s smooth", stats.recent(FrameStats::TOTAL));
+    print("overall", stats.overall(FrameStats::TOTAL));
+
+    // Recording cost, including slice rotations.
+    static constexpr int RECORDS = 1000000;
+    vector<double> times(1024);
+    for (auto& t : times)
+        t = frameTime(rng, 200);
+    uint64_t start = Clock::cycles();
+    for (int i = 0; i < RECORDS; i++) {
+        double total = times[i & 1023];
+        stats.record(total * 0.3, total * 0.2, total * 0.5, total);
+    }
+    uint64_t cycles = Clock::cycles() - start;
+    cout << "record: " << double(Clock::cyclesToNanoseconds(cycles)) / RECORDS << " ns/frame" << endl;
+
+    std::ostringstream json;
+    stats.writeJson(json);
+    cout << "json: " << json.str().size() << " bytes" << endl;
+}
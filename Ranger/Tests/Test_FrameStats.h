@@ -0,0 +1,14 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_FRAME_STATS_H
+#define RANGERALPHA_TEST_FRAME_STATS_H
+
+//! Percentile accuracy against sorted samples, what averages hide about
+// hitches, sliding windows, and the cost of recording a frame. No GLFW.
+struct Test_FrameStats {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_FRAME_STATS_H
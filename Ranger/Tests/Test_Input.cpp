@@ -0,0 +1,105 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <atomic>
+#include <iostream> // For: std
+#include <thread>
+
+#include "../Core/Input/input_queue.h"
+#include "../Core/spsc_queue.h"
+#include "../Core/Timing/clock.h"
+#include "Test_Input.h"
+
+namespace {
+using namespace Ranger;
+
+constexpr int KEY_SPACE = 32;
+constexpr int KEY_A = 65;
+
+const char* yesNo(bool value)
+{
+    return value ? "yes" : "no";
+}
+}
+
+void Test_Input::test()
+{
+    using namespace std;
+    cout << "Input benchmark" << endl;
+
+    // ------------------------------------------------------------------
+    // SpscQueue: one producer, one consumer, in order and nothing lost.
+    // ------------------------------------------------------------------
+    static constexpr uint64_t COUNT = 10000000;
+    static SpscQueue<uint64_t, 1024> queue;
+
+    Clock::Ticks start = Clock::now();
+    thread producer([] {
+        for (uint64_t i = 0; i < COUNT; i++) {
+            while (!queue.tryPush(i))
+                this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    bool ordered = true;
+    while (expected < COUNT) {
+        uint64_t value;
+        if (queue.tryPop(value)) {
+            ordered = ordered && value == expected;
+            expected++;
+        } else {
+            this_thread::yield();
+        }
+    }
+    producer.join();
+    double ms = Clock::toMilliseconds(Clock::now() - start);
+    cout << "spsc: " << COUNT << " items in " << ms << " ms, "
+         << (ms * 1000000.0 / double(COUNT)) << " ns/item, in order: " << yesNo(ordered) << endl;
+
+    // ------------------------------------------------------------------
+    // Edges: press/release across frames and a tap within one frame.
+    // ------------------------------------------------------------------
+    InputQueue input;
+    InputSnapshot snapshot;
+
+    input.key(KEY_SPACE, InputEvent::PRESS);
+    input.key(KEY_A, InputEvent::PRESS);
+    input.key(KEY_A, InputEvent::RELEASE);
+    input.cursor(100.0, 50.0);
+    input.scroll(0.0, 1.0);
+    input.scroll(0.0, 2.0);
+    input.joystickButton(0, 3, InputEvent::PRESS);
+    input.axis(0, 1, -0.5f);
+    int events = input.drain(snapshot);
+    cout << "frame 1 (" << events << " events): space down/pressed= "
+         << yesNo(snapshot.isKeyDown(KEY_SPACE)) << "/" << yesNo(snapshot.wasKeyPressed(KEY_SPACE))
+         << ", A tapped (pressed, released, down)= " << yesNo(snapshot.wasKeyPressed(KEY_A)) << ", "
+         << yesNo(snapshot.wasKeyReleased(KEY_A)) << ", " << yesNo(snapshot.isKeyDown(KEY_A))
+         << ", scroll= " << snapshot.scrollY() << ", button 3= " << yesNo(snapshot.wasButtonPressed(0, 3))
+         << ", axis 1= " << snapshot.axis(0, 1) << endl;
+
+    input.key(KEY_SPACE, InputEvent::REPEAT);
+    input.cursor(110.0, 45.0);
+    events = input.drain(snapshot);
+    cout << "frame 2 (" << events << " events): space down/pressed= "
+         << yesNo(snapshot.isKeyDown(KEY_SPACE)) << "/" << yesNo(snapshot.wasKeyPressed(KEY_SPACE))
+         << ", cursor delta= " << snapshot.cursorDeltaX() << "," << snapshot.cursorDeltaY()
+         << ", scroll= " << snapshot.scrollY() << ", button 3 down= " << yesNo(snapshot.isButtonDown(0, 3))
+         << ", axes moved= " << yesNo(snapshot.axesMoved(0)) << endl;
+
+    input.key(KEY_SPACE, InputEvent::RELEASE);
+    this_thread::sleep_for(chrono::milliseconds(5));
+    events = input.drain(snapshot);
+    cout << "frame 3 (" << events << " events): space down/released= "
+         << yesNo(snapshot.isKeyDown(KEY_SPACE)) << "/" << yesNo(snapshot.wasKeyReleased(KEY_SPACE))
+         << ", latency= " << snapshot.meanLatency() << " ms (expect ~5)" << endl;
+
+    // ------------------------------------------------------------------
+    // A stalled consumer: the queue fills and the overflow is dropped.
+    // ------------------------------------------------------------------
+    for (size_t i = 0; i < InputQueue::CAPACITY + 100; i++)
+        input.cursor(double(i), 0.0);
+    events = input.drain(snapshot);
+    cout << "overflow: " << events << " drained, " << input.dropped() << " dropped" << endl;
+}
@@ -0,0 +1,14 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_INPUT_H
+#define RANGERALPHA_TEST_INPUT_H
+
+//! SpscQueue throughput across two threads, and InputQueue/InputSnapshot
+// edge detection and latency. No GLFW.
+struct Test_Input {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_INPUT_H
@@ -0,0 +1,117 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream> // For: std
+#include <thread>
+#include <vector>
+
+#include "../Core/Jobs/job_system.h"
+#include "Test_Jobs.h"
+
+namespace {
+using namespace Ranger;
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Something resembling a particle update.
+void work(std::vector<float>& data, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; i++) {
+        float v = data[i];
+        for (int k = 0; k < 16; k++)
+            v = std::sqrt(v * v + 1.0f) * 0.5f;
+        data[i] = v;
+    }
+}
+}
+
+void Test_Jobs::test()
+{
+    using namespace std;
+    cout << "JobSystem benchmark, " << thread::hardware_concurrency() << " cores" << endl;
+
+    static constexpr int JOBS = 1000000;
+    static constexpr int BATCH = 2000; // Children per root, well below JOB_POOL_SIZE.
+
+    // ------------------------------------------------------------------
+    // Overhead: empty jobs, create + run + wait, on every core and on the
+    // main thread alone.
+    // ------------------------------------------------------------------
+    for (int workers : { JobSystem::AUTO, 0 }) {
+        JobSystem jobs;
+        jobs.initialize(workers);
+
+        atomic<int> ran{ 0 };
+        auto start = Clock::now();
+        for (int b = 0; b < JOBS / BATCH; b++) {
+            Job* root = jobs.create([] {});
+            for (int i = 0; i < BATCH; i++)
+                jobs.run(jobs.createChild(root, [&ran] { ran.fetch_add(1, memory_order_relaxed); }));
+            jobs.run(root);
+            jobs.wait(root);
+        }
+        double ms = msSince(start);
+        cout << "empty jobs, " << jobs.threadCount() << " threads: " << (ms * 1000000.0 / JOBS)
+             << " ns/job, ran " << ran.load() << endl;
+    }
+
+    // ------------------------------------------------------------------
+    // Scaling: parallelFor over 4M items with growing thread counts.
+    // ------------------------------------------------------------------
+    static constexpr size_t ITEMS = 4000000;
+    static constexpr size_t GRAIN = 4096;
+    static constexpr int REPEATS = 5;
+
+    vector<float> data(ITEMS, 1.0f);
+
+    auto start = Clock::now();
+    for (int r = 0; r < REPEATS; r++)
+        work(data, 0, ITEMS);
+    double serial = msSince(start) / REPEATS;
+    cout << "serial: " << serial << " ms" << endl;
+
+    unsigned cores = max(1u, thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= cores; threads *= 2) {
+        JobSystem jobs;
+        jobs.initialize(int(threads) - 1);
+
+        start = Clock::now();
+        for (int r = 0; r < REPEATS; r++)
+            jobs.parallelFor(0, ITEMS, GRAIN, [&data](size_t begin, size_t end) { work(data, begin, end); });
+        double ms = msSince(start) / REPEATS;
+
+        cout << "parallelFor, " << jobs.threadCount() << " threads: " << ms << " ms, speedup "
+             << serial / ms << "x" << endl;
+    }
+
+    // ------------------------------------------------------------------
+    // Main thread pinned jobs.
+    // ------------------------------------------------------------------
+    {
+        JobSystem jobs;
+        jobs.initialize();
+
+        thread::id mainId = this_thread::get_id();
+        atomic<int> onMain{ 0 };
+        Job* root = jobs.create([] {});
+        for (int i = 0; i < 100; i++) {
+            jobs.run(jobs.createChild(root, [&jobs, &onMain, mainId](Job* job) {
+                jobs.runOnMain(jobs.createChild(job, [&onMain, mainId] {
+                    if (this_thread::get_id() == mainId)
+                        onMain.fetch_add(1);
+                }));
+            }));
+        }
+        jobs.run(root);
+        jobs.wait(root);
+        cout << "pinned jobs run on the main thread: " << onMain.load() << "/100" << endl;
+    }
+}
@@ -0,0 +1,13 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_JOBS_H
+#define RANGERALPHA_TEST_JOBS_H
+
+//! JobSystem benchmark: per job overhead and parallelFor scaling.
+struct Test_Jobs {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_JOBS_H
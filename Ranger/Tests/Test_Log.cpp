@@ -0,0 +1,112 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <fstream>
+#include <iostream> // For: std
+#include <thread>
+#include <vector>
+
+#include "../Core/Logging/log.h"
+#include "../Core/Timing/clock.h"
+#include "Test_Log.h"
+
+namespace {
+using namespace Ranger;
+
+void report(const char* what, Clock::Ticks elapsed, size_t calls)
+{
+    std::cout << what << ": " << (double(elapsed) / double(calls)) << " ns/call" << std::endl;
+}
+}
+
+void Test_Log::test()
+{
+    using namespace std;
+    cout << "Log benchmark" << endl;
+
+    static constexpr int CALLS = 10000000;
+    // Below the per thread queue size, so the hot path never drops.
+    static constexpr int BURST = 512;
+    static constexpr int BURSTS = 200;
+
+    ofstream devNull("/dev/null");
+    Log::sink(devNull);
+    Log::level(LogLevel::INFO);
+    Log::level(LogCategory::TIMING, LogLevel::WARN);
+
+    int id = 42;
+    double interval = 16.667;
+
+    // ------------------------------------------------------------------
+    // Compiled out (trace is below RANGER_LOG_LEVEL) and filtered at run
+    // time (Timing is at Warn).
+    // ------------------------------------------------------------------
+    Clock::Ticks start = Clock::now();
+    for (int i = 0; i < CALLS; i++)
+        LOG_TRACE(LogCategory::TIMING, "Timer [{}] fired, interval {}", id + i, interval);
+    report("compiled out", Clock::now() - start, CALLS);
+
+    start = Clock::now();
+    for (int i = 0; i < CALLS; i++)
+        LOG_INFO(LogCategory::TIMING, "Timer [{}] fired, interval {}", id + i, interval);
+    report("suppressed", Clock::now() - start, CALLS);
+
+    // ------------------------------------------------------------------
+    // Emitted: only the caller's side is timed; the writer drains between
+    // bursts.
+    // ------------------------------------------------------------------
+    string name = "player";
+    Clock::Ticks elapsed = 0;
+    for (int b = 0; b < BURSTS; b++) {
+        start = Clock::now();
+        for (int i = 0; i < BURST; i++)
+            LOG_WARN(LogCategory::TIMING, "UpdateTarget [{}] '{}' already scheduled, interval {}", i, name, interval);
+        elapsed += Clock::now() - start;
+        Log::flush();
+    }
+    report("emitted", elapsed, size_t(BURST) * BURSTS);
+
+    // The writer's side, formatting and I/O included.
+    start = Clock::now();
+    for (int b = 0; b < BURSTS; b++) {
+        for (int i = 0; i < BURST; i++)
+            LOG_WARN(LogCategory::TIMING, "UpdateTarget [{}] '{}' already scheduled, interval {}", i, name, interval);
+        Log::flush();
+    }
+    report("emitted + written", Clock::now() - start, size_t(BURST) * BURSTS);
+
+    // What the engine did before: format and flush on the calling thread.
+    start = Clock::now();
+    for (int b = 0; b < BURSTS; b++) {
+        for (int i = 0; i < BURST; i++)
+            devNull << "Scheduler: UpdateTarget [" << i << "] '" << name << "' already scheduled, interval "
+                    << interval << std::endl;
+    }
+    report("ostream + std::endl", Clock::now() - start, size_t(BURST) * BURSTS);
+
+    // ------------------------------------------------------------------
+    // Four threads at once, each with its own queue.
+    // ------------------------------------------------------------------
+    uint64_t droppedBefore = Log::dropped();
+    start = Clock::now();
+    vector<thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t, interval] {
+            for (int i = 0; i < BURST; i++)
+                LOG_WARN(LogCategory::JOBS, "thread {} record {} {}", t, i, interval);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    Clock::Ticks threaded = Clock::now() - start;
+    Log::flush();
+    report("emitted, 4 threads (incl. thread start)", threaded, size_t(BURST) * 4);
+    cout << "dropped: " << (Log::dropped() - droppedBefore) << endl;
+
+    // A queue overflow is dropped and reported rather than blocking.
+    Log::sink(cout);
+    for (int i = 0; i < 3000; i++)
+        LOG_INFO(LogCategory::GENERAL, "overflow {}", i);
+    Log::flush();
+    cout << "dropped after overflowing: " << (Log::dropped() - droppedBefore) << endl;
+}
@@ -0,0 +1,14 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_LOG_H
+#define RANGERALPHA_TEST_LOG_H
+
+//! ns per compiled out, suppressed and emitted log call, against
+// std::endl-flushed ostream logging. No GLFW.
+struct Test_Log {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_LOG_H
@@ -0,0 +1,115 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <cstdio>
+#include <fstream>
+#include <iostream> // For: std
+#include <vector>
+
+#include "../Core/Input/input_queue.h"
+#include "../Core/Input/input_recording.h"
+#include "../Core/Timing/clock.h"
+#include "../Extensions/math.h"
+#include "Test_Replay.h"
+
+namespace {
+using namespace Ranger;
+
+constexpr const char* PATH = "test_replay.bin";
+constexpr double TICK = 1000.0 / 60.0;
+constexpr int FRAMES = 36000;
+
+// What a frame's update would see, and draw.
+struct Frame {
+    bool down;
+    bool pressed;
+    float cursorX;
+    float random;
+};
+
+// The Engine's fixed step accumulator: true if the frame steps, which
+// is when it drains input.
+bool steps(double& accumulator, double frameTime)
+{
+    accumulator += frameTime;
+    if (accumulator < TICK)
+        return false;
+    while (accumulator >= TICK)
+        accumulator -= TICK;
+    return true;
+}
+
+Frame observe(const InputSnapshot& input)
+{
+    return Frame{ input.isKeyDown(32), input.wasKeyPressed(32), input.cursorX(), Math::genFloat() };
+}
+}
+
+void Test_Replay::test()
+{
+    using namespace std;
+    cout << "Replay benchmark" << endl;
+
+    // Live: a vsync'd 144 Hz display with jitter and the odd hitch.
+    Math::seed(2026);
+    vector<Frame> live;
+    {
+        InputQueue queue;
+        InputSnapshot input;
+        InputRecorder recorder(PATH, 2026, TICK);
+        double accumulator = 0.0;
+
+        for (int f = 0; f < FRAMES; f++) {
+            double frameTime = 6.944 + (Math::genInt() % 100) * 0.01 + (f % 997 == 0 ? 40.0 : 0.0);
+            recorder.beginFrame(frameTime);
+
+            if (f % 13 == 0)
+                queue.key(32, f % 26 == 0 ? InputEvent::PRESS : InputEvent::RELEASE);
+            if (f % 3 == 0)
+                queue.cursor(f % 800, f % 600);
+
+            if (steps(accumulator, frameTime)) {
+                queue.drain(input, &recorder);
+                live.push_back(observe(input));
+            }
+        }
+        recorder.close();
+        cout << "recorded " << recorder.frames() << " frames, " << live.size() << " steps" << endl;
+    }
+
+    ifstream file(PATH, ios::binary | ios::ate);
+    cout << "file: " << file.tellg() << " bytes, " << double(file.tellg()) / FRAMES << " bytes/frame" << endl;
+
+    // Replay, as fast as possible.
+    InputReplay replay(PATH);
+    Math::seed(replay.seed());
+    // The live run drew frame times from the RNG too.
+    vector<Frame> replayed;
+    InputSnapshot input;
+    double accumulator = 0.0;
+    double frameTime;
+
+    Clock::Ticks start = Clock::now();
+    while (replay.nextFrame(frameTime)) {
+        Math::genInt();
+        if (steps(accumulator, frameTime)) {
+            replay.drain(input);
+            replayed.push_back(observe(input));
+        }
+    }
+    double elapsed = Clock::toMilliseconds(Clock::now() - start);
+
+    size_t mismatches = live.size() == replayed.size() ? 0 : 1;
+    for (size_t i = 0; i < min(live.size(), replayed.size()); i++) {
+        const Frame& a = live[i];
+        const Frame& b = replayed[i];
+        if (a.down != b.down || a.pressed != b.pressed || a.cursorX != b.cursorX || a.random != b.random)
+            mismatches++;
+    }
+
+    cout << "replayed " << replay.frames() << " frames in " << elapsed << " ms, "
+         << (replay.frames() / elapsed) * 1000.0 << " frames/s" << endl;
+    cout << (mismatches == 0 ? "identical" : "MISMATCHED") << ": " << mismatches << " of " << live.size() << " steps differ" << endl;
+
+    std::remove(PATH);
+}
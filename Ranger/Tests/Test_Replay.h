@@ -0,0 +1,15 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_REPLAY_H
+#define RANGERALPHA_TEST_REPLAY_H
+
+//! Records a synthetic session's frame times and input, replays it and
+// checks every drained frame matches; also the RNG's repeatability and
+// the file's size and replay speed. No GLFW.
+struct Test_Replay {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_REPLAY_H
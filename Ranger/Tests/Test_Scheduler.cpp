@@ -0,0 +1,332 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+#include <chrono>
+#include <iostream> // For: std
+#include <vector>
+
+#include "../Core/Jobs/job_system.h"
+#include "../Core/Timing/scheduler.h"
+#include "../Core/Timing/timing_target.h"
+#include "Test_Scheduler.h"
+
+namespace {
+using namespace Ranger;
+
+class CountingTarget final : public TimingTarget {
+public:
+    void update(double dt) override { calls++; }
+
+    int64_t calls{ 0 };
+};
+
+class CountingUpdateTarget final : public UpdateTarget {
+public:
+    void update(double dt) override { calls++; }
+
+    int64_t calls{ 0 };
+};
+
+// An "AI agent": some math on its own state, reading a shared world value.
+class Agent final : public TimingTarget {
+public:
+    void update(double dt) override
+    {
+        float v = state;
+        for (int k = 0; k < 32; k++)
+            v = v * 0.999f + float(dt) * world * 0.001f;
+        state = v;
+    }
+
+    const float& world;
+    float state{ 1.0f };
+
+    explicit Agent(const float& w)
+        : world(w)
+    {
+    }
+};
+
+// Writes the world value the agents read.
+class WorldTarget final : public TimingTarget {
+public:
+    void update(double dt) override { world += 1.0f; }
+
+    float world{ 0.0f };
+};
+
+// Runs once, then unschedules itself from within its update.
+class OneShot final : public UpdateTarget {
+public:
+    void update(double dt) override
+    {
+        calls++;
+        scheduler->unscheduleUpdateTarget(handle);
+    }
+
+    Scheduler* scheduler{ nullptr };
+    ScheduleHandle handle;
+    int64_t calls{ 0 };
+};
+
+// Every update hands [perFrame] OneShots to the scheduler, and swaps itself
+// out for its twin.
+class Spawner final : public TimingTarget {
+public:
+    void update(double dt) override
+    {
+        for (int i = 0; i < perFrame; i++) {
+            auto& shot = (*shots)[next];
+            next = (next + 1) % shots->size();
+            shot->handle = scheduler->scheduleUpdateTarget(shot);
+        }
+        scheduler->unScheduleTimingTarget(self);
+        twin->self = scheduler->scheduleTimingTarget(twin);
+        twin->next = next;
+        calls++;
+    }
+
+    Scheduler* scheduler{ nullptr };
+    std::vector<std::shared_ptr<OneShot>>* shots{ nullptr };
+    std::shared_ptr<Spawner> twin;
+    ScheduleHandle self;
+    size_t next{ 0 };
+    int perFrame{ 0 };
+    int64_t calls{ 0 };
+};
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const char* what, double ms, size_t ops)
+{
+    std::cout << what << ": " << ms << " ms, "
+              << (ms * 1000000.0 / double(ops)) << " ns/op" << std::endl;
+}
+}
+
+void Test_Scheduler::test()
+{
+    using namespace std;
+    cout << "Scheduler benchmark" << endl;
+
+    static constexpr size_t TARGETS = 1000000;
+    static constexpr int FRAMES = 10;
+    // A handful of priorities, like a game would use.
+    static constexpr int PRIORITIES[] = { SchedulePriority::SYSTEM_HIGH_PRIORITY, -10, 0, 10 };
+
+    Scheduler scheduler;
+    scheduler.reserve(TARGETS, TARGETS);
+
+    vector<shared_ptr<CountingTarget>> targets;
+    targets.reserve(TARGETS);
+    for (size_t i = 0; i < TARGETS; i++) {
+        targets.push_back(make_shared<CountingTarget>());
+        targets.back()->setPriority(PRIORITIES[i % 4]);
+    }
+
+    vector<ScheduleHandle> handles(TARGETS);
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < TARGETS; i++)
+        handles[i] = scheduler.scheduleTimingTarget(targets[i]);
+    report("schedule TimingTargets", msSince(start), TARGETS);
+
+    start = Clock::now();
+    for (int f = 0; f < FRAMES; f++)
+        scheduler.update(16.667);
+    report("update 1M TimingTargets (per target, per frame)", msSince(start) / FRAMES, TARGETS);
+
+    start = Clock::now();
+    for (size_t i = 0; i < TARGETS; i += 2)
+        scheduler.pauseTimingTarget(handles[i]);
+    for (size_t i = 0; i < TARGETS; i += 2)
+        scheduler.resumeTimingTarget(handles[i]);
+    report("pause + resume by handle", msSince(start), TARGETS);
+
+    start = Clock::now();
+    for (size_t i = 0; i < TARGETS; i++)
+        scheduler.unScheduleTimingTarget(handles[i]);
+    report("unschedule by handle (swap-remove)", msSince(start), TARGETS);
+
+    cout << scheduler << endl;
+
+    vector<shared_ptr<CountingUpdateTarget>> updateTargets;
+    updateTargets.reserve(TARGETS);
+    for (size_t i = 0; i < TARGETS; i++)
+        updateTargets.push_back(make_shared<CountingUpdateTarget>());
+
+    start = Clock::now();
+    for (size_t i = 0; i < TARGETS; i++)
+        handles[i] = scheduler.scheduleUpdateTarget(updateTargets[i]);
+    report("schedule UpdateTargets", msSince(start), TARGETS);
+
+    start = Clock::now();
+    for (int f = 0; f < FRAMES; f++)
+        scheduler.update(16.667);
+    report("update 1M UpdateTargets (per target, per frame)", msSince(start) / FRAMES, TARGETS);
+
+    start = Clock::now();
+    for (size_t i = 0; i < TARGETS; i++)
+        scheduler.unscheduleUpdateTarget(handles[i]);
+    report("unschedule UpdateTargets by handle", msSince(start), TARGETS);
+
+    cout << scheduler << endl;
+
+    // Interval UpdateTargets (1-5 seconds) live in the timing wheel; a frame
+    // only pays for the ones coming due.
+    for (auto& target : updateTargets)
+        target->calls = 0;
+
+    start = Clock::now();
+    for (size_t i = 0; i < TARGETS; i++)
+        handles[i] = scheduler.scheduleUpdateTarget(updateTargets[i], 1000.0 + double(i % 4001), Timer::REPEAT_FOREVER);
+    report("schedule interval UpdateTargets", msSince(start), TARGETS);
+
+    static constexpr int WHEEL_FRAMES = 600; // 10 seconds at 60Hz
+    start = Clock::now();
+    for (int f = 0; f < WHEEL_FRAMES; f++)
+        scheduler.update(16.667);
+    double ms = msSince(start);
+
+    int64_t calls = 0;
+    for (auto& target : updateTargets)
+        calls += target->calls;
+    cout << "update 1M interval UpdateTargets: " << (ms / WHEEL_FRAMES) << " ms/frame, "
+         << calls << " callbacks" << endl;
+
+    start = Clock::now();
+    for (size_t i = 0; i < TARGETS; i++)
+        scheduler.unscheduleUpdateTarget(handles[i]);
+    report("unschedule interval UpdateTargets by handle", msSince(start), TARGETS);
+
+    cout << scheduler << endl;
+
+    // Timer pool churn: 100k schedules + unschedules per second (at 60Hz)
+    // over a steady 10k UpdateTargets. Once warm no Timer is constructed.
+    static constexpr size_t LIVE = 10000;
+    static constexpr size_t CHURN_PER_FRAME = 100000 / 60;
+    static constexpr int CHURN_FRAMES = 600;
+
+    Scheduler churn;
+    churn.initialize();
+
+    vector<ScheduleHandle> live(LIVE);
+    for (size_t i = 0; i < LIVE; i++)
+        live[i] = churn.scheduleUpdateTarget(updateTargets[i]);
+
+    size_t oldest = 0;
+    size_t next = LIVE;
+    start = Clock::now();
+    for (int f = 0; f < CHURN_FRAMES; f++) {
+        for (size_t c = 0; c < CHURN_PER_FRAME; c++) {
+            churn.unscheduleUpdateTarget(live[oldest]);
+            live[oldest] = churn.scheduleUpdateTarget(updateTargets[next]);
+            oldest = (oldest + 1) % LIVE;
+            next = (next + 1) % TARGETS;
+            if (next < LIVE)
+                next = LIVE; // Skip targets scheduled at the start.
+        }
+        churn.update(16.667);
+    }
+    report("schedule + unschedule churn (per pair)", msSince(start), CHURN_FRAMES * CHURN_PER_FRAME);
+
+    Scheduler::TimerPoolStats pool = churn.timerPoolStats();
+    cout << "timer pool: " << pool.live << " live, " << pool.highWater << " high-water, "
+         << pool.constructed << " constructed, " << pool.acquired << " acquired, "
+         << (pool.reuseRate() * 100.0) << "% reused" << endl;
+
+
+    // Targets changing the schedule from within update: a spawner swapping
+    // itself for its twin every frame and scheduling 1000 one-shots, which
+    // unschedule themselves when they run (on the next frame).
+    {
+        static constexpr int SPAWN_FRAMES = 600;
+        static constexpr int PER_FRAME = 1000;
+
+        Scheduler s;
+        s.initialize();
+
+        vector<shared_ptr<OneShot>> shots;
+        for (int i = 0; i < PER_FRAME * 2; i++) {
+            shots.push_back(make_shared<OneShot>());
+            shots.back()->scheduler = &s;
+        }
+
+        auto a = make_shared<Spawner>();
+        auto b = make_shared<Spawner>();
+        for (auto& spawner : { a, b }) {
+            spawner->scheduler = &s;
+            spawner->shots = &shots;
+            spawner->perFrame = PER_FRAME;
+        }
+        a->twin = b;
+        b->twin = a;
+        a->self = s.scheduleTimingTarget(a);
+
+        start = Clock::now();
+        for (int f = 0; f < SPAWN_FRAMES; f++)
+            s.update(16.667);
+        ms = msSince(start);
+
+        int64_t shotCalls = 0;
+        for (auto& shot : shots)
+            shotCalls += shot->calls;
+        cout << "deferred changes: " << (ms / SPAWN_FRAMES) << " ms/frame, "
+             << (a->calls + b->calls) << " spawner updates (expected " << SPAWN_FRAMES << "), "
+             << shotCalls << " one-shots (expected " << int64_t(SPAWN_FRAMES - 1) * PER_FRAME << ")" << endl;
+
+        pool = s.timerPoolStats();
+        cout << "timer pool: " << pool.live << " live, " << pool.highWater << " high-water, "
+             << pool.constructed << " constructed" << endl;
+        cout << s << endl;
+    }
+
+    // Parallel TimingTargets: 200k agents reading the world, interleaved
+    // with a world target writing it every 50k agents. Serial and parallel
+    // runs must produce identical agent states.
+    static constexpr size_t AGENTS = 200000;
+    static constexpr int PARALLEL_FRAMES = 20;
+    static constexpr TimingTarget::ComponentSet WORLD = 1 << 0;
+
+    JobSystem jobs;
+    jobs.initialize();
+
+    vector<float> results[2];
+    for (int run = 0; run < 2; run++) {
+        bool parallel = run == 1;
+        Scheduler s;
+        s.useJobSystem(parallel ? &jobs : nullptr);
+
+        vector<shared_ptr<WorldTarget>> worlds;
+        vector<shared_ptr<Agent>> agents;
+        for (size_t i = 0; i < AGENTS; i++) {
+            if (i % 50000 == 0) {
+                worlds.push_back(make_shared<WorldTarget>());
+                worlds.back()->access(0, WORLD);
+                s.scheduleTimingTarget(worlds.back());
+            }
+            agents.push_back(make_shared<Agent>(worlds.back()->world));
+            // Each agent only writes its own state, which needn't be declared.
+            agents.back()->access(WORLD, 0);
+            s.scheduleTimingTarget(agents.back());
+        }
+
+        start = Clock::now();
+        for (int f = 0; f < PARALLEL_FRAMES; f++)
+            s.update(16.667);
+        double frameMs = msSince(start) / PARALLEL_FRAMES;
+
+        cout << (parallel ? "parallel" : "serial") << " update of " << AGENTS << " agents ("
+             << (parallel ? jobs.threadCount() : 1) << " threads, " << s.levelCount() << " levels): "
+             << frameMs << " ms/frame" << endl;
+
+        for (auto& agent : agents)
+            results[run].push_back(agent->state);
+    }
+    cout << "parallel result " << (results[0] == results[1] ? "matches" : "DIFFERS FROM") << " serial" << endl;
+}
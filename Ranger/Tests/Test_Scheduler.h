@@ -0,0 +1,13 @@
+//
+// Created by William DeVore on 10/19/26.
+//
+
+#ifndef RANGERALPHA_TEST_SCHEDULER_H
+#define RANGERALPHA_TEST_SCHEDULER_H
+
+//! Scheduler benchmark: 1M scheduled targets.
+struct Test_Scheduler {
+    void test();
+};
+
+#endif //RANGERALPHA_TEST_SCHEDULER_H
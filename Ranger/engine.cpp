@@ -5,12 +5,24 @@
 #include <GL/glew.h>
 
 #include <GLFW/glfw3.h>
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <random>
+#include <sstream>
 #include <thread>
 
 #include "Components/stage.h"
+#include "Core/Jobs/job_system.h"
+#include "Core/Logging/log.h"
+#include "Core/Memory/alloc_tracker.h"
+#include "Core/Memory/frame_arena.h"
+#include "Core/Timing/clock.h"
+#include "Core/Timing/scheduler.h"
+#include "Extensions/math.h"
 #include "IO/configuration.h"
+#include "Rendering/gl_stats.h"
 #include "Rendering/rendercontext.h"
 #include "engine.h"
 
@@ -20,34 +32,124 @@ Engine::Engine()
 {
 }
 
-Engine::~Engine() { std::cout << "Engine::~Engine" << std::endl; }
+Engine::~Engine() { LOG_DEBUG(LogCategory::ENGINE, "Engine::~Engine"); }
 
 void Engine::configure(ConfigureCallback preConfCallback)
 {
-    std::cout << "Engine::configure" << std::endl;
+    LOG_DEBUG(LogCategory::ENGINE, "Engine::configure");
 
     using namespace Ranger;
 
     if (!_fullScreen) {
         // Read JSON config for position
+        MemoryScope tag(MemoryTag::IO);
         App::config()->configure("config.json");
         if (App::config()->isShowConfig())
             std::cout << "Engine: " << *(App::config().get()) << std::endl;
     }
 
+    Log::level(Log::parseLevel(App::config()->logLevel()));
+    for (const auto& category : App::config()->logCategories())
+        Log::level(Log::parseCategory(category.first), Log::parseLevel(category.second));
+
     if (App::config()->isEngineEnabled())
-        std::cout << "Engine: "
-                  << "Starting..." << std::endl;
+        LOG_INFO(LogCategory::ENGINE, "Engine: Starting...");
     else {
-        std::cerr << "Engine: "
-                  << " is disabled in the configuration file." << std::endl;
+        LOG_ERROR(LogCategory::ENGINE, "Engine: is disabled in the configuration file.");
         return;
     }
 
     _fpsUpdateRate = App::config()->FPSRefreshRate();
-    std::cout << "refresh rate every (" << _fpsUpdateRate << ") seconds"
-              << std::endl;
+    LOG_INFO(LogCategory::ENGINE, "refresh rate every ({}) seconds", _fpsUpdateRate);
+
+    _tickPeriod = 1000.0 / App::config()->tickRate();
+    _maxCatchUpSteps = App::config()->maxCatchUpSteps();
+    _pipelined = App::config()->isPipelined();
+    LOG_INFO(LogCategory::ENGINE, "fixed update every ({}) ms, catching up at most ({}) steps per frame",
+        _tickPeriod, _maxCatchUpSteps);
+    if (_pipelined)
+        LOG_INFO(LogCategory::ENGINE, "update and render are pipelined");
+
+    // Before the window (a replay turns vsync off) and before the dev's
+    // code can draw random numbers.
+    _configureReplay();
+
+    // Replays run as fast as they can.
+    _framePacer.configure(_replay ? FramePacer::Mode::OFF : FramePacer::parseMode(App::config()->frameLimiter()),
+        App::config()->targetFPS(), App::config()->idleFPS(), App::config()->spinMargin());
+    if (_framePacer.mode() != FramePacer::Mode::OFF)
+        LOG_INFO(LogCategory::ENGINE, "frame limiter: {} at ({}) FPS",
+            FramePacer::modeName(_framePacer.mode()), App::config()->targetFPS());
+
+    _frameStats.configure(App::config()->frameBudget(), App::config()->frameStatsWindow());
+    LOG_INFO(LogCategory::ENGINE, "frame budget ({}) ms", _frameStats.budget());
+
+    _allocWarmup = App::config()->allocWarmupFrames();
+    AllocTracker::abortOnViolation(App::config()->isAllocAbort());
+    if (AllocTracker::ENABLED)
+        LOG_INFO(LogCategory::ENGINE, "allocation tracking on, frames after ({}) shouldn't allocate", _allocWarmup);
+
+    // Before any thread makes its arena.
+    FrameArena::configure(size_t(App::config()->frameArenaSize()) * 1024);
+
+    // Profiling zones convert cycles using this.
+    Clock::calibrate();
+    LOG_INFO(LogCategory::ENGINE, "cycle counter: {} ns/cycle", Clock::nanosecondsPerCycle());
+
+    _headless = App::config()->isHeadless();
+    if (_headless)
+        LOG_INFO(LogCategory::ENGINE, "Engine: Headless, ({}) frames of ({}) ms",
+            App::config()->headlessFrames(), _tickPeriod);
+    else if (!_constructWindow())
+        return;
+
+    _loopFor = App::config()->loopFor();
+    if (_loopFor < 0)
+        LOG_INFO(LogCategory::ENGINE, "Engine: Looping forever");
+    else
+        LOG_INFO(LogCategory::ENGINE, "Engine: Looping for: {}", _loopFor);
+
+    App::scheduler()->initialize();
+
+    // The configuring thread is the GL thread and becomes the jobs' main thread.
+    App::jobs()->initialize(App::config()->jobWorkers());
+    App::scheduler()->useJobSystem(App::jobs().get());
+    LOG_INFO(LogCategory::JOBS, "Engine: Job system running on ({}) threads", App::jobs()->threadCount());
+
+    // The engine has completed the pre phase. Now it is the dev's turn.
+    preConfCallback(*this);
+}
+
+void Engine::_configureReplay()
+{
+    const ConfigurationPtr& config = App::config();
+    uint64_t seed = config->randomSeed();
+
+    if (!config->replayInput().empty()) {
+        _replay = std::make_unique<InputReplay>(config->replayInput());
+        seed = _replay->seed();
+        if (_replay->tickPeriod() != _tickPeriod) {
+            LOG_WARN(LogCategory::ENGINE, "Engine: Replay recorded at ({}) ms steps, not ({})",
+                _replay->tickPeriod(), _tickPeriod);
+            _tickPeriod = _replay->tickPeriod();
+        }
+        config->lockToVSync(false);
+        LOG_INFO(LogCategory::ENGINE, "Engine: Replaying '{}', seed {}", config->replayInput(), seed);
+    } else {
+        if (seed == 0)
+            seed = std::random_device{}() | (uint64_t(std::random_device{}()) << 32);
+
+        if (!config->recordInput().empty()) {
+            _recorder = std::make_unique<InputRecorder>(config->recordInput(), seed, _tickPeriod);
+            LOG_INFO(LogCategory::ENGINE, "Engine: Recording input to '{}', seed {}", config->recordInput(), seed);
+        }
+    }
 
+    Math::seed(seed);
+}
+
+bool Engine::_constructWindow()
+{
     // Construct GLFW window
     _window = std::make_unique<Window>();
 
@@ -63,33 +165,31 @@ void Engine::configure(ConfigureCallback preConfCallback)
 
         glfwSetKeyCallback(_window->glfwWindow(), func);
 
-        std::cout << "Engine: "
-                  << "Window constructed: " << std::endl;
+        LOG_INFO(LogCategory::ENGINE, "Engine: Window constructed");
 
         // Bind RenderContext to SceneManager
         //            App::sceneManager->setRenderContext(App::renderContext);
     } else {
-        std::cerr << "Engine: "
-                  << "Failed to construct Window." << std::endl;
-        return;
+        LOG_ERROR(LogCategory::ENGINE, "Engine: Failed to construct Window.");
+        return false;
     }
 
-    _loopFor = App::config()->loopFor();
-    if (_loopFor < 0)
-        std::cout << "Engine: "
-                  << "Looping forever" << std::endl;
-    else
-        std::cout << "Engine: "
-                  << "Looping for: " << _loopFor << std::endl;
-
-    //        App::scheduler->initialize();
-
-    // The engine has completed the pre phase. Now it is the dev's turn.
-    preConfCallback(*this);
+    return true;
 }
 
 void Engine::start()
 {
+    if (_headless) {
+        _stage = std::make_shared<Stage>();
+        _stage->constructHeadless();
+
+        _runHeadless();
+
+        LOG_INFO(LogCategory::ENGINE, "Engine: Ranger is exiting...");
+        Log::flush();
+        return;
+    }
+
     // Define the viewport dimensions
     _viewport.setDimensions(App::config());
     _viewport.apply();
@@ -125,15 +225,15 @@ void Engine::start()
     _stage = std::make_shared<Stage>();
     _stage->construct((float)_viewport.screenWidth, (float)_viewport.screenHeight);
 
-    std::cout << "###########################################" << std::endl;
-    std::cout << "Engine: "
-              << "Ranger is starting!" << std::endl;
-    std::cout << "###########################################" << std::endl;
-    if (_loopFor < 0)
+    LOG_INFO(LogCategory::ENGINE, "Engine: Ranger is starting!");
+    if (_loopFor < 0) {
+        if (_pipelined)
+            _startSimulation();
         loop();
+    }
 
-    std::cout << "Engine: "
-              << "Ranger is exiting..." << std::endl;
+    LOG_INFO(LogCategory::ENGINE, "Engine: Ranger is exiting...");
+    Log::flush();
 }
 
 void Engine::configureComplete()
@@ -145,48 +245,57 @@ void Engine::loop()
     //        int loopCount = 0;
     // std::cout << "Engine: " << "FRAME_PERIOD: " << FRAME_PERIOD << std::endl;
 
-    // glfwGetTime returns the number of seconds since the app started running.
-    // "seconds" is typically measured in micro or nano time units.
-    double lastTime = glfwGetTime();
-    double currentTime = glfwGetTime();
-    double deltaTime{ FRAME_PERIOD };
+    // Clock::seconds returns the number of seconds since the app started running,
+    // from a monotonic nanosecond clock.
+    double lastTime = Clock::seconds();
+    double currentTime = Clock::seconds();
+    _frameClock.tick();
 
     int nbFrames = 0;
 
-    std::cout << std::fixed << std::setw(11) << std::setprecision(4) << std::endl;
     const ConfigurationPtr& config = App::config();
-    bool stickActive = false;
 
-    while (_window->running()) {
+    while (_window->running() && !_replayFinished) {
+        // Waits out the rest of the frame, if limiting, before input is
+        // sampled; in adaptive mode as late as rendering allows.
+        _framePacer.focused(_window->isFocused());
+        _framePacer.wait();
+
+        // Once warmed up, a frame shouldn't touch the heap.
+        MemoryScope tag(MemoryTag::ENGINE);
+        NoAllocScope steady(_frames >= uint64_t(_allocWarmup));
+
         _window->poll();
 
+        // Jobs pinned to this (GL) thread.
+        App::jobs()->pumpMainThread();
+
+        // Scaled (and zero while paused) game time.
+        _frameClock.tick();
+        double frameTime = _frameClock.deltaMilliseconds();
+
         // ####################################################################
         // BEGIN Update and Render
         // ####################################################################
 
         if (!_pauseEnabled) {
-        // BEGIN ------------- UPDATE ----------------------------------------
-#pragma region Show joystick info
-            if (config->isShowJoystickInfo()) {
-                const float* axes = glfwGetJoystickAxes(GLFW_JOYSTICK_1, &_joyAxisCount);
-                stickActive = false;
-                for (int i = 0; i < _joyAxisCount; i++) {
-                    if (axes[i] != 0.0) {
-                        std::cout << "(" << i << ")" << axes[i] << " # ";
-                        stickActive = true;
-                    }
-                }
-                if (stickActive)
-                    std::cout << std::endl;
+            // BEGIN ------------- UPDATE ----------------------------------------
+            _frames++;
+            if (_pipelined) {
+                // Frame N+1 is simulated on the simulation thread while
+                // this thread renders the latest snapshot (frame N).
+                _kickSimulation(frameTime);
+            } else {
+                _simulate(_frames, frameTime);
             }
-#pragma endregion
-
-            _currentUpdateTime = glfwGetTime();
 
-            // Refresh scheduler
-            //                App::scheduler->update(deltaTime);
-
-            _deltaUpdateTime = glfwGetTime() - _currentUpdateTime;
+            const RenderSnapshot& snapshot = _snapshots.acquire();
+            _deltaUpdateTime = snapshot.simEnd - snapshot.simStart;
+            _updateSteps = snapshot.updateSteps;
+            _alpha = snapshot.alpha;
+            _inputEvents = snapshot.inputEvents;
+            _inputLatencyTotal = snapshot.inputLatency;
+            _inputLatencyMax = std::max(_inputLatencyMax, snapshot.inputLatencyMax);
             // END ------------- UPDATE ----------------------------------------
 
             // This clear sync locked with the vertical refresh. The clear itself
@@ -194,16 +303,20 @@ void Engine::loop()
             _window->clear();
 
             // BEGIN ------------- RENDER ----------------------------------------
-            _currentRenderTime = glfwGetTime();
+            _currentRenderTime = Clock::seconds();
 
             if (_window->fillPolyMode)
                 glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
             else
                 glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-            bool continueStepping = _stage->step();
+            bool continueStepping;
+            {
+                MemoryScope tag(MemoryTag::RENDERING);
+                continueStepping = _stage->step(snapshot);
+            }
             if (!continueStepping) {
-                std::cout << "Engine::loop stage stopped stepping, most likely from a lack of Scenes." << std::endl;
+                LOG_WARN(LogCategory::ENGINE, "Engine::loop stage stopped stepping, most likely from a lack of Scenes.");
                 break;
             }
 
@@ -220,21 +333,42 @@ void Engine::loop()
             //                }
 #pragma endregion
 
-            _deltaRenderTime = glfwGetTime() - _currentRenderTime;
+            double renderEnd = Clock::seconds();
+            _deltaRenderTime = renderEnd - _currentRenderTime;
             // END ------------- RENDER ----------------------------------------
 
+            // Pinned jobs the simulation queued while rendering.
+            App::jobs()->pumpMainThread();
+
             // Swap is synced to the vertical which means it is waits based on the monitor refresh rate.
             // The window->clear is also locked to the sync.
-            _currentSwapTime = glfwGetTime();
+            _framePacer.rendered();
+            _currentSwapTime = Clock::seconds();
             _window->swap();
-            _deltaSwapTime = glfwGetTime() - _currentSwapTime;
+            double presented = Clock::seconds();
+            GLStats::endFrame();
+            _deltaSwapTime = presented - _currentSwapTime;
+
+            _measurePipeline(snapshot, _currentRenderTime, renderEnd, presented);
+
+            if (_lastPresented >= 0.0) {
+                _frameTime = (presented - _lastPresented) * 1000.0;
+                _frameStats.record(_deltaUpdateTime * 1000.0, _deltaRenderTime * 1000.0,
+                    _deltaSwapTime * 1000.0, _frameTime);
+            }
+            _lastPresented = presented;
         }
 
+        _framePacer.presented();
+
+        // Frame scratch from two frames ago is free again.
+        FrameArena::advance();
+
         // ####################################################################
         // END Update and Render
         // ####################################################################
 
-        currentTime = glfwGetTime();
+        currentTime = Clock::seconds();
         nbFrames++;
 
 #pragma region Show timing
@@ -249,23 +383,449 @@ void Engine::loop()
             _fps = int(nbFrames / _fpsUpdateRate);
 
             if (config->isShowTimingInfo()) {
-                std::cout
-                    << "~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~"
-                    << std::endl;
-                std::cout << _fps << " FPS" << std::endl;
-                std::cout << _deltaSwapTime << " Swap ms/loop" << std::endl;
-                std::cout << _deltaUpdateTime << " Update ms/loop" << std::endl;
-                std::cout << _deltaRenderTime << " Render ms/loop" << std::endl;
-                std::cout << (1000.0 * _fpsUpdateRate) / double(nbFrames)
-                          << " ms/frame, Frames: " << nbFrames << std::endl;
+                LOG_INFO(LogCategory::ENGINE, "{} FPS, {} ms/frame, Frames: {}",
+                    _fps, (1000.0 * _fpsUpdateRate) / double(nbFrames), nbFrames);
+                LOG_INFO(LogCategory::ENGINE, "{} Swap, {} Update, {} Render ms/loop",
+                    _deltaSwapTime, _deltaUpdateTime, _deltaRenderTime);
+                LOG_INFO(LogCategory::ENGINE, "{} Updates/sec, {} dropped",
+                    (_totalSteps - _reportedSteps) / _fpsUpdateRate, _droppedSteps - _reportedDropped);
+                LOG_INFO(LogCategory::ENGINE, "{} Update to present ms{}, {}% update/render overlap",
+                    _presentLatency, _pipelined ? " (pipelined)" : "", _overlap * 100.0);
+
+                int64_t events = _inputEvents - _reportedInputEvents;
+                LOG_INFO(LogCategory::INPUT, "{} input events, {} ms avg ({} max) input to update, {} dropped",
+                    events, events > 0 ? (_inputLatencyTotal - _reportedInputLatency) / double(events) : 0.0,
+                    _inputLatencyMax, _window->input().dropped());
+
+                const FrameStats::Summary& frame = _frameStats.recent(FrameStats::TOTAL);
+                LOG_INFO(LogCategory::ENGINE, "{} p50, {} p90, {} p99, {} p99.9, {} max ms/frame, {} hitches",
+                    frame.p50, frame.p90, frame.p99, frame.p999, frame.max, frame.hitches);
+
+                const FramePacer::Stats& pacing = _framePacer.stats();
+                LOG_INFO(LogCategory::ENGINE, "{} +/- {} ms/frame ({} - {}), {} late",
+                    pacing.mean, pacing.stddev(), pacing.min, pacing.max, pacing.late);
+                if (_framePacer.mode() != FramePacer::Mode::OFF || _framePacer.isIdle())
+                    LOG_INFO(LogCategory::ENGINE, "{} ms slept, {} ms spun, {} ms frame cost{}",
+                        _framePacer.sleptMilliseconds(), _framePacer.spunMilliseconds(),
+                        _framePacer.frameCost(), _framePacer.isIdle() ? " (idle)" : "");
+
+                FrameArena::Stats arena = FrameArena::stats();
+                LOG_INFO(LogCategory::ENGINE, "{} KB frame arena peak of {} KB, {} overflows ({} KB)",
+                    FrameArena::takePeak() / 1024.0, config->frameArenaSize(),
+                    arena.overflows - _reportedArena.overflows,
+                    (arena.overflowBytes - _reportedArena.overflowBytes) / 1024.0);
+                _reportedArena = arena;
+
+                if (GLStats::ENABLED) {
+                    const GLStats::Counters& gl = GLStats::frame();
+                    const GLStats::Resources& gpu = GLStats::resources();
+                    LOG_INFO(LogCategory::ENGINE, "{} draws, {} primitives, {} binds ({} redundant), {} programs, {} KB uploaded per frame",
+                        gl.drawCalls, gl.primitives, gl.binds, gl.redundant, gl.programSwitches, gl.uploadBytes / 1024.0);
+                    LOG_INFO(LogCategory::ENGINE, "{} buffers ({} KB), {} textures ({} KB) live",
+                        gpu.buffers, gpu.bufferBytes / 1024.0, gpu.textures, gpu.textureBytes / 1024.0);
+                }
+
+                if (AllocTracker::ENABLED)
+                    _reportAllocations(nbFrames);
             }
+            _framePacer.resetStats();
             nbFrames = 0; // Frames that occurred during the time second interval.
+            _reportedSteps = _totalSteps;
+            _reportedDropped = _droppedSteps;
+            _reportedInputEvents = _inputEvents;
+            _reportedInputLatency = _inputLatencyTotal;
+            _inputLatencyMax = 0.0;
+            _resetPipelineMeasures();
             lastTime += _fpsUpdateRate; // Move forward to the next Rate.
         }
 #pragma endregion
     }
 
-    std::cout << "Engine::loop: loop exited, beginning release cycle..."
-              << std::endl;
+    LOG_INFO(LogCategory::ENGINE, "Engine::loop: loop exited, beginning release cycle...");
+
+    _stopSimulation();
+    App::jobs()->shutdown();
+
+    _finishRun();
+}
+
+void Engine::_runHeadless()
+{
+    const int frames = App::config()->headlessFrames();
+    LOG_INFO(LogCategory::ENGINE, "Engine: Ranger is starting headless!");
+
+    // Nothing waits on a display or the clock: frames run back to back,
+    // each exactly one fixed step unless a replay says otherwise.
+    ZoneStats jobs;
+    int ran = 0;
+
+    Clock::Ticks start = Clock::now();
+    Clock::Ticks frameStart = start;
+    while (_replay ? !_replayFinished : ran < frames) {
+        _simulate(uint64_t(ran) + 1, _tickPeriod);
+        if (_replayFinished)
+            break;
+        // No GL: preloaded scenes complete without uploading, so scene
+        // switches still happen.
+        _stage->sceneManager()->pumpLoading(false);
+        Clock::Ticks updated = Clock::now();
+        {
+            ProfileZone zone(jobs);
+            App::jobs()->pumpMainThread();
+        }
+        Clock::Ticks frameEnd = Clock::now();
+
+        ran++;
+        FrameArena::advance();
+        _frameStats.record(Clock::toMilliseconds(updated - frameStart), 0.0, 0.0,
+            Clock::toMilliseconds(frameEnd - frameStart));
+        frameStart = frameEnd;
+    }
+    double elapsed = Clock::toSeconds(Clock::now() - start);
+
+    App::jobs()->shutdown();
+
+    if (ran > 0 && elapsed > 0.0) {
+        double simulated = _simSteps * _tickPeriod / 1000.0;
+        LOG_INFO(LogCategory::ENGINE, "Headless: {} frames, {} steps in {} s, {} frames/s, {}x real time",
+            ran, _simSteps, elapsed, ran / elapsed, simulated / elapsed);
+        LOG_INFO(LogCategory::ENGINE, "Headless: {} stage, {} scheduler, {} capture, {} jobs ms/frame",
+            _stageZone.milliseconds() / ran, _schedulerZone.milliseconds() / ran,
+            _captureZone.milliseconds() / ran, jobs.milliseconds() / ran);
+
+        FrameStats::Summary total = _frameStats.overall(FrameStats::TOTAL);
+        LOG_INFO(LogCategory::ENGINE, "Headless: {} p50, {} p99, {} p99.9, {} max ms/frame, {} over ({}) ms",
+            total.p50, total.p99, total.p999, total.max, total.hitches, _frameStats.budget());
+    }
+
+    _finishRun();
+}
+
+void Engine::_finishRun()
+{
+    if (_recorder) {
+        _recorder->close();
+        LOG_INFO(LogCategory::INPUT, "Engine: {} frames of input recorded to '{}'",
+            _recorder->frames(), App::config()->recordInput());
+    }
+    if (_replay)
+        LOG_INFO(LogCategory::INPUT, "Engine: {} frames of '{}' replayed{}", _replay->frames(),
+            App::config()->replayInput(), _replay->finished() ? "" : ", stopped early");
+
+    _writeFrameStats();
+    _compareFrameStats();
+    _writeGLStats();
+}
+
+void Engine::_writeFrameStats()
+{
+    const std::string& path = App::config()->frameStatsFile();
+    if (path.empty() || _frameStats.frames() == 0)
+        return;
+
+    if (_frameStats.writeJson(path))
+        LOG_INFO(LogCategory::ENGINE, "Engine: {} frames of timing written to '{}'", _frameStats.frames(), path);
+    else
+        LOG_ERROR(LogCategory::ENGINE, "Engine: Couldn't write frame timing to '{}'", path);
+}
+
+void Engine::_writeGLStats()
+{
+    const std::string& path = App::config()->glStatsFile();
+    if (!GLStats::ENABLED || path.empty() || GLStats::frames() == 0)
+        return;
+
+    if (GLStats::writeJson(path))
+        LOG_INFO(LogCategory::ENGINE, "Engine: GL calls of {} frames written to '{}'", GLStats::frames(), path);
+    else
+        LOG_ERROR(LogCategory::ENGINE, "Engine: Couldn't write GL stats to '{}'", path);
+}
+
+void Engine::_compareFrameStats()
+{
+    const std::string& path = App::config()->replayBaseline();
+    if (path.empty() || _frameStats.frames() == 0)
+        return;
+
+    std::ifstream file(path);
+    if (!file) {
+        LOG_ERROR(LogCategory::ENGINE, "Engine: Couldn't open baseline '{}'", path);
+        return;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+
+    std::string errors;
+    json11::Json baseline = json11::Json::parse(text.str(), errors);
+    if (!errors.empty()) {
+        LOG_ERROR(LogCategory::ENGINE, "Engine: Baseline '{}' isn't valid JSON: {}", path, errors);
+        return;
+    }
+
+    // Positive is slower than the baseline.
+    auto change = [](double was, double is) { return was > 0.0 ? (is - was) / was * 100.0 : 0.0; };
+
+    LOG_INFO(LogCategory::ENGINE, "Compared to '{}': {} frames, baseline {}",
+        path, _frameStats.frames(), baseline["frames"].number_value());
+    for (int p = 0; p < FrameStats::PHASES; p++) {
+        auto phase = static_cast<FrameStats::Phase>(p);
+        const json11::Json& was = baseline["phases"][FrameStats::phaseName(phase)];
+        FrameStats::Summary is = _frameStats.overall(phase);
+
+        LOG_INFO(LogCategory::ENGINE, "  {} mean {} ms ({}%), p50 {} ({}%), p99 {} ({}%)",
+            FrameStats::phaseName(phase), is.mean, change(was["mean"].number_value(), is.mean),
+            is.p50, change(was["p50"].number_value(), is.p50), is.p99, change(was["p99"].number_value(), is.p99));
+        LOG_INFO(LogCategory::ENGINE, "  {} p99.9 {} ms ({}%), max {} ({}%), {} hitches (was {})",
+            FrameStats::phaseName(phase), is.p999, change(was["p99.9"].number_value(), is.p999),
+            is.max, change(was["max"].number_value(), is.max), is.hitches, was["hitches"].number_value());
+    }
+}
+
+// ####################################################################
+// Simulation
+// ####################################################################
+void Engine::_simulate(uint64_t frame, double frameTime)
+{
+    double start = Clock::seconds();
+    NoAllocScope steady(frame > uint64_t(_allocWarmup));
+
+    if (_replay) {
+        // The recorded frame time, so the same steps see the same input.
+        if (!_replay->nextFrame(frameTime)) {
+            _replayFinished = true;
+            return;
+        }
+    } else if (_recorder)
+        _recorder->beginFrame(frameTime);
+
+    // Fixed timestep: the simulation always advances in steps of
+    // _tickPeriod regardless of the frame rate.
+    _accumulator += frameTime;
+
+    // Input is drained every frame, so the queue can't fill while nothing
+    // steps (paused or stalled). What is held is current; the edges pile up
+    // until a frame that steps has seen them, so none is lost.
+    {
+        MemoryScope tag(MemoryTag::INPUT);
+        double latency = _inputStepped ? 0.0 : _input.meanLatency() * _input.events();
+        int events = _drainInput(_inputStepped);
+        _simInputEvents += events;
+        _simInputLatency += _input.meanLatency() * _input.events() - latency;
+
+        if (App::config()->isShowJoystickInfo() && _accumulator >= _tickPeriod && _input.axesMoved(0))
+            LOG_INFO(LogCategory::INPUT, "joystick 0 axes: {} {} {} {} {} {} {} {}",
+                _input.axis(0, 0), _input.axis(0, 1), _input.axis(0, 2), _input.axis(0, 3),
+                _input.axis(0, 4), _input.axis(0, 5), _input.axis(0, 6), _input.axis(0, 7));
+    }
+
+    ZoneStats stage = _stageZone;
+    ZoneStats scheduler = _schedulerZone;
+    ZoneStats capture = _captureZone;
+
+    int steps = 0;
+    while (_accumulator >= _tickPeriod && steps < _maxCatchUpSteps) {
+        {
+            ProfileZone zone(_stageZone);
+            MemoryScope tag(MemoryTag::SCENE);
+            _stage->update(_tickPeriod);
+        }
+        {
+            ProfileZone zone(_schedulerZone);
+            MemoryScope tag(MemoryTag::TIMING);
+            App::scheduler()->update(_tickPeriod);
+        }
+        _accumulator -= _tickPeriod;
+        steps++;
+    }
+
+    if (_accumulator >= _tickPeriod) {
+        // Too far behind (a hitch or a debugger break). Drop the
+        // backlog rather than spiral trying to catch up.
+        _simDropped += int64_t(_accumulator / _tickPeriod);
+        _accumulator = std::fmod(_accumulator, _tickPeriod);
+    }
+    _simSteps += steps;
+    _inputStepped = steps > 0;
+
+    RenderSnapshot& snapshot = _snapshots.back();
+    {
+        ProfileZone zone(_captureZone);
+        MemoryScope tag(MemoryTag::SCENE);
+        _stage->capture(snapshot);
+    }
+    snapshot.frame = frame;
+    snapshot.alpha = static_cast<float>(_accumulator / _tickPeriod);
+    snapshot.updateSteps = steps;
+    snapshot.totalSteps = _simSteps;
+    snapshot.droppedSteps = _simDropped;
+    snapshot.inputEvents = _simInputEvents;
+    snapshot.inputLatency = _simInputLatency;
+    snapshot.inputLatencyMax = steps > 0 ? _input.maxLatency() : 0.0;
+    snapshot.stageTime = _stageZone.milliseconds() - stage.milliseconds();
+    snapshot.schedulerTime = _schedulerZone.milliseconds() - scheduler.milliseconds();
+    snapshot.captureTime = _captureZone.milliseconds() - capture.milliseconds();
+    snapshot.scheduler = App::scheduler()->counts();
+    snapshot.simStart = start;
+    snapshot.simEnd = Clock::seconds();
+    _snapshots.publish();
+}
+
+int Engine::_drainInput(bool begin)
+{
+    if (_replay)
+        return _replay->drain(_input, begin);
+
+    if (!_window) {
+        // Headless, there is no input.
+        if (begin)
+            _input.beginFrame();
+        return 0;
+    }
+
+    return _window->input().drain(_input, _recorder.get(), begin);
+}
+
+void Engine::_startSimulation()
+{
+    _simStop = false;
+    _simStopped = false;
+    _simRequested = 0;
+    _simThread = std::thread(&Engine::_simulationLoop, this);
+}
+
+void Engine::_stopSimulation()
+{
+    if (!_simThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_simMutex);
+        _simStop = true;
+    }
+    _simWake.notify_one();
+
+    // A step in flight may be waiting on jobs pinned to this thread; keep
+    // running them until the simulation is out, or it never gets out.
+    while (!_simStopped.load(std::memory_order_acquire)) {
+        App::jobs()->pumpMainThread();
+        std::this_thread::yield();
+    }
+    _simThread.join();
+}
+
+void Engine::_kickSimulation(double frameTime)
+{
+    {
+        std::lock_guard<std::mutex> lock(_simMutex);
+        _simRequested = _frames;
+        // If the simulation is still busy with an earlier frame the time
+        // adds up, nothing is lost.
+        _simFrameTime += frameTime;
+    }
+    _simWake.notify_one();
+}
+
+void Engine::_simulationLoop()
+{
+    // Scheduler updates create jobs from this thread.
+    App::jobs()->attachThread();
+
+    uint64_t served = 0;
+    while (true) {
+        double frameTime;
+        {
+            std::unique_lock<std::mutex> lock(_simMutex);
+            _simWake.wait(lock, [this, served] { return _simStop || _simRequested > served; });
+            if (_simStop)
+                break;
+
+            served = _simRequested;
+            frameTime = _simFrameTime;
+            _simFrameTime = 0.0;
+        }
+
+        _simulate(served, frameTime);
+    }
+
+    App::jobs()->detachThread();
+    _simStopped.store(true, std::memory_order_release);
+}
+
+void Engine::_measurePipeline(const RenderSnapshot& snapshot, double renderStart, double renderEnd, double presented)
+{
+    int slot = int(_frames % RENDER_HISTORY);
+    _renderHistory[slot] = RenderInterval{ _frames, renderStart, renderEnd };
+
+    if (snapshot.frame == 0)
+        return; // Nothing simulated yet.
+
+    _totalSteps = snapshot.totalSteps;
+    _droppedSteps = snapshot.droppedSteps;
+
+    // How old the simulated state is when it reaches the screen.
+    _latencySum += (presented - snapshot.simEnd) * 1000.0;
+    _latencyCount++;
+
+    if (snapshot.frame == _measuredFrame)
+        return; // Seen already.
+    _measuredFrame = snapshot.frame;
+
+    // The render that ran while this snapshot was being simulated.
+    const RenderInterval& render = _renderHistory[snapshot.frame % RENDER_HISTORY];
+    if (render.frame != snapshot.frame)
+        return;
+
+    double sim = snapshot.simEnd - snapshot.simStart;
+    double rendering = render.end - render.start;
+    double shorter = std::min(sim, rendering);
+    if (shorter <= 0.0)
+        return;
+
+    double overlapped = std::min(snapshot.simEnd, render.end) - std::max(snapshot.simStart, render.start);
+    _overlapSum += std::max(0.0, overlapped) / shorter;
+    _overlapCount++;
+
+    _presentLatency = _latencySum / double(_latencyCount);
+    _overlap = _overlapSum / double(_overlapCount);
+}
+
+void Engine::_reportAllocations(int frames)
+{
+    AllocStats total = AllocTracker::total();
+    uint64_t allocations = total.allocations - _reportedAllocations.allocations;
+    double perFrame = frames > 0 ? 1.0 / frames : 0.0;
+
+    LOG_INFO(LogCategory::ENGINE, "{} allocations ({} bytes) per frame, {} bytes live",
+        allocations * perFrame, (total.bytes - _reportedAllocations.bytes) * perFrame, total.live);
+    if (AllocTracker::violations() > _reportedViolations)
+        LOG_WARN(LogCategory::ENGINE, "{} allocations in steady state frames, the last {} bytes tagged {}",
+            AllocTracker::violations() - _reportedViolations, AllocTracker::violationSize(),
+            AllocTracker::tagName(AllocTracker::violationTag()));
+
+    for (int t = 0; t < int(MemoryTag::COUNT); t++) {
+        AllocStats tag = AllocTracker::tag(MemoryTag(t));
+        AllocStats& reported = _reportedTagAllocations[t];
+        if (tag.allocations != reported.allocations)
+            LOG_INFO(LogCategory::ENGINE, "  {}: {} allocations, {} bytes, {} bytes live",
+                AllocTracker::tagName(MemoryTag(t)), tag.allocations - reported.allocations,
+                tag.bytes - reported.bytes, tag.live);
+        reported = tag;
+    }
+
+    _reportedAllocations = total;
+    _reportedViolations = AllocTracker::violations();
+}
+
+void Engine::_resetPipelineMeasures()
+{
+    if (_latencyCount > 0)
+        _presentLatency = _latencySum / double(_latencyCount);
+    if (_overlapCount > 0)
+        _overlap = _overlapSum / double(_overlapCount);
+
+    _latencySum = 0.0;
+    _latencyCount = 0;
+    _overlapSum = 0.0;
+    _overlapCount = 0;
 }
 }
\ No newline at end of file
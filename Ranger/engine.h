@@ -5,6 +5,22 @@
 #ifndef RANGERALPHA_ENGINE_H
 #define RANGERALPHA_ENGINE_H
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Components/render_snapshot.h"
+#include "Core/Input/input_recording.h"
+#include "Core/Input/input_snapshot.h"
+#include "Core/Memory/alloc_tracker.h"
+#include "Core/Memory/frame_arena.h"
+#include "Core/Timing/clock.h"
+#include "Core/Timing/frame_pacer.h"
+#include "Core/Timing/frame_stats.h"
+#include "Core/triple_buffer.h"
 #include "Extensions/Graphics/camera.h"
 #include "Extensions/Graphics/view.h"
 #include "Extensions/Graphics/viewport.h"
@@ -64,6 +80,87 @@ public:
         return _deltaRenderTime;
     }
 
+    float swapDelta() const
+    {
+        return _deltaSwapTime;
+    }
+
+    //! Present to present time of the last frame, in ms.
+    double frameTime() const
+    {
+        return _frameTime;
+    }
+
+    //! Fixed update steps run during the last frame.
+    int updateSteps() const
+    {
+        return _updateSteps;
+    }
+
+    //! How far, [0.0, 1.0], rendering is between the previous and the
+    // current fixed update step.
+    float interpolationAlpha() const
+    {
+        return static_cast<float>(_alpha);
+    }
+
+    //! This simulation frame's input: what is down and what was pressed or
+    // released since the previous frame. Only read it while updating.
+    const InputSnapshot& input() const
+    {
+        return _input;
+    }
+
+    //! Pause, slow and hyper motion of the simulation.
+    FrameClock& frameClock()
+    {
+        return _frameClock;
+    }
+
+    //! Frame limiting and frame time variance.
+    const FramePacer& framePacer() const
+    {
+        return _framePacer;
+    }
+
+    //! Update, render, swap and frame time percentiles and hitches.
+    const FrameStats& frameStats() const
+    {
+        return _frameStats;
+    }
+
+    //! The fixed update step period in milliseconds.
+    double tickPeriod() const
+    {
+        return _tickPeriod;
+    }
+
+    //! Logic only: no window, GL or rendering.
+    bool isHeadless() const
+    {
+        return _headless;
+    }
+
+    //! Update runs on its own thread, one frame ahead of rendering.
+    bool isPipelined() const
+    {
+        return _pipelined;
+    }
+
+    //! Average ms between a simulation frame finishing and it being
+    // presented, over the last timing interval.
+    double presentLatency() const
+    {
+        return _presentLatency;
+    }
+
+    //! [0.0, 1.0] how much of a simulation frame ran concurrently with
+    // rendering, relative to the shorter of the two. 0 when not pipelined.
+    double overlap() const
+    {
+        return _overlap;
+    }
+
     //---------------------------------------------------------------------
     // Events
     //---------------------------------------------------------------------
@@ -73,6 +170,42 @@ public:
 private:
     void loop();
 
+    bool _constructWindow();
+
+    //! Opens the recording to replay, or to record to, and seeds Math's RNG.
+    void _configureReplay();
+
+    //! Runs the configured number of fixed update steps back to back and
+    // reports logic throughput.
+    void _runHeadless();
+
+    //! Runs the fixed update steps for one frame and publishes a snapshot.
+    void _simulate(uint64_t frame, double frameTime);
+    //! Live, recorded or, headless, no input into _input.
+    int _drainInput(bool begin);
+    void _startSimulation();
+    void _stopSimulation();
+    void _kickSimulation(double frameTime);
+    void _simulationLoop();
+
+    void _measurePipeline(const RenderSnapshot& snapshot, double renderStart, double renderEnd, double presented);
+    void _resetPipelineMeasures();
+
+    //! Allocations per frame and per tag since the last report.
+    void _reportAllocations(int frames);
+
+    //! Closes the recording and writes and compares the frame stats.
+    void _finishRun();
+
+    //! The whole run's frame stats, as JSON, if configured to.
+    void _writeFrameStats();
+
+    //! Logs this run's frame stats against a baseline run's JSON.
+    void _compareFrameStats();
+
+    //! GL call and resource accounting, as JSON, if built in and configured to.
+    void _writeGLStats();
+
 private:
     StageSPtr _stage;
 
@@ -83,6 +216,36 @@ private:
     //---------------------------------------------------------------------
     bool _pauseEnabled{ false };
 
+    FrameClock _frameClock;
+    FramePacer _framePacer;
+    FrameStats _frameStats;
+    //! When the previous frame presented, -1 before the first.
+    double _lastPresented{ -1.0 };
+    double _frameTime{ 0.0 };
+
+    //! Fixed update step period in milliseconds.
+    double _tickPeriod{ FRAME_PERIOD };
+    //! Most steps per frame; beyond that time is dropped instead of
+    // letting the simulation fall further and further behind.
+    int _maxCatchUpSteps{ 5 };
+    //! Frame time not yet consumed by fixed update steps (ms).
+    double _accumulator{ 0.0 };
+    double _alpha{ 0.0 };
+    int _updateSteps{ 0 };
+    //! Since start, as of the snapshot last rendered.
+    int64_t _totalSteps{ 0 };
+    int64_t _droppedSteps{ 0 };
+    //! The above at the last timing report.
+    int64_t _reportedSteps{ 0 };
+    int64_t _reportedDropped{ 0 };
+    //! Owned by whichever thread simulates.
+    int64_t _simSteps{ 0 };
+    int64_t _simDropped{ 0 };
+    ZoneStats _stageZone;
+    ZoneStats _schedulerZone;
+    ZoneStats _captureZone;
+
+    //! Time spent in all of a frame's update steps.
     double _currentUpdateTime;
     double _deltaUpdateTime;
 
@@ -92,6 +255,75 @@ private:
     double _currentSwapTime;
     double _deltaSwapTime;
 
+    //---------------------------------------------------------------------
+    // Input
+    //---------------------------------------------------------------------
+    //! Owned by whichever thread simulates.
+    InputSnapshot _input;
+    //! Whether the last frame stepped, so its input has been seen.
+    bool _inputStepped{ true };
+    std::unique_ptr<InputRecorder> _recorder;
+    std::unique_ptr<InputReplay> _replay;
+    //! Set by the simulation when the replay has run out.
+    std::atomic<bool> _replayFinished{ false };
+    int64_t _simInputEvents{ 0 };
+    double _simInputLatency{ 0.0 };
+    //! As of the snapshot last rendered, and at the last timing report.
+    int64_t _inputEvents{ 0 };
+    double _inputLatencyTotal{ 0.0 };
+    int64_t _reportedInputEvents{ 0 };
+    double _reportedInputLatency{ 0.0 };
+    double _inputLatencyMax{ 0.0 };
+
+    //---------------------------------------------------------------------
+    // Pipelining
+    //---------------------------------------------------------------------
+    bool _pipelined{ false };
+    uint64_t _frames{ 0 };
+
+    //! Simulation writes the back, rendering reads the front; neither
+    // waits for the other.
+    TripleBuffer<RenderSnapshot> _snapshots;
+
+    std::thread _simThread;
+    std::mutex _simMutex;
+    std::condition_variable _simWake;
+    //! Guarded by _simMutex.
+    uint64_t _simRequested{ 0 };
+    double _simFrameTime{ 0.0 };
+    bool _simStop{ false };
+    //! Set by the simulation thread on its way out.
+    std::atomic<bool> _simStopped{ false };
+
+    //! When the last few frames rendered, to measure overlap against.
+    static constexpr int RENDER_HISTORY = 4;
+    struct RenderInterval {
+        uint64_t frame;
+        double start;
+        double end;
+    };
+    RenderInterval _renderHistory[RENDER_HISTORY]{};
+    uint64_t _measuredFrame{ 0 };
+
+    double _latencySum{ 0.0 };
+    int _latencyCount{ 0 };
+    double _overlapSum{ 0.0 };
+    int _overlapCount{ 0 };
+    double _presentLatency{ 0.0 };
+    double _overlap{ 0.0 };
+
+    bool _headless{ false };
+
+    //---------------------------------------------------------------------
+    // Allocations
+    //---------------------------------------------------------------------
+    //! Frames after which allocating is a violation.
+    int _allocWarmup{ 300 };
+    AllocStats _reportedAllocations;
+    AllocStats _reportedTagAllocations[static_cast<int>(MemoryTag::COUNT)];
+    uint64_t _reportedViolations{ 0 };
+    FrameArena::Stats _reportedArena;
+
     //! For debugging only. Set to -1 when not debugging.
     int _loopFor = -1; // -1 = normal non-debug mode.
 
@@ -102,8 +334,6 @@ private:
     Viewport _viewport;
     Camera _camera;
     View _view;
-
-    int _joyAxisCount;
 };
 }
 
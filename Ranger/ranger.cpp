@@ -5,9 +5,13 @@
 #include "engine.h"
 #include "IO/configuration.h"
 #include "Rendering/rendercontext.h"
+#include "Core/Timing/scheduler.h"
+#include "Core/Jobs/job_system.h"
 
 namespace Ranger {
     const EnginePtr App::_engine = std::make_unique<Engine>();
     const ConfigurationPtr App::_config = std::make_unique<Configuration>();
     const RenderContextPtr App::_renderContext = std::make_unique<RenderContext>();
+    const SchedulerPtr App::_scheduler = std::make_unique<Scheduler>();
+    const JobSystemPtr App::_jobs = std::make_unique<JobSystem>();
 }
\ No newline at end of file
@@ -21,6 +21,9 @@ class VectorShape;
 class VectorObject;
 class SceneNode;
 class BaseNode;
+class NodeRegistry;
+class SceneAssets;
+class LayerCache;
 class BasicShapes;
 class UpdateTarget;
 class Shader;
@@ -29,6 +32,7 @@ class UniformAtlas;
 class VectorUniformAtlas;
 class VectorAtlas;
 class Scheduler;
+class JobSystem;
 class Window;
 
 //---------------------------------------------------------------------
@@ -67,6 +71,8 @@ using SchedulerSPtr = std::shared_ptr<Scheduler>;
 
 using EnginePtr = std::unique_ptr<Engine>;
 using ConfigurationPtr = std::unique_ptr<Configuration>;
+using SchedulerPtr = std::unique_ptr<Scheduler>;
+using JobSystemPtr = std::unique_ptr<JobSystem>;
 using RenderContextPtr = std::unique_ptr<RenderContext>;
 using VectorUniformAtlasPtr = std::unique_ptr<VectorUniformAtlas>;
 using WindowPtr = std::unique_ptr<Window>;
@@ -92,6 +98,8 @@ private:
     static const EnginePtr _engine;
     static const ConfigurationPtr _config;
     static const RenderContextPtr _renderContext;
+    static const SchedulerPtr _scheduler;
+    static const JobSystemPtr _jobs;
 
 public:
     static const EnginePtr& engine() { return _engine; }
@@ -99,6 +107,10 @@ public:
     static const ConfigurationPtr& config() { return _config; }
 
     static const RenderContextPtr& renderContext() { return _renderContext; }
+
+    static const SchedulerPtr& scheduler() { return _scheduler; }
+
+    static const JobSystemPtr& jobs() { return _jobs; }
 };
 }
 
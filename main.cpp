@@ -1,5 +1,16 @@
 #include <iostream>
 #include "Ranger/Tests/Test_Engine.h"
+#include "Ranger/Tests/Test_Scheduler.h"
+#include "Ranger/Tests/Test_Jobs.h"
+#include "Ranger/Tests/Test_Behaviors.h"
+#include "Ranger/Tests/Test_Clock.h"
+#include "Ranger/Tests/Test_FramePacer.h"
+#include "Ranger/Tests/Test_Input.h"
+#include "Ranger/Tests/Test_Log.h"
+#include "Ranger/Tests/Test_FrameStats.h"
+#include "Ranger/Tests/Test_Replay.h"
+#include "Ranger/Tests/Test_Allocations.h"
+#include "Ranger/Tests/Test_FrameArena.h"
 
 int main() {
     using namespace std;
@@ -12,6 +23,17 @@ int main() {
     //Test_BasicShape test;
     //Test_GLM test;
     //Test_Extensions test;
+    //Test_Scheduler test;
+    //Test_Jobs test;
+    //Test_Behaviors test;
+    //Test_Clock test;
+    //Test_FramePacer test;
+    //Test_Input test;
+    //Test_Log test;
+    //Test_FrameStats test;
+    //Test_Replay test;
+    //Test_Allocations test;
+    //Test_FrameArena test;
 
 
     Test_Engine test;